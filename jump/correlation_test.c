@@ -0,0 +1,621 @@
+/**
+ * @file correlation_test.c
+ *
+ * @brief inter-stream correlation test of tinymt32 and tinymt64 streams.
+ *
+ * This program generates outputs of many streams at once, and tests
+ * whether streams are independent of each other. Streams are
+ * - generators of parameter sets in a parameter file made by
+ *   tinymt32dc or tinymt64dc, initialized by the same seed, or
+ * - substreams of one parameter set, stream k is the initial state
+ *   jumped k * stride steps.
+ *
+ * Tests are
+ * - correlation of stream i and stream i + d for 1 <= d <= window, all
+ *   pairs if window >= number of streams - 1. Correlation is calculated
+ *   from the upper 16 bits of outputs. Sum of squares of z-scores of
+ *   pairs is tested, and the worst pairs are reported,
+ * - overlapping serial test of the upper 4 bits of interleaved outputs,
+ *   that is, outputs of stream 0, 1, ..., N - 1 at the same step as a
+ *   circular sequence,
+ * - column tests, the number of ones in the most and the least
+ *   significant bit of outputs of all streams at the same step.
+ *
+ * Outputs are generated in chunks, and both generation and correlation
+ * are calculated by threads.
+ *
+ * usage:
+ * correlation_test 32|64 dc paramfile [options]
+ * correlation_test 32|64 jump polynomial mat1 mat2 tmat stride [options]
+ * options: -n streams -l length -w window -t threads -s seed -u upper
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and The University of Tokyo.
+ * All rights reserved.
+ *
+ * The 3-clause BSD License is applied to this software, see
+ * LICENSE.txt
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "tinymt32.h"
+#include "tinymt64.h"
+#include "jump32.h"
+#include "jump64.h"
+
+#define CHUNK 128
+#define SERIAL_BITS 4
+#define SERIAL_BINS (1 << SERIAL_BITS)
+#define WORST 10
+#define SUSPECT 1.0e-4
+#define FAILURE 1.0e-10
+
+/**
+ * streams and accumulated statistics.
+ */
+struct CORR_T {
+    int bits;
+    int num;
+    int window;
+    int length;
+    tinymt32_t * tiny32;
+    tinymt64_t * tiny64;
+    /** mat1 of streams, to show pairs of dc parameters */
+    uint32_t * mat1;
+    /** num * CHUNK outputs, 2 * (upper 16 bits) - 65535 */
+    int32_t * value;
+    /** num * window inner products */
+    int64_t * dot;
+    double column_msb;
+    double column_lsb;
+};
+
+/**
+ * work of a thread, streams first <= i < last.
+ */
+struct THREAD_T {
+    struct CORR_T * corr;
+    int first;
+    int last;
+    int steps;
+    uint32_t msb[CHUNK];
+    uint32_t lsb[CHUNK];
+    uint64_t pair[SERIAL_BINS * SERIAL_BINS];
+    uint64_t single[SERIAL_BINS];
+};
+
+/**
+ * pair of streams and its z-score.
+ */
+struct PAIR_T {
+    int i;
+    int j;
+    double z;
+};
+
+static int failed;
+
+static int read_dc(struct CORR_T * corr, const char * filename,
+		   uint64_t seed);
+static void make_jump(struct CORR_T * corr, const char * poly,
+		      const char * mat1, const char * mat2,
+		      const char * tmat, uint64_t lower, uint64_t upper,
+		      uint64_t seed);
+static void * generate(void * p);
+static void * accumulate(void * p);
+static void run_threads(struct THREAD_T * th, int threads,
+			void * (*func)(void *));
+static int serial_bin(int32_t value);
+static double igam(double a, double x);
+static double igamc(double a, double x);
+static void report(const char * name, const char * stat, double p);
+static void print_results(struct CORR_T * corr, struct THREAD_T * th,
+			  int threads, int dc);
+
+/**
+ * read parameter sets from parameter file of tinymt32dc or tinymt64dc.
+ * @param corr streams, num is the maximum number of streams
+ * @param filename parameter file
+ * @param seed seed of all streams
+ * @return number of streams read
+ */
+static int read_dc(struct CORR_T * corr, const char * filename,
+		   uint64_t seed)
+{
+    FILE * fp = fopen(filename, "r");
+    char line[500];
+    int n = 0;
+
+    if (fp == NULL) {
+	printf("can't open %s\n", filename);
+	return 0;
+    }
+    while (n < corr->num && fgets(line, sizeof(line), fp) != NULL) {
+	char poly[33];
+	int bits;
+	int id;
+	uint32_t mat1;
+	uint32_t mat2;
+	uint64_t tmat;
+	if (line[0] == '#') {
+	    continue;
+	}
+	if (sscanf(line, "%32[0-9a-f],%d,%d,%" SCNx32 ",%" SCNx32 ",%" SCNx64,
+		   poly, &bits, &id, &mat1, &mat2, &tmat) != 6
+	    || bits != corr->bits) {
+	    printf("file format error:%s", line);
+	    n = 0;
+	    break;
+	}
+	corr->mat1[n] = mat1;
+	if (bits == 32) {
+	    corr->tiny32[n].mat1 = mat1;
+	    corr->tiny32[n].mat2 = mat2;
+	    corr->tiny32[n].tmat = (uint32_t)tmat;
+	    tinymt32_init(&corr->tiny32[n], (uint32_t)seed);
+	} else {
+	    corr->tiny64[n].mat1 = mat1;
+	    corr->tiny64[n].mat2 = mat2;
+	    corr->tiny64[n].tmat = tmat;
+	    tinymt64_init(&corr->tiny64[n], seed);
+	}
+	n++;
+    }
+    fclose(fp);
+    return n;
+}
+
+/**
+ * make substreams, stream k is jumped k * stride steps.
+ * @param corr streams
+ * @param poly characteristic polynomial
+ * @param mat1 mat1 in hexadecimal
+ * @param mat2 mat2 in hexadecimal
+ * @param tmat tmat in hexadecimal
+ * @param lower lower 64 bits of stride
+ * @param upper upper 64 bits of stride
+ * @param seed seed of stream 0
+ */
+static void make_jump(struct CORR_T * corr, const char * poly,
+		      const char * mat1, const char * mat2,
+		      const char * tmat, uint64_t lower, uint64_t upper,
+		      uint64_t seed)
+{
+    f2_polynomial jump_poly;
+
+    calculate_jump_polynomial(&jump_poly, lower, upper, poly);
+    if (corr->bits == 32) {
+	tinymt32_t * t = corr->tiny32;
+	t[0].mat1 = (uint32_t)strtoul(mat1, NULL, 16);
+	t[0].mat2 = (uint32_t)strtoul(mat2, NULL, 16);
+	t[0].tmat = (uint32_t)strtoul(tmat, NULL, 16);
+	tinymt32_init(&t[0], (uint32_t)seed);
+	for (int i = 1; i < corr->num; i++) {
+	    t[i] = t[i - 1];
+	    tinymt32_jump_by_polynomial(&t[i], &jump_poly);
+	}
+    } else {
+	tinymt64_t * t = corr->tiny64;
+	t[0].mat1 = (uint32_t)strtoul(mat1, NULL, 16);
+	t[0].mat2 = (uint32_t)strtoul(mat2, NULL, 16);
+	t[0].tmat = strtoull(tmat, NULL, 16);
+	tinymt64_init(&t[0], seed);
+	for (int i = 1; i < corr->num; i++) {
+	    t[i] = t[i - 1];
+	    tinymt64_jump_by_polynomial(&t[i], &jump_poly);
+	}
+    }
+}
+
+/**
+ * thread function, generates steps outputs of streams and counts
+ * bits of columns.
+ * @param p work of thread
+ */
+static void * generate(void * p)
+{
+    struct THREAD_T * th = p;
+    struct CORR_T * corr = th->corr;
+
+    memset(th->msb, 0, sizeof(th->msb));
+    memset(th->lsb, 0, sizeof(th->lsb));
+    for (int i = th->first; i < th->last; i++) {
+	int32_t * v = &corr->value[(size_t)i * CHUNK];
+	for (int t = 0; t < th->steps; t++) {
+	    uint32_t upper;
+	    uint32_t lsb;
+	    if (corr->bits == 32) {
+		upper = tinymt32_generate_uint32(&corr->tiny32[i]);
+		lsb = upper & 1;
+	    } else {
+		uint64_t x = tinymt64_generate_uint64(&corr->tiny64[i]);
+		upper = (uint32_t)(x >> 32);
+		lsb = (uint32_t)(x & 1);
+	    }
+	    v[t] = 2 * (int32_t)(upper >> 16) - 65535;
+	    th->msb[t] += upper >> 31;
+	    th->lsb[t] += lsb;
+	}
+    }
+    return NULL;
+}
+
+/**
+ * upper bits of output for serial test.
+ */
+static int serial_bin(int32_t value)
+{
+    return ((value + 65535) / 2) >> (16 - SERIAL_BITS);
+}
+
+/**
+ * thread function, accumulates inner products of pairs and counts
+ * pairs of interleaved outputs.
+ * @param p work of thread
+ */
+static void * accumulate(void * p)
+{
+    struct THREAD_T * th = p;
+    struct CORR_T * corr = th->corr;
+    const int steps = th->steps;
+
+    for (int i = th->first; i < th->last; i++) {
+	const int32_t * a = &corr->value[(size_t)i * CHUNK];
+	int64_t * dot = &corr->dot[(size_t)i * corr->window];
+	for (int d = 1; d <= corr->window && i + d < corr->num; d++) {
+	    const int32_t * b = &corr->value[(size_t)(i + d) * CHUNK];
+	    int64_t sum = 0;
+	    for (int t = 0; t < steps; t++) {
+		sum += (int64_t)a[t] * b[t];
+	    }
+	    dot[d - 1] += sum;
+	}
+	/* circular sequence of streams at the same step */
+	const int32_t * b = &corr->value[(size_t)((i + 1) % corr->num) * CHUNK];
+	for (int t = 0; t < steps; t++) {
+	    int x = serial_bin(a[t]);
+	    th->single[x]++;
+	    th->pair[x * SERIAL_BINS + serial_bin(b[t])]++;
+	}
+    }
+    return NULL;
+}
+
+/**
+ * run function by threads and wait.
+ * @param th works of threads
+ * @param threads number of threads
+ * @param func thread function
+ */
+static void run_threads(struct THREAD_T * th, int threads,
+			void * (*func)(void *))
+{
+    pthread_t tid[threads];
+
+    for (int i = 0; i < threads; i++) {
+	if (pthread_create(&tid[i], NULL, func, &th[i]) != 0) {
+	    printf("can't create thread\n");
+	    exit(-1);
+	}
+    }
+    for (int i = 0; i < threads; i++) {
+	pthread_join(tid[i], NULL);
+    }
+}
+
+/**
+ * regularized lower incomplete gamma function P(a, x).
+ */
+static double igam(double a, double x)
+{
+    if (x <= 0) {
+	return 0;
+    }
+    if (x >= a + 1) {
+	return 1.0 - igamc(a, x);
+    }
+    double term = 1.0 / a;
+    double sum = term;
+    for (int n = 1; n < 1000000; n++) {
+	term *= x / (a + n);
+	sum += term;
+	if (fabs(term) < fabs(sum) * 1.0e-15) {
+	    break;
+	}
+    }
+    return sum * exp(-x + a * log(x) - lgamma(a));
+}
+
+/**
+ * regularized upper incomplete gamma function Q(a, x), by continued
+ * fraction.
+ */
+static double igamc(double a, double x)
+{
+    if (x < a + 1) {
+	return 1.0 - igam(a, x);
+    }
+    const double tiny = 1.0e-300;
+    double b = x + 1.0 - a;
+    double c = 1.0 / tiny;
+    double d = 1.0 / b;
+    double h = d;
+    for (int i = 1; i < 1000000; i++) {
+	double an = -i * (i - a);
+	b += 2.0;
+	d = an * d + b;
+	if (fabs(d) < tiny) {
+	    d = tiny;
+	}
+	c = b + an / c;
+	if (fabs(c) < tiny) {
+	    c = tiny;
+	}
+	d = 1.0 / d;
+	double delta = d * c;
+	h *= delta;
+	if (fabs(delta - 1.0) < 1.0e-15) {
+	    break;
+	}
+    }
+    return exp(-x + a * log(x) - lgamma(a)) * h;
+}
+
+/**
+ * print result of a test.
+ * @param name test name
+ * @param stat statistic
+ * @param p p-value
+ */
+static void report(const char * name, const char * stat, double p)
+{
+    const char * judge = "pass";
+
+    if (p < FAILURE || p > 1.0 - FAILURE) {
+	judge = "FAIL";
+	failed = 1;
+    } else if (p < SUSPECT || p > 1.0 - SUSPECT) {
+	judge = "suspect";
+    }
+    printf("%-24s %-36s p = %.6g %s\n", name, stat, p, judge);
+}
+
+/**
+ * calculate and print p-values and the worst pairs.
+ * @param corr streams and statistics
+ * @param th works of threads
+ * @param threads number of threads
+ * @param dc true if streams are dc parameter sets
+ */
+static void print_results(struct CORR_T * corr, struct THREAD_T * th,
+			  int threads, int dc)
+{
+    /* E[v^2] of v = 2u - 65535, u uniform in [0, 65535] */
+    const double var = (65536.0 * 65536.0 - 1.0) / 3.0;
+    const double len = corr->length;
+    struct PAIR_T worst[WORST];
+    int num_worst = 0;
+    uint64_t pairs = 0;
+    double sum = 0;
+    char buf[100];
+    double p;
+
+    for (int i = 0; i < corr->num; i++) {
+	for (int d = 1; d <= corr->window && i + d < corr->num; d++) {
+	    double r = (double)corr->dot[(size_t)i * corr->window + d - 1]
+		/ (len * var);
+	    double z = r * sqrt(len);
+	    sum += z * z;
+	    pairs++;
+	    /* worst is sorted, skip if it is full and z is not worse */
+	    if (num_worst == WORST && fabs(z) <= fabs(worst[WORST - 1].z)) {
+		continue;
+	    }
+	    int k = num_worst < WORST ? num_worst++ : WORST - 1;
+	    while (k > 0 && fabs(worst[k - 1].z) < fabs(z)) {
+		worst[k] = worst[k - 1];
+		k--;
+	    }
+	    worst[k].i = i;
+	    worst[k].j = i + d;
+	    worst[k].z = z;
+	}
+    }
+    printf("pairs = %" PRIu64 "\n", pairs);
+    p = igamc((double)pairs / 2.0, sum / 2.0);
+    sprintf(buf, "sum z^2 = %.2f df = %" PRIu64, sum, pairs);
+    report("correlation", buf, p);
+
+    /* overlapping serial test, psi^2 of pairs - psi^2 of singles */
+    uint64_t pair[SERIAL_BINS * SERIAL_BINS];
+    uint64_t single[SERIAL_BINS];
+    memset(pair, 0, sizeof(pair));
+    memset(single, 0, sizeof(single));
+    for (int k = 0; k < threads; k++) {
+	for (int i = 0; i < SERIAL_BINS * SERIAL_BINS; i++) {
+	    pair[i] += th[k].pair[i];
+	}
+	for (int i = 0; i < SERIAL_BINS; i++) {
+	    single[i] += th[k].single[i];
+	}
+    }
+    double total = (double)corr->num * len;
+    double psi2 = 0;
+    double psi1 = 0;
+    for (int i = 0; i < SERIAL_BINS * SERIAL_BINS; i++) {
+	double e = total / (SERIAL_BINS * SERIAL_BINS);
+	psi2 += ((double)pair[i] - e) * ((double)pair[i] - e) / e;
+    }
+    for (int i = 0; i < SERIAL_BINS; i++) {
+	double e = total / SERIAL_BINS;
+	psi1 += ((double)single[i] - e) * ((double)single[i] - e) / e;
+    }
+    int df = SERIAL_BINS * SERIAL_BINS - SERIAL_BINS;
+    p = igamc(df / 2.0, (psi2 - psi1) / 2.0);
+    sprintf(buf, "chi2 = %.2f df = %d", psi2 - psi1, df);
+    report("interleaved serial", buf, p);
+
+    p = igamc(len / 2.0, corr->column_msb / 2.0);
+    sprintf(buf, "chi2 = %.2f df = %d", corr->column_msb, corr->length);
+    report("column(MSB)", buf, p);
+    p = igamc(len / 2.0, corr->column_lsb / 2.0);
+    sprintf(buf, "chi2 = %.2f df = %d", corr->column_lsb, corr->length);
+    report("column(LSB)", buf, p);
+
+    printf("worst pairs:\n");
+    for (int k = 0; k < num_worst; k++) {
+	double z = worst[k].z;
+	double bonferroni = erfc(fabs(z) / sqrt(2.0)) * (double)pairs;
+	if (bonferroni > 1.0) {
+	    bonferroni = 1.0;
+	}
+	if (dc) {
+	    printf("stream %6d (mat1 = %08" PRIx32 ") stream %6d "
+		   "(mat1 = %08" PRIx32 ")",
+		   worst[k].i, corr->mat1[worst[k].i],
+		   worst[k].j, corr->mat1[worst[k].j]);
+	} else {
+	    printf("stream %6d stream %6d", worst[k].i, worst[k].j);
+	}
+	printf(" r = %+.5f z = %+.3f p = %.6g", z / sqrt(len), z, bonferroni);
+	if (bonferroni < FAILURE) {
+	    printf(" FAIL");
+	    failed = 1;
+	}
+	printf("\n");
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    if (argc < 4) {
+	printf("usage:\n"
+	       "%s 32|64 dc paramfile [options]\n"
+	       "%s 32|64 jump polynomial mat1 mat2 tmat stride [options]\n"
+	       "options: -n streams -l length -w window -t threads -s seed"
+	       " -u upper\n", argv[0], argv[0]);
+	return -1;
+    }
+    struct CORR_T corr;
+    int dc = strcmp(argv[2], "dc") == 0;
+    int arg = dc ? 4 : 8;
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    uint64_t seed = 1234;
+    uint64_t upper = 0;
+
+    memset(&corr, 0, sizeof(corr));
+    corr.bits = (int)strtol(argv[1], NULL, 10);
+    corr.num = dc ? 1000000 : 10000;
+    corr.length = 4096;
+    corr.window = 16;
+    if ((corr.bits != 32 && corr.bits != 64)
+	|| (!dc && (strcmp(argv[2], "jump") != 0 || argc < 8))) {
+	printf("argument error\n");
+	return -1;
+    }
+    for (; arg + 1 < argc; arg += 2) {
+	long x = strtol(argv[arg + 1], NULL, 10);
+	if (strcmp(argv[arg], "-n") == 0) {
+	    corr.num = (int)x;
+	} else if (strcmp(argv[arg], "-l") == 0) {
+	    corr.length = (int)x;
+	} else if (strcmp(argv[arg], "-w") == 0) {
+	    corr.window = (int)x;
+	} else if (strcmp(argv[arg], "-t") == 0) {
+	    threads = (int)x;
+	} else if (strcmp(argv[arg], "-s") == 0) {
+	    seed = strtoull(argv[arg + 1], NULL, 10);
+	} else if (strcmp(argv[arg], "-u") == 0) {
+	    upper = strtoull(argv[arg + 1], NULL, 10);
+	} else {
+	    break;
+	}
+    }
+    if (arg != argc || corr.num < 2 || corr.length <= 0
+	|| corr.window <= 0 || threads <= 0) {
+	printf("option error\n");
+	return -1;
+    }
+    corr.tiny32 = calloc((size_t)corr.num, sizeof(tinymt32_t));
+    corr.tiny64 = calloc((size_t)corr.num, sizeof(tinymt64_t));
+    corr.mat1 = calloc((size_t)corr.num, sizeof(uint32_t));
+    if (corr.tiny32 == NULL || corr.tiny64 == NULL || corr.mat1 == NULL) {
+	printf("can't allocate memory\n");
+	return -1;
+    }
+    if (dc) {
+	corr.num = read_dc(&corr, argv[3], seed);
+	if (corr.num < 2) {
+	    printf("too few parameter sets\n");
+	    return -1;
+	}
+    } else {
+	uint64_t lower = strtoull(argv[7], NULL, 10);
+	if (strlen(argv[3]) != 32 || (lower == 0 && upper == 0)) {
+	    printf("argument error\n");
+	    return -1;
+	}
+	make_jump(&corr, argv[3], argv[4], argv[5], argv[6], lower, upper,
+		  seed);
+    }
+    if (corr.window > corr.num - 1) {
+	corr.window = corr.num - 1;
+    }
+    if (threads > corr.num) {
+	threads = corr.num;
+    }
+    corr.value = calloc((size_t)corr.num * CHUNK, sizeof(int32_t));
+    corr.dot = calloc((size_t)corr.num * (size_t)corr.window,
+		      sizeof(int64_t));
+    struct THREAD_T * th = calloc((size_t)threads, sizeof(struct THREAD_T));
+    if (corr.value == NULL || corr.dot == NULL || th == NULL) {
+	printf("can't allocate memory\n");
+	return -1;
+    }
+    printf("tinymt%d %s streams = %d length = %d window = %d threads = %d "
+	   "seed = %" PRIu64 "\n", corr.bits, dc ? "dc" : "jump", corr.num,
+	   corr.length, corr.window, threads, seed);
+    fflush(stdout);
+    for (int k = 0; k < threads; k++) {
+	th[k].corr = &corr;
+	th[k].first = (int)((int64_t)corr.num * k / threads);
+	th[k].last = (int)((int64_t)corr.num * (k + 1) / threads);
+    }
+    for (int done = 0; done < corr.length; done += CHUNK) {
+	int steps = corr.length - done < CHUNK ? corr.length - done : CHUNK;
+	for (int k = 0; k < threads; k++) {
+	    th[k].steps = steps;
+	}
+	run_threads(th, threads, generate);
+	run_threads(th, threads, accumulate);
+	for (int t = 0; t < steps; t++) {
+	    uint32_t msb = 0;
+	    uint32_t lsb = 0;
+	    for (int k = 0; k < threads; k++) {
+		msb += th[k].msb[t];
+		lsb += th[k].lsb[t];
+	    }
+	    double z = (2.0 * msb - corr.num) / sqrt((double)corr.num);
+	    corr.column_msb += z * z;
+	    z = (2.0 * lsb - corr.num) / sqrt((double)corr.num);
+	    corr.column_lsb += z * z;
+	}
+    }
+    print_results(&corr, th, threads, dc);
+    free(corr.tiny32);
+    free(corr.tiny64);
+    free(corr.mat1);
+    free(corr.value);
+    free(corr.dot);
+    free(th);
+    return failed;
+}
@@ -0,0 +1,170 @@
+/*
+ * This program should be compiled with -DTINYMT_DIGEST, together with
+ * tinymt32.c and jump32.c, see Makefile.
+ */
+#include "jump32.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#if !defined(TINYMT_DIGEST)
+#error "compile with -DTINYMT_DIGEST"
+#endif
+
+#define THREADS 4
+#define STREAMS 16
+#define STRIDE 100000
+
+struct THREAD_ARG {
+    const tinymt32_t * base;
+    const char * poly;
+    tinymt_digest * digests;
+    int id;
+};
+
+void * worker(void * p);
+
+void * worker(void * p)
+{
+    struct THREAD_ARG * arg = p;
+    tinymt32_t stream;
+
+    /* substreams are taken in the order different from the index */
+    for (int i = STREAMS - 1 - arg->id; i >= 0; i -= THREADS) {
+	stream = *arg->base;
+	tinymt32_jump(&stream, (uint64_t)i * STRIDE, 0, arg->poly);
+	tinymt32_digest_reset(&stream);
+	for (int j = 0; j < STRIDE; j++) {
+	    tinymt32_generate_uint32(&stream);
+	}
+	tinymt32_digest_get(&stream, &arg->digests[i]);
+    }
+    return NULL;
+}
+
+int main(int argc, char * argv[]) {
+    if (argc < 5) {
+	printf("usage:\n%s polynomial mat1 mat2 tmat\n", argv[0]);
+	return -1;
+    }
+    tinymt32_t tiny;
+    tinymt32_t other;
+    tinymt_digest seq[STREAMS];
+    tinymt_digest par[STREAMS];
+    tinymt_digest rev[STREAMS];
+    tinymt_digest a;
+    tinymt_digest b;
+    pthread_t threads[THREADS];
+    struct THREAD_ARG args[THREADS];
+    char hex[33];
+    int check = 0;
+
+    tiny.mat1 = (uint32_t)strtoul(argv[2], NULL, 16);
+    tiny.mat2 = (uint32_t)strtoul(argv[3], NULL, 16);
+    tiny.tmat = (uint32_t)strtoul(argv[4], NULL, 16);
+    tinymt32_init(&tiny, 1);
+    other = tiny;
+
+    /* digest is of returned values, integers and bits of floats */
+    tinymt_digest_clear(&a);
+    tinymt_digest_clear(&b);
+    for (int i = 0; i < 1000; i++) {
+	tinymt_digest_update(&a, tinymt32_generate_uint32(&tiny));
+	tinymt_digest_update_float(&b, tinymt32_generate_float01(&other));
+    }
+    tinymt32_digest_get(&tiny, &seq[0]);
+    tinymt32_digest_get(&other, &seq[1]);
+    if (!tinymt_digest_equal(&a, &seq[0]) || !tinymt_digest_equal(&b, &seq[1])
+	|| a.count != 1000) {
+	printf("digest differs from returned values\n");
+	check = 1;
+    }
+    if (tinymt_digest_equal(&a, &b)) {
+	printf("digest does not depend on output function\n");
+	check = 1;
+    }
+    tinymt32_init(&tiny, 1);
+    tinymt_digest_clear(&b);
+    for (int i = 0; i < 1000; i++) {
+	tinymt_digest_update_double(&b, tinymt32_generate_double53(&tiny));
+    }
+    tinymt32_digest_get(&tiny, &seq[0]);
+    if (!tinymt_digest_equal(&b, &seq[0])) {
+	printf("digest differs from returned double\n");
+	check = 1;
+    }
+    tinymt32_init(&tiny, 1);
+    tinymt32_init(&other, 1);
+    for (int i = 0; i < 1000; i++) {
+	tinymt32_generate_uint32(&tiny);
+    }
+    tinymt32_digest_get(&tiny, &a);
+    /* digest depends on seed */
+    tinymt32_init(&other, 2);
+    for (int i = 0; i < 1000; i++) {
+	tinymt32_generate_uint32(&other);
+    }
+    tinymt32_digest_get(&other, &b);
+    if (tinymt_digest_equal(&a, &b)) {
+	printf("digest does not depend on seed\n");
+	check = 1;
+    }
+    /* digest depends on tmat, which changes only outputs */
+    other.tmat = tiny.tmat ^ 1;
+    tinymt32_init(&other, 1);
+    for (int i = 0; i < 1000; i++) {
+	tinymt32_generate_uint32(&other);
+    }
+    tinymt32_digest_get(&other, &b);
+    if (tinymt_digest_equal(&a, &b)) {
+	printf("digest does not depend on tmat\n");
+	check = 1;
+    }
+    other.tmat = tiny.tmat;
+
+    /* substreams in sequence */
+    tinymt32_init(&tiny, 1);
+    other = tiny;
+    for (int i = 0; i < STREAMS; i++) {
+	tinymt32_digest_reset(&other);
+	for (int j = 0; j < STRIDE; j++) {
+	    tinymt32_generate_uint32(&other);
+	}
+	tinymt32_digest_get(&other, &seq[i]);
+    }
+    /* substreams by threads */
+    for (int i = 0; i < THREADS; i++) {
+	args[i].base = &tiny;
+	args[i].poly = argv[1];
+	args[i].digests = par;
+	args[i].id = i;
+	pthread_create(&threads[i], NULL, worker, &args[i]);
+    }
+    for (int i = 0; i < THREADS; i++) {
+	pthread_join(threads[i], NULL);
+    }
+    tinymt_digest_merge(&a, seq, STREAMS);
+    tinymt_digest_merge(&b, par, STREAMS);
+    tinymt_digest_to_hex(&b, hex);
+    printf("streams:%d steps:%"PRIu64" digest:%s\n", STREAMS, b.count, hex);
+    if (!tinymt_digest_equal(&a, &b) || b.count != (uint64_t)STREAMS * STRIDE) {
+	printf("merged digest differs\n");
+	check = 1;
+    }
+    /* merged digest depends on order */
+    for (int i = 0; i < STREAMS; i++) {
+	rev[i] = par[STREAMS - 1 - i];
+    }
+    tinymt_digest_merge(&b, rev, STREAMS);
+    if (tinymt_digest_equal(&a, &b)) {
+	printf("merged digest does not depend on order\n");
+	check = 1;
+    }
+    if (check == 0) {
+	printf("OK!\n");
+    } else {
+	printf("NG!\n");
+    }
+    return check;
+}
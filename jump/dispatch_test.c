@@ -0,0 +1,196 @@
+/*
+ * This program compares kernels of all supported instruction set levels
+ * with generic kernels, and jump results of the selected kernels with
+ * jump by polynomial.
+ */
+#include "f2-dispatch.h"
+#include "jump32.h"
+#include "jump64.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#define POLY32 "d8524022ed8dff4a8dcc50c798faba43"
+#define POLY64 "945e0ad4a30ec19432dfa9d5959e5d5d"
+#define ARRAY_SIZE 150
+
+static uint64_t xorshift(uint64_t * x);
+static int test_clmul(const struct F2_KERNELS_T * kernels);
+static int test_matrix(const struct F2_KERNELS_T * kernels);
+static int test_jump_array32(void);
+static int test_jump_array64(void);
+
+
+static uint64_t xorshift(uint64_t * x)
+{
+    *x ^= *x << 13;
+    *x ^= *x >> 7;
+    *x ^= *x << 17;
+    return *x;
+}
+
+/* carry-less multiplication of the level agrees with generic one */
+static int test_clmul(const struct F2_KERNELS_T * kernels)
+{
+    uint64_t seed = 1;
+    uint64_t x[2];
+    uint64_t y[2];
+    uint64_t r[4];
+    uint64_t s[4];
+
+    for (int i = 0; i < 10000; i++) {
+	x[0] = xorshift(&seed);
+	x[1] = xorshift(&seed) >> (i % 64);
+	y[0] = xorshift(&seed);
+	y[1] = xorshift(&seed) >> (i % 61);
+	f2_clmul128_generic(r, x, y);
+	kernels->clmul128(s, x, y);
+	for (int j = 0; j < 4; j++) {
+	    if (r[j] != s[j]) {
+		printf("clmul128 differs %d\n", i);
+		return 1;
+	    }
+	}
+    }
+    return 0;
+}
+
+/* matrix kernel of the level agrees with f2_jump_matrix_apply */
+static int test_matrix(const struct F2_KERNELS_T * kernels)
+{
+    static uint64_t a[ARRAY_SIZE][2];
+    static uint64_t b[ARRAY_SIZE][2];
+    tinymt32_t tiny;
+    f2_polynomial poly;
+    f2_jump_matrix matrix;
+    uint64_t seed = 1;
+
+    tiny.mat1 = 0x8f7011ee;
+    tiny.mat2 = 0xfc78ff1f;
+    tiny.tmat = 0x3793fdff;
+    calculate_jump_polynomial(&poly, 5692, 0, POLY32);
+    tinymt32_calculate_jump_matrix(&matrix, &tiny, &poly);
+    for (int size = 0; size <= ARRAY_SIZE; size += 37) {
+	for (int i = 0; i < size; i++) {
+	    a[i][0] = xorshift(&seed);
+	    a[i][1] = xorshift(&seed);
+	    f2_jump_matrix_apply(b[i], &matrix, a[i]);
+	}
+	kernels->matrix_apply_array(a, size, &matrix);
+	for (int i = 0; i < size; i++) {
+	    if (a[i][0] != b[i][0] || a[i][1] != b[i][1]) {
+		printf("matrix_apply_array differs %d %d\n", size, i);
+		return 1;
+	    }
+	}
+    }
+    return 0;
+}
+
+/* array sizes which are not multiple of vector width and chunk */
+static int test_jump_array32(void)
+{
+    static tinymt32_t a[ARRAY_SIZE];
+    static tinymt32_t b[ARRAY_SIZE];
+    tinymt32_t tiny;
+    f2_polynomial poly;
+    f2_jump_matrix matrix;
+
+    tiny.mat1 = 0x8f7011ee;
+    tiny.mat2 = 0xfc78ff1f;
+    tiny.tmat = 0x3793fdff;
+    calculate_jump_polynomial(&poly, 5692, 0, POLY32);
+    tinymt32_calculate_jump_matrix(&matrix, &tiny, &poly);
+    for (int size = 0; size <= ARRAY_SIZE; size += 37) {
+	for (int i = 0; i < size; i++) {
+	    a[i] = tiny;
+	    tinymt32_init(&a[i], (uint32_t)i + 1);
+	    b[i] = a[i];
+	    tinymt32_jump_by_polynomial(&a[i], &poly);
+	}
+	tinymt32_jump_array_by_matrix(b, size, &matrix);
+	for (int i = 0; i < size; i++) {
+	    for (int j = 0; j < 4; j++) {
+		if (a[i].status[j] != b[i].status[j]) {
+		    printf("tinymt32 jump array differs %d %d\n", size, i);
+		    return 1;
+		}
+	    }
+	}
+    }
+    return 0;
+}
+
+static int test_jump_array64(void)
+{
+    static tinymt64_t a[ARRAY_SIZE];
+    static tinymt64_t b[ARRAY_SIZE];
+    tinymt64_t tiny;
+    f2_polynomial poly;
+    f2_jump_matrix matrix;
+
+    tiny.mat1 = 0xfa051f40;
+    tiny.mat2 = 0xffd0fff4;
+    tiny.tmat = UINT64_C(0x58d02ffeffbfffbc);
+    calculate_jump_polynomial(&poly, 5692, 0, POLY64);
+    tinymt64_calculate_jump_matrix(&matrix, &tiny, &poly);
+    for (int size = 0; size <= ARRAY_SIZE; size += 37) {
+	for (int i = 0; i < size; i++) {
+	    a[i] = tiny;
+	    tinymt64_init(&a[i], (uint64_t)i + 1);
+	    b[i] = a[i];
+	    tinymt64_jump_by_polynomial(&a[i], &poly);
+	}
+	tinymt64_jump_array_by_matrix(b, size, &matrix);
+	for (int i = 0; i < size; i++) {
+	    for (int j = 0; j < 2; j++) {
+		if (a[i].status[j] != b[i].status[j]) {
+		    printf("tinymt64 jump array differs %d %d\n", size, i);
+		    return 1;
+		}
+	    }
+	}
+    }
+    return 0;
+}
+
+int main(void) {
+    f2_isa active = f2_dispatch_active();
+    int check = 0;
+
+    printf("selected: %s\n", f2_dispatch_name(active));
+    for (int i = F2_ISA_NUM - 1; i >= 0; i--) {
+	if (f2_dispatch_supported((f2_isa)i)) {
+	    if ((f2_isa)i != active) {
+		printf("%s: not selected\n", f2_dispatch_name((f2_isa)i));
+		check = 1;
+	    }
+	    break;
+	}
+    }
+    for (int i = 0; i < F2_ISA_NUM; i++) {
+	f2_isa isa = (f2_isa)i;
+	const struct F2_KERNELS_T * kernels = f2_dispatch_kernels_of(isa);
+	if (kernels == NULL) {
+	    printf("%s: not supported\n", f2_dispatch_name(isa));
+	    continue;
+	}
+	if (kernels->isa != isa) {
+	    printf("%s: wrong kernels\n", f2_dispatch_name(isa));
+	    check = 1;
+	    continue;
+	}
+	int r = test_clmul(kernels);
+	r |= test_matrix(kernels);
+	printf("%s: %s\n", f2_dispatch_name(isa), r == 0 ? "OK" : "NG");
+	check |= r;
+    }
+    check |= test_jump_array32();
+    check |= test_jump_array64();
+    if (check == 0) {
+	printf("OK!\n");
+    } else {
+	printf("NG!\n");
+    }
+    return check;
+}
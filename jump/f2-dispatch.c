@@ -0,0 +1,217 @@
+/**
+ * @file f2-dispatch.c
+ *
+ * @brief kernels of jump functions for several instruction set levels,
+ * and selection of them.
+ *
+ * Kernels for x86-64 are compiled by target attributes of GCC and
+ * clang, so that this file is compiled without -m options, and the
+ * program runs on any x86-64 CPU. This file needs GCC or clang.
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and University of Tokyo.
+ * All rights reserved.
+ *
+ * The 3-clause BSD License is applied to this software, see
+ * LICENSE.txt
+ */
+#include "f2-dispatch.h"
+#include <stddef.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define F2_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define F2_NEON 1
+#include <arm_neon.h>
+#endif
+
+static const char * isa_names[F2_ISA_NUM] = {
+    "generic", "pclmul", "neon"
+};
+
+/*
+ * kernels for x86-64
+ */
+#if defined(F2_X86)
+__attribute__((target("sse2,pclmul")))
+static void clmul128_pclmul(uint64_t dest[4], const uint64_t x[2],
+			    const uint64_t y[2])
+{
+    __m128i a = _mm_loadu_si128((const __m128i *)x);
+    __m128i b = _mm_loadu_si128((const __m128i *)y);
+    __m128i lo = _mm_clmulepi64_si128(a, b, 0x00);
+    __m128i hi = _mm_clmulepi64_si128(a, b, 0x11);
+    __m128i mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x01),
+				_mm_clmulepi64_si128(a, b, 0x10));
+    lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+    _mm_storeu_si128((__m128i *)dest, lo);
+    _mm_storeu_si128((__m128i *)(dest + 2), hi);
+}
+
+/*
+ * matrix kernels by gather or insert of 128-bit lanes were slower
+ * than generic one, which is limited by table lookups.
+ */
+static const struct F2_KERNELS_T pclmul_kernels = {
+    F2_ISA_PCLMUL,
+    clmul128_pclmul,
+    f2_matrix_apply_array_generic
+};
+
+/**
+ * check CPU support of PCLMULQDQ by cpuid. PCLMULQDQ uses only XMM
+ * registers, whose state is saved by any x86-64 OS.
+ */
+static int detect_pclmul(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+	return 0;
+    }
+    return (ecx >> 1) & 1;
+}
+#endif
+
+/*
+ * kernels for aarch64
+ */
+#if defined(F2_NEON)
+/**
+ * two states at a time, to hide latency of loads.
+ */
+static void matrix_apply_array_neon(uint64_t state[][2], int size,
+				    const f2_jump_matrix * matrix)
+{
+    int i = 0;
+
+    for (; i + 2 <= size; i += 2) {
+	uint64x2_t r0 = vdupq_n_u64(0);
+	uint64x2_t r1 = vdupq_n_u64(0);
+	for (int w = 0; w < 2; w++) {
+	    uint64_t s0 = state[i][w];
+	    uint64_t s1 = state[i + 1][w];
+	    for (int n = 0; n < 16; n++) {
+		r0 = veorq_u64(r0,
+			       vld1q_u64(matrix->table[16 * w + n][s0 & 0xf]));
+		r1 = veorq_u64(r1,
+			       vld1q_u64(matrix->table[16 * w + n][s1 & 0xf]));
+		s0 = s0 >> 4;
+		s1 = s1 >> 4;
+	    }
+	}
+	vst1q_u64(state[i], r0);
+	vst1q_u64(state[i + 1], r1);
+    }
+    f2_matrix_apply_array_generic(state + i, size - i, matrix);
+}
+
+static const struct F2_KERNELS_T neon_kernels = {
+    F2_ISA_NEON,
+    f2_clmul128_generic,
+    matrix_apply_array_neon
+};
+#endif
+
+/**
+ * name of instruction set level.
+ * @param isa instruction set level
+ * @return name, or "unknown"
+ */
+const char * f2_dispatch_name(f2_isa isa)
+{
+    if ((int)isa < 0 || isa >= F2_ISA_NUM) {
+	return "unknown";
+    }
+    return isa_names[isa];
+}
+
+/**
+ * check if the level is supported by the CPU and the OS.
+ * @param isa instruction set level
+ * @return 1 if supported, else 0
+ */
+int f2_dispatch_supported(f2_isa isa)
+{
+    switch (isa) {
+    case F2_ISA_GENERIC:
+	return 1;
+#if defined(F2_X86)
+    case F2_ISA_PCLMUL:
+	return detect_pclmul();
+#endif
+#if defined(F2_NEON)
+    case F2_ISA_NEON:
+	return 1;
+#endif
+    default:
+	return 0;
+    }
+}
+
+/**
+ * kernels of the level.
+ * @param isa instruction set level
+ * @return kernels, or NULL if the level is not supported
+ */
+const struct F2_KERNELS_T * f2_dispatch_kernels_of(f2_isa isa)
+{
+    if (!f2_dispatch_supported(isa)) {
+	return NULL;
+    }
+    switch (isa) {
+#if defined(F2_X86)
+    case F2_ISA_PCLMUL:
+	return &pclmul_kernels;
+#endif
+#if defined(F2_NEON)
+    case F2_ISA_NEON:
+	return &neon_kernels;
+#endif
+    default:
+	return f2_generic_kernels();
+    }
+}
+
+/**
+ * kernels of the highest supported level. The level is detected at the
+ * first call, and the same kernels are returned after that. Threads
+ * calling this function at the same time detect the same level.
+ * @return kernels
+ */
+const struct F2_KERNELS_T * f2_dispatch_kernels(void)
+{
+    static const struct F2_KERNELS_T * selected = NULL;
+    const struct F2_KERNELS_T * k;
+
+    k = __atomic_load_n(&selected, __ATOMIC_ACQUIRE);
+    if (k != NULL) {
+	return k;
+    }
+    k = f2_generic_kernels();
+    for (int i = F2_ISA_NUM - 1; i > 0; i--) {
+	const struct F2_KERNELS_T * p = f2_dispatch_kernels_of((f2_isa)i);
+	if (p != NULL) {
+	    k = p;
+	    break;
+	}
+    }
+    __atomic_store_n(&selected, k, __ATOMIC_RELEASE);
+    return k;
+}
+
+/**
+ * the selected level.
+ * @return instruction set level
+ */
+f2_isa f2_dispatch_active(void)
+{
+    return f2_kernels()->isa;
+}
@@ -0,0 +1,95 @@
+#ifndef F2_DISPATCH_H
+#define F2_DISPATCH_H
+/**
+ * @file f2-dispatch.h
+ *
+ * @brief selection of instruction set for kernels of jump functions.
+ *
+ * Kernels of jump functions, carry-less multiplication of polynomials
+ * and multiplication of jump matrix and many state vectors, are built
+ * for several instruction set levels in one library, and the highest
+ * level supported by the CPU is selected by cpuid at the first use.
+ * The levels are
+ * - generic: C, any CPU. Generic kernels are in f2-polynomial.c, and
+ *   are used when f2-dispatch.o is not linked.
+ * - pclmul: carry-less multiplication by PCLMULQDQ of x86-64.
+ * - neon: matrix kernel by NEON of aarch64.
+ *
+ * On x86-64, the matrix kernel is generic, because kernels using AVX2
+ * and AVX-512 registers were slower than the generic one, which is
+ * bound by table lookups.
+ * Generators and fill functions of tinymt32.h and tinymt64.h are not
+ * dispatched.
+ *
+ * Kernel tables are constant. f2_dispatch_kernels_of() gives the
+ * kernels of any supported level, and all levels give the same results.
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and University of Tokyo.
+ * All rights reserved.
+ *
+ * The 3-clause BSD License is applied to this software, see
+ * LICENSE.txt
+ */
+
+#include "f2-polynomial.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * number of states which jump array functions give to
+ * matrix_apply_array kernel at a time.
+ */
+#define F2_DISPATCH_CHUNK 64
+
+/**
+ * instruction set level
+ */
+enum F2_ISA_T {
+    F2_ISA_GENERIC = 0,
+    F2_ISA_PCLMUL,
+    F2_ISA_NEON,
+    F2_ISA_NUM
+};
+
+typedef enum F2_ISA_T f2_isa;
+
+/**
+ * kernels of the selected level.
+ * Users should not call them directly.
+ */
+struct F2_KERNELS_T {
+    f2_isa isa;
+    /** dest = x * y, x and y are polynomials of degree less than 128 */
+    void (*clmul128)(uint64_t dest[4], const uint64_t x[2],
+		     const uint64_t y[2]);
+    /** state[i] = matrix * state[i] for 0 <= i < size */
+    void (*matrix_apply_array)(uint64_t state[][2], int size,
+			       const f2_jump_matrix * matrix);
+};
+
+/* f2-polynomial.c */
+void f2_clmul128_generic(uint64_t dest[4], const uint64_t x[2],
+			 const uint64_t y[2]);
+void f2_matrix_apply_array_generic(uint64_t state[][2], int size,
+				   const f2_jump_matrix * matrix);
+const struct F2_KERNELS_T * f2_generic_kernels(void);
+const struct F2_KERNELS_T * f2_kernels(void);
+
+/* f2-dispatch.c */
+const struct F2_KERNELS_T * f2_dispatch_kernels(void);
+const struct F2_KERNELS_T * f2_dispatch_kernels_of(f2_isa isa);
+f2_isa f2_dispatch_active(void);
+const char * f2_dispatch_name(f2_isa isa);
+int f2_dispatch_supported(f2_isa isa);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -20,6 +20,7 @@
  * LICENSE.txt
  */
 #include "f2-polynomial.h"
+#include "f2-dispatch.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <inttypes.h>
@@ -37,6 +38,20 @@ struct POLYNOMIAL256_T {
 typedef struct POLYNOMIAL256_T lpol;
 typedef f2_polynomial pol;
 
+/**
+ * precomputed values for Barrett reduction by divisor of degree n.
+ */
+struct BARRETT_T {
+    int n;
+    pol mu;			/* quotient of <b>t</b><sup>2n</sup> / mod */
+    pol mod;
+    /* carry-less multiplication kernel */
+    void (*clmul128)(uint64_t dest[4], const uint64_t x[2],
+		     const uint64_t y[2]);
+};
+
+typedef struct BARRETT_T barrett;
+
 inline static void shiftup_lpol1(lpol *dest);
 inline static void shiftup_lpol_n0(lpol *dest, int n);
 inline static void shiftup_lpol_n1(lpol *dest, int n);
@@ -123,11 +138,13 @@ inline static void shiftdown_lpol1(lpol *dest) {
  * @param n number of shift up
  */
 inline static void shiftup_lpoln(lpol * dest, int n) {
-    if (n <= 64) {
+    if (n == 0) {
+	return;
+    } else if (n < 64) {
 	shiftup_lpol_n0(dest, n);
-    } else if (n <= 128) {
+    } else if (n < 128) {
 	shiftup_lpol_n1(dest, n);
-    } else if (n <= 192) {
+    } else if (n < 192) {
 	shiftup_lpol_n2(dest, n);
     } else {
 	shiftup_lpol_n3(dest, n);
@@ -135,7 +152,7 @@ inline static void shiftup_lpoln(lpol * dest, int n) {
 }
 
 /**
- * subcontract function: n < =64
+ * subcontract function: 0 < n < 64
  * shift up n bit, ifindeterminate of dest is <b>t</b>
  * dest = dest * <b>t</b><sup>n</sup>
  * @param dest 256-bit polynomial
@@ -152,7 +169,7 @@ inline static void shiftup_lpol_n0(lpol *dest, int n) {
 }
 
 /**
- * subcontract function: 64 < n <= 128
+ * subcontract function: 64 <= n < 128
  * shift up n bit, ifindeterminate of dest is <b>t</b>
  * dest = dest * <b>t</b><sup>n</sup>
  * @param dest 256-bit polynomial
@@ -160,8 +177,9 @@ inline static void shiftup_lpol_n0(lpol *dest, int n) {
  */
 inline static void shiftup_lpol_n1(lpol *dest, int n) {
     n -= 64;
-    uint64_t msb0 = dest->ar[0] >> (64 - n);
-    uint64_t msb1 = dest->ar[1] >> (64 - n);
+    /* shift by 64 is undefined */
+    uint64_t msb0 = (n == 0) ? 0 : dest->ar[0] >> (64 - n);
+    uint64_t msb1 = (n == 0) ? 0 : dest->ar[1] >> (64 - n);
     dest->ar[3] = (dest->ar[2] << n) | msb1;
     dest->ar[2] = (dest->ar[1] << n) | msb0;
     dest->ar[1] = (dest->ar[0] << n);
@@ -169,7 +187,7 @@ inline static void shiftup_lpol_n1(lpol *dest, int n) {
 }
 
 /**
- * subcontract function: 128 < n <= 192
+ * subcontract function: 128 <= n < 192
  * shift up n bit, ifindeterminate of dest is <b>t</b>
  * dest = dest * <b>t</b><sup>n</sup>
  * @param dest 256-bit polynomial
@@ -177,7 +195,7 @@ inline static void shiftup_lpol_n1(lpol *dest, int n) {
  */
 inline static void shiftup_lpol_n2(lpol *dest, int n) {
     n -= 128;
-    uint64_t msb0 = dest->ar[0] >> (64 - n);
+    uint64_t msb0 = (n == 0) ? 0 : dest->ar[0] >> (64 - n);
     dest->ar[3] = (dest->ar[1] << n) | msb0;
     dest->ar[2] = (dest->ar[0] << n);
     dest->ar[1] = 0;
@@ -185,7 +203,7 @@ inline static void shiftup_lpol_n2(lpol *dest, int n) {
 }
 
 /**
- * subcontract function: 192 < n <= 256
+ * subcontract function: 192 <= n < 256
  * shift up n bit, ifindeterminate of dest is <b>t</b>
  * dest = dest * <b>t</b><sup>n</sup>
  * @param dest 256-bit polynomial
@@ -248,47 +266,181 @@ static void print_lpol(char * title, lpol *x)
 #endif
 
 /**
- * multiplication of polynomials
- * y's degree is assumed to be lower than 128 <br>
- * x = x * y
+ * shift down k bits and take lower 128 bits.
+ * dest = x / <b>t</b><sup>k</sup>
+ * @param dest 128-bit polynomial
+ * @param x 256-bit polynomial
+ * @param k number of shift down, 0 <= k < 256
+ */
+inline static void shiftdown_topol(pol * dest, const uint64_t x[4], int k) {
+    int w = k / 64;
+    int b = k % 64;
+    for (int i = 0; i < 2; i++) {
+	uint64_t lo = (w + i < 4) ? x[w + i] : 0;
+	uint64_t hi = (w + i + 1 < 4) ? x[w + i + 1] : 0;
+	dest->ar[i] = (b == 0) ? lo : (lo >> b) | (hi << (64 - b));
+    }
+}
+
+/**
+ * carry-less multiplication of 64-bit words, 4 bits at a time.
+ * @param dest dest[0] is lower and dest[1] is upper word of x * y
  * @param x polynomial
  * @param y polynomial
  */
-static void mul_pol(lpol *x, const lpol *y) {
-    lpol result_z;
-    lpol *result = &result_z;
-    clear_lpol(result);
-    uint64_t y64 = y->ar[0];
-    for (int i = 0; i < 64; i++) {
-	if ((y64 & 1) != 0) {
-	    add_lpol(result, x);
-	}
-	shiftup_lpol1(x);
-	y64 = y64 >> 1;
-	if ((y64 == 0) && (y->ar[1] == 0)) {
-	    break;
-	}
+static void clmul64_generic(uint64_t dest[2], uint64_t x, uint64_t y)
+{
+    uint64_t lo[16];
+    uint64_t hi[16];
+    uint64_t r0 = 0;
+    uint64_t r1 = 0;
+
+    lo[0] = 0;
+    hi[0] = 0;
+    lo[1] = x;
+    hi[1] = 0;
+    for (int v = 2; v < 16; v += 2) {
+	lo[v] = lo[v / 2] << 1;
+	hi[v] = (hi[v / 2] << 1) | (lo[v / 2] >> 63);
+	lo[v + 1] = lo[v] ^ x;
+	hi[v + 1] = hi[v];
+    }
+    for (int i = 60; i >= 0; i -= 4) {
+	int v = (int)((y >> i) & 0xf);
+	r1 = (r1 << 4) | (r0 >> 60);
+	r0 = r0 << 4;
+	r0 ^= lo[v];
+	r1 ^= hi[v];
+    }
+    dest[0] = r0;
+    dest[1] = r1;
+}
+
+/**
+ * generic kernel, dest = x * y.
+ * @param dest product of degree less than 256
+ * @param x polynomial of degree less than 128
+ * @param y polynomial of degree less than 128
+ */
+void f2_clmul128_generic(uint64_t dest[4], const uint64_t x[2],
+			 const uint64_t y[2])
+{
+    uint64_t t[2];
+
+    clmul64_generic(dest, x[0], y[0]);
+    clmul64_generic(dest + 2, x[1], y[1]);
+    clmul64_generic(t, x[0], y[1]);
+    dest[1] ^= t[0];
+    dest[2] ^= t[1];
+    clmul64_generic(t, x[1], y[0]);
+    dest[1] ^= t[0];
+    dest[2] ^= t[1];
+}
+
+/**
+ * generic kernel, state[i] = matrix * state[i] for 0 <= i < size.
+ * @param state array of states
+ * @param size number of states
+ * @param matrix jump matrix
+ */
+void f2_matrix_apply_array_generic(uint64_t state[][2], int size,
+				   const f2_jump_matrix * matrix)
+{
+    for (int i = 0; i < size; i++) {
+	f2_jump_matrix_apply(state[i], matrix, state[i]);
+    }
+}
+
+static const struct F2_KERNELS_T generic_kernels = {
+    F2_ISA_GENERIC,
+    f2_clmul128_generic,
+    f2_matrix_apply_array_generic
+};
+
+/**
+ * generic kernels.
+ * @return kernels of level F2_ISA_GENERIC
+ */
+const struct F2_KERNELS_T * f2_generic_kernels(void)
+{
+    return &generic_kernels;
+}
+
+#if defined(__GNUC__)
+/* defined in f2-dispatch.c, NULL if f2-dispatch.o is not linked */
+extern const struct F2_KERNELS_T * f2_dispatch_kernels(void)
+    __attribute__((weak));
+#endif
+
+/**
+ * kernels used by jump functions, selected by f2-dispatch.c if it is
+ * linked, else generic kernels.
+ * @return kernels
+ */
+const struct F2_KERNELS_T * f2_kernels(void)
+{
+#if defined(__GNUC__)
+    if (f2_dispatch_kernels != NULL) {
+	return f2_dispatch_kernels();
     }
-    y64 = y->ar[1];
-    while (y64 != 0) {
-	if ((y64 & 1) != 0) {
-	    add_lpol(result, x);
+#endif
+    return &generic_kernels;
+}
+
+/**
+ * prepare Barrett reduction.
+ * @param bar precomputed values
+ * @param mod divisor, its degree must be 1 or more
+ */
+static void barrett_init(barrett * bar, const lpol * mod) {
+    lpol rem;
+    lpol tmp;
+    int n = deg_lpol(mod);
+
+    bar->n = n;
+    bar->clmul128 = f2_kernels()->clmul128;
+    bar->mod.ar[0] = mod->ar[0];
+    bar->mod.ar[1] = mod->ar[1];
+    bar->mu.ar[0] = 0;
+    bar->mu.ar[1] = 0;
+    clear_lpol(&rem);
+    rem.ar[(2 * n) / 64] = UINT64_C(1) << ((2 * n) % 64);
+    for (int k = n; k >= 0; k--) {
+	if (((rem.ar[(n + k) / 64] >> ((n + k) % 64)) & 1) != 0) {
+	    bar->mu.ar[k / 64] |= UINT64_C(1) << (k % 64);
+	    tmp = *mod;
+	    if (k > 0) {
+		shiftup_lpoln(&tmp, k);
+	    }
+	    add_lpol(&rem, &tmp);
 	}
-	shiftup_lpol1(x);
-	y64 = y64 >> 1;
     }
-    *x = *result;
 }
 
 /**
- * square polynomial <br>
- * x = x * x
+ * multiplication and remainder of polynomials by Barrett reduction,
+ * x's and y's degrees are assumed to be lower than degree of divisor<br>
+ * x = x * y % mod
+ * The carry-less multiplication kernel is taken by barrett_init.
  * @param x polynomial
+ * @param y polynomial
+ * @param bar precomputed values for divisor
  */
-static void square_lpol(lpol *x) {
-    lpol tmp;
-    tmp = *x;
-    mul_pol(x, &tmp);
+static void mul_mod_pol(lpol *x, const lpol *y, const barrett * bar) {
+    uint64_t r[4];
+    uint64_t t[4];
+    pol q;
+
+    bar->clmul128(r, x->ar, y->ar);
+    /* quotient is exact for polynomials of degree less than 2n */
+    shiftdown_topol(&q, r, bar->n);
+    bar->clmul128(t, q.ar, bar->mu.ar);
+    shiftdown_topol(&q, t, bar->n);
+    bar->clmul128(t, q.ar, bar->mod.ar);
+    x->ar[0] = r[0] ^ t[0];
+    x->ar[1] = r[1] ^ t[1];
+    x->ar[2] = 0;
+    x->ar[3] = 0;
 }
 
 /**
@@ -375,11 +527,13 @@ void polynomialtostr(char * str, const f2_polynomial * poly)
 
 /**
  * dest = x<sup>power</sup> % mod
+ * Multiplications are reduced by Barrett reduction, using carry-less
+ * multiplication kernel selected by f2-dispatch.c.
  * @param dest the result of calculation
  * @param x polynomial
  * @param lower_power lower 128 bit of power
  * @param upper_power upper 128 bit of power
- * @param mod divisor polynomial
+ * @param mod divisor polynomial, its degree must be 1 or more
  */
 void polynomial_power_mod(f2_polynomial * dest,
 			  const f2_polynomial * x,
@@ -393,17 +547,18 @@ void polynomial_power_mod(f2_polynomial * dest,
     lpol * result = & result_z;
     lpol lmod_z;
     lpol * lmod = &lmod_z;
+    barrett bar;
     tolpol(tmp, x);
     tolpol(lmod, mod);
+    barrett_init(&bar, lmod);
+    mod_lpol(tmp, lmod);
     clear_lpol(result);
     result_z.ar[0] = 1;
     for (int i = 0; i < 64; i++) {
 	if ((lower_power & 1) != 0) {
-	    mul_pol(result, tmp);
-	    mod_lpol(result, lmod);
+	    mul_mod_pol(result, tmp, &bar);
 	}
-	square_lpol(tmp);
-	mod_lpol(tmp, lmod);
+	mul_mod_pol(tmp, tmp, &bar);
 	lower_power = lower_power >> 1;
 	if ((lower_power == 0) && (upper_power == 0)) {
 	    break;
@@ -411,11 +566,9 @@ void polynomial_power_mod(f2_polynomial * dest,
     }
     while (upper_power != 0) {
 	if ((upper_power & 1) != 0) {
-	    mul_pol(result, tmp);
-	    mod_lpol(result, lmod);
+	    mul_mod_pol(result, tmp, &bar);
 	}
-	square_lpol(tmp);
-	mod_lpol(tmp, lmod);
+	mul_mod_pol(tmp, tmp, &bar);
 	upper_power = upper_power >> 1;
     }
     topol(dest, result);
@@ -453,3 +606,224 @@ void calculate_jump_polynomial(f2_polynomial *jump_poly,
 			 upper_step,
 			 &charcteristic);
 }
+
+/**
+ * calculate jump table.
+ * The jump table contains the jump polynomials for 2<sup>i</sup> steps
+ * (0 <= i < 64), and is used in tinymt32_jump_by_table,
+ * tinymt64_jump_by_table, tinymt32_at and tinymt64_at.
+ * This function is time consuming, but should be called only once for
+ * a characteristic polynomial.
+ * @param table the result of this calculation.
+ * @param poly_str string of the characteristic polynomial generated by
+ * tinymt32dc or tinymt64dc
+ */
+void calculate_jump_table(f2_jump_table * table, const char * poly_str)
+{
+    f2_polynomial charcteristic;
+
+    strtopolynomial(&charcteristic, poly_str);
+    table->characteristic = charcteristic;
+    table->poly[0].ar[0] = 2;
+    table->poly[0].ar[1] = 0;
+    for (int i = 1; i < 64; i++) {
+	polynomial_power_mod(&table->poly[i],
+			     &table->poly[i - 1],
+			     2,
+			     0,
+			     &charcteristic);
+    }
+    table->base_step = 1;
+}
+
+/**
+ * number of steps jumped by the jump table.
+ * @param table jump table
+ * @param step step given to jump by table
+ * @return step * table->base_step, UINT64_MAX if it overflows
+ */
+uint64_t f2_jump_table_steps(const f2_jump_table * table, uint64_t step)
+{
+    if (table->base_step != 0 && step > UINT64_MAX / table->base_step) {
+	return UINT64_MAX;
+    }
+    return step * table->base_step;
+}
+
+/**
+ * jump polynomial for step * table->base_step steps.
+ * This is the product of table->poly[i] for every bit i set in step,
+ * reduced by the characteristic polynomial, so it needs at most 64
+ * multiplications instead of jumps of the state.
+ * @param jump_poly the result of this calculation.
+ * @param table jump table
+ * @param step step given to jump by table
+ */
+void f2_jump_table_polynomial(f2_polynomial * jump_poly,
+			      const f2_jump_table * table,
+			      uint64_t step)
+{
+    lpol result;
+    lpol tmp;
+    lpol lmod;
+    barrett bar;
+
+    tolpol(&lmod, &table->characteristic);
+    barrett_init(&bar, &lmod);
+    clear_lpol(&result);
+    result.ar[0] = 1;
+    for (int i = 0; step != 0; i++) {
+	if ((step & 1) != 0) {
+	    tolpol(&tmp, &table->poly[i]);
+	    mul_mod_pol(&result, &tmp, &bar);
+	}
+	step = step >> 1;
+    }
+    topol(jump_poly, &result);
+}
+
+/**
+ * make jump matrix from its columns.
+ * steps of the matrix is set to UINT64_MAX, unknown.
+ * @param matrix jump matrix
+ * @param column column[j] is the image of j-th unit vector.
+ */
+void f2_jump_matrix_set_columns(f2_jump_matrix * matrix,
+				uint64_t column[128][2])
+{
+    for (int n = 0; n < 32; n++) {
+	for (int v = 0; v < 16; v++) {
+	    matrix->table[n][v][0] = 0;
+	    matrix->table[n][v][1] = 0;
+	    for (int b = 0; b < 4; b++) {
+		if (((v >> b) & 1) != 0) {
+		    matrix->table[n][v][0] ^= column[4 * n + b][0];
+		    matrix->table[n][v][1] ^= column[4 * n + b][1];
+		}
+	    }
+	}
+    }
+    matrix->steps = UINT64_MAX;
+}
+
+/**
+ * header of saved jump matrix, followed by version number.
+ */
+static const char jump_matrix_magic[8] = {
+    'T', 'M', 'T', 'J', 'M', 'A', 'T', 'X'
+};
+static const uint32_t jump_matrix_version = 2;
+
+/**
+ * size of header of saved jump matrix, magic, version and key.
+ */
+#define JUMP_MATRIX_HEADER_SIZE 56
+
+static void put_le(unsigned char * p, uint64_t x, int size);
+static void put_key(unsigned char header[JUMP_MATRIX_HEADER_SIZE],
+		    const f2_jump_matrix_key * key);
+
+/**
+ * write integer in little endian.
+ * @param p output
+ * @param x integer
+ * @param size number of bytes
+ */
+static void put_le(unsigned char * p, uint64_t x, int size)
+{
+    for (int i = 0; i < size; i++) {
+	p[i] = (unsigned char)(x >> (8 * i));
+    }
+}
+
+/**
+ * make header of saved jump matrix.
+ * @param header output
+ * @param key key of jump matrix
+ */
+static void put_key(unsigned char header[JUMP_MATRIX_HEADER_SIZE],
+		    const f2_jump_matrix_key * key)
+{
+    memcpy(header, jump_matrix_magic, 8);
+    put_le(header + 8, jump_matrix_version, 4);
+    put_le(header + 12, key->bits, 4);
+    put_le(header + 16, key->mat1, 4);
+    put_le(header + 20, key->mat2, 4);
+    put_le(header + 24, key->characteristic.ar[0], 8);
+    put_le(header + 32, key->characteristic.ar[1], 8);
+    put_le(header + 40, key->lower_step, 8);
+    put_le(header + 48, key->upper_step, 8);
+}
+
+/**
+ * save jump matrix to file.
+ * The format is independent of byte order of the machine:
+ * 8 bytes of magic, 32-bit version number, the key, bits, mat1, mat2,
+ * characteristic polynomial, lower and upper step, and columns of the
+ * matrix as 64-bit integers, all integers are in little endian.
+ * @param fp output file opened in binary mode
+ * @param key key of jump matrix
+ * @param matrix jump matrix
+ * @return 0 if success, -1 if error
+ */
+int f2_jump_matrix_save(FILE * fp, const f2_jump_matrix_key * key,
+			const f2_jump_matrix * matrix)
+{
+    unsigned char header[JUMP_MATRIX_HEADER_SIZE];
+    unsigned char buffer[16];
+
+    put_key(header, key);
+    if (fwrite(header, 1, JUMP_MATRIX_HEADER_SIZE, fp)
+	!= JUMP_MATRIX_HEADER_SIZE) {
+	return -1;
+    }
+    /* columns are table[n][1 << b] */
+    for (int j = 0; j < 128; j++) {
+	const uint64_t * col = matrix->table[j / 4][1 << (j % 4)];
+	put_le(buffer, col[0], 8);
+	put_le(buffer + 8, col[1], 8);
+	if (fwrite(buffer, 1, 16, fp) != 16) {
+	    return -1;
+	}
+    }
+    return 0;
+}
+
+/**
+ * load jump matrix saved by f2_jump_matrix_save.
+ * The file is rejected unless its version and key are the same as
+ * expected, so that the matrix of other generator or other step is not
+ * used by mistake. steps of the matrix is taken from the key.
+ * @param fp input file opened in binary mode
+ * @param key expected key of jump matrix
+ * @param matrix jump matrix
+ * @return 0 if success, -1 if error or mismatch of key
+ */
+int f2_jump_matrix_load(FILE * fp, const f2_jump_matrix_key * key,
+			f2_jump_matrix * matrix)
+{
+    unsigned char expected[JUMP_MATRIX_HEADER_SIZE];
+    unsigned char header[JUMP_MATRIX_HEADER_SIZE];
+    unsigned char buffer[16];
+    uint64_t column[128][2];
+
+    put_key(expected, key);
+    if (fread(header, 1, JUMP_MATRIX_HEADER_SIZE, fp)
+	!= JUMP_MATRIX_HEADER_SIZE
+	|| memcmp(header, expected, JUMP_MATRIX_HEADER_SIZE) != 0) {
+	return -1;
+    }
+    for (int j = 0; j < 128; j++) {
+	if (fread(buffer, 1, 16, fp) != 16) {
+	    return -1;
+	}
+	column[j][0] = 0;
+	column[j][1] = 0;
+	for (int i = 0; i < 16; i++) {
+	    column[j][i / 8] |= (uint64_t)buffer[i] << (8 * (i % 8));
+	}
+    }
+    f2_jump_matrix_set_columns(matrix, column);
+    matrix->steps = key->upper_step != 0 ? UINT64_MAX : key->lower_step;
+    return 0;
+}
@@ -21,6 +21,10 @@
 
 #include <stdint.h>
 #include <inttypes.h>
+#include <stdio.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #if defined(__cplusplus)
 extern "C" {
@@ -36,6 +40,94 @@ struct F2_POLYNOMIAL128_T {
 
 typedef struct F2_POLYNOMIAL128_T f2_polynomial;
 
+/**
+ * Jump polynomials for 2<sup>0</sup>, 2<sup>1</sup>, ..., 2<sup>63</sup>
+ * times base_step steps. poly[i] is used to jump 2<sup>i</sup> * base_step
+ * steps. base_step is 1 for the table made by calculate_jump_table.
+ */
+struct F2_JUMP_TABLE_T {
+    f2_polynomial poly[64];
+    /** steps of poly[0], UINT64_MAX if it is 2<sup>64</sup> or more */
+    uint64_t base_step;
+    /** characteristic polynomial, modulus of products of poly[i] */
+    f2_polynomial characteristic;
+};
+
+typedef struct F2_JUMP_TABLE_T f2_jump_table;
+
+/**
+ * Jump matrix over F<sub>2</sub> for 128-bit internal state.
+ * The matrix is kept as 32 tables of 16 entries, table[n][v] is the
+ * sum of columns 4n to 4n+3 selected by bits of v, so that the
+ * matrix-vector product is 32 table lookups.
+ * Bit j of state is bit (j % 64) of word (j / 64), where words are
+ * status[0] | (status[1] << 32) and status[2] | (status[3] << 32)
+ * for tinymt32, and status[0] and status[1] for tinymt64.
+ * steps is charged to the count of guard by jump by matrix.
+ */
+struct F2_JUMP_MATRIX_T {
+    uint64_t table[32][16][2];
+    /** steps of the jump, UINT64_MAX if unknown or 2<sup>64</sup> or more */
+    uint64_t steps;
+};
+
+typedef struct F2_JUMP_MATRIX_T f2_jump_matrix;
+
+/**
+ * Key of jump matrix, generator and step for which the matrix is
+ * calculated. Saved jump matrix is loaded only for the same key.
+ * tmat is not in the key, because it does not change the state.
+ */
+struct F2_JUMP_MATRIX_KEY_T {
+    /** 32 for tinymt32, 64 for tinymt64 */
+    uint32_t bits;
+    uint32_t mat1;
+    uint32_t mat2;
+    f2_polynomial characteristic;
+    uint64_t lower_step;
+    uint64_t upper_step;
+};
+
+typedef struct F2_JUMP_MATRIX_KEY_T f2_jump_matrix_key;
+
+/**
+ * multiplication of jump matrix and state vector.
+ * @param dest result, may be same as src
+ * @param matrix jump matrix
+ * @param src state vector
+ */
+inline static void f2_jump_matrix_apply(uint64_t dest[2],
+					const f2_jump_matrix * matrix,
+					const uint64_t src[2])
+{
+#if defined(__SSE2__)
+    __m128i r = _mm_setzero_si128();
+    for (int w = 0; w < 2; w++) {
+	uint64_t s = src[w];
+	for (int n = 0; n < 16; n++) {
+	    const uint64_t * t = matrix->table[16 * w + n][s & 0xf];
+	    r = _mm_xor_si128(r, _mm_loadu_si128((const __m128i *)t));
+	    s = s >> 4;
+	}
+    }
+    _mm_storeu_si128((__m128i *)dest, r);
+#else
+    uint64_t r0 = 0;
+    uint64_t r1 = 0;
+    for (int w = 0; w < 2; w++) {
+	uint64_t s = src[w];
+	for (int n = 0; n < 16; n++) {
+	    const uint64_t * t = matrix->table[16 * w + n][s & 0xf];
+	    r0 ^= t[0];
+	    r1 ^= t[1];
+	    s = s >> 4;
+	}
+    }
+    dest[0] = r0;
+    dest[1] = r1;
+#endif
+}
+
 void strtopolynomial(f2_polynomial * poly, const char * str);
 void polynomialtostr(char * str, const f2_polynomial * poly);
 void polynomial_power_mod(f2_polynomial * dest,
@@ -47,6 +139,17 @@ void calculate_jump_polynomial(f2_polynomial *jump_poly,
 			       uint64_t lower_step,
 			       uint64_t upper_step,
 			       const char * poly_str);
+void calculate_jump_table(f2_jump_table * table, const char * poly_str);
+uint64_t f2_jump_table_steps(const f2_jump_table * table, uint64_t step);
+void f2_jump_table_polynomial(f2_polynomial * jump_poly,
+			      const f2_jump_table * table,
+			      uint64_t step);
+void f2_jump_matrix_set_columns(f2_jump_matrix * matrix,
+				uint64_t column[128][2]);
+int f2_jump_matrix_save(FILE * fp, const f2_jump_matrix_key * key,
+			const f2_jump_matrix * matrix);
+int f2_jump_matrix_load(FILE * fp, const f2_jump_matrix_key * key,
+			f2_jump_matrix * matrix);
 #if defined(__cplusplus)
 }
 #endif
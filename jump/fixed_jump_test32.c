@@ -0,0 +1,63 @@
+#include "jump32.h"
+#include "tinymt32.h"
+#include "fixed_jump32_sample.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*
+ * fixed_jump32_sample.h is generated by gen_fixed_jump32 for
+ * 8f7011ee fc78ff1f 3793fdff and 3^40 steps, see Makefile.
+ */
+int main(void) {
+    tinymt32_t tiny;
+    tinymt32_t new_tiny;
+    const char * poly = "d8524022ed8dff4a8dcc50c798faba43";
+    uint64_t step = UINT64_C(12157665459056928801);
+    f2_polynomial jump_poly;
+    int repeat = 100000;
+    clock_t start;
+    double elapsed;
+    int check = 0;
+
+    tiny.mat1 = 0x8f7011ee;
+    tiny.mat2 = 0xfc78ff1f;
+    tiny.tmat = 0x3793fdff;
+    calculate_jump_polynomial(&jump_poly, step, 0, poly);
+    for (uint32_t seed = 1; seed < 100; seed++) {
+	tinymt32_init(&tiny, seed);
+	new_tiny = tiny;
+	tinymt32_jump_by_polynomial(&tiny, &jump_poly);
+	tinymt32_fixed_jump(&new_tiny);
+	for (int i = 0; i < 10; i++) {
+	    if (tinymt32_generate_uint32(&tiny)
+		!= tinymt32_generate_uint32(&new_tiny)) {
+		check = 1;
+	    }
+	}
+    }
+    if (check == 0) {
+	printf("OK!\n");
+    } else {
+	printf("NG!\n");
+	return 1;
+    }
+    start = clock();
+    for (int i = 0; i < repeat; i++) {
+	tinymt32_jump_by_polynomial(&tiny, &jump_poly);
+    }
+    elapsed = (double)(clock() - start);
+    elapsed = 1.0e9 * elapsed / CLOCKS_PER_SEC / repeat;
+    printf("jump by polynomial time = %f ns\n", elapsed);
+    start = clock();
+    for (int i = 0; i < repeat; i++) {
+	tinymt32_fixed_jump(&new_tiny);
+    }
+    elapsed = (double)(clock() - start);
+    elapsed = 1.0e9 * elapsed / CLOCKS_PER_SEC / repeat;
+    printf("fixed jump time = %f ns\n", elapsed);
+    printf("%08"PRIx32" %08"PRIx32"\n",
+	   tinymt32_generate_uint32(&tiny),
+	   tinymt32_generate_uint32(&new_tiny));
+    return 0;
+}
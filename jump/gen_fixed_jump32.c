@@ -0,0 +1,226 @@
+/**
+ * @file gen_fixed_jump32.c
+ *
+ * @brief generator of fixed step jump function for tinymt32
+ *
+ * This program calculates the jump of fixed step for fixed parameters
+ * as 128x128 matrix over F<sub>2</sub>, and outputs C header file
+ * which has an unrolled, branch-free jump function using the matrix.
+ * The matrix is stored as 32 tables of 16 entries, each of which is
+ * the sum of four columns, and the matrix-vector product is
+ * 32 table lookups and exclusive-ors.
+ * The generated function gives the same result as
+ * tinymt32_jump_by_polynomial, without loop over coefficients of the
+ * jump polynomial.
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and University of Tokyo.
+ * All rights reserved.
+ *
+ * The 3-clause BSD License is applied to this software, see
+ * LICENSE.txt
+ */
+#include "jump32.h"
+#include "tinymt32.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+static void calc_table(uint32_t table[32][16][4], tinymt32_t * tiny,
+		       f2_polynomial * jump_poly);
+static void apply_table(uint32_t dest[4], uint32_t table[32][16][4],
+			const uint32_t src[4]);
+static int check_table(uint32_t table[32][16][4], tinymt32_t * tiny,
+		       f2_polynomial * jump_poly);
+static void print_header(const char * name, uint32_t table[32][16][4],
+			 const char * poly_str, tinymt32_t * tiny,
+			 uint64_t lower_step, uint64_t upper_step);
+
+/**
+ * calculate jump matrix in the form of tables.
+ * Bit j of state is bit (j % 32) of status[j / 32].
+ * The matrix is calculated by tinymt32_calculate_jump_matrix, whose
+ * table[n][v] is the sum of columns 4n to 4n+3 of the jump matrix
+ * selected by v, and its 64-bit words are split into status words.
+ * @param table jump matrix
+ * @param tiny tinymt32 structure which has parameters
+ * @param jump_poly jump polynomial
+ */
+static void calc_table(uint32_t table[32][16][4], tinymt32_t * tiny,
+		       f2_polynomial * jump_poly)
+{
+    static f2_jump_matrix matrix;
+
+    tinymt32_calculate_jump_matrix(&matrix, tiny, jump_poly);
+    for (int n = 0; n < 32; n++) {
+	for (int v = 0; v < 16; v++) {
+	    for (int k = 0; k < 4; k++) {
+		table[n][v][k] = (uint32_t)(matrix.table[n][v][k / 2]
+					    >> (32 * (k % 2)));
+	    }
+	}
+    }
+}
+
+/**
+ * multiply jump matrix and state vector
+ * @param dest output state
+ * @param table jump matrix
+ * @param src input state
+ */
+static void apply_table(uint32_t dest[4], uint32_t table[32][16][4],
+			const uint32_t src[4])
+{
+    for (int k = 0; k < 4; k++) {
+	dest[k] = 0;
+    }
+    for (int n = 0; n < 32; n++) {
+	uint32_t v = (src[n / 8] >> (4 * (n % 8))) & 0xf;
+	for (int k = 0; k < 4; k++) {
+	    dest[k] ^= table[n][v][k];
+	}
+    }
+}
+
+/**
+ * compare matrix jump with tinymt32_jump_by_polynomial.
+ * @param table jump matrix
+ * @param tiny initialized tinymt32 structure
+ * @param jump_poly jump polynomial
+ * @return 0 if OK
+ */
+static int check_table(uint32_t table[32][16][4], tinymt32_t * tiny,
+		       f2_polynomial * jump_poly)
+{
+    tinymt32_t work = *tiny;
+    uint32_t result[4];
+
+    apply_table(result, table, tiny->status);
+    tinymt32_jump_by_polynomial(&work, jump_poly);
+    for (int k = 0; k < 4; k++) {
+	if (result[k] != work.status[k]) {
+	    return 1;
+	}
+    }
+    return 0;
+}
+
+/**
+ * output C header file
+ * @param name name of the jump function
+ * @param table jump matrix
+ * @param poly_str characteristic polynomial
+ * @param tiny tinymt32 structure which has parameters
+ * @param lower_step lower bit of 128-bit integer
+ * @param upper_step upper bit of 128-bit integer
+ */
+static void print_header(const char * name, uint32_t table[32][16][4],
+			 const char * poly_str, tinymt32_t * tiny,
+			 uint64_t lower_step, uint64_t upper_step)
+{
+    char guard[100];
+    int len = 0;
+
+    for (; name[len] != 0 && len < 97; len++) {
+	guard[len] = (char)toupper((unsigned char)name[len]);
+    }
+    guard[len] = 0;
+    printf("/*\n");
+    printf(" * generated by gen_fixed_jump32, do not edit.\n");
+    printf(" * characteristic polynomial:%s\n", poly_str);
+    printf(" * mat1:%08"PRIx32" mat2:%08"PRIx32" tmat:%08"PRIx32"\n",
+	   tiny->mat1, tiny->mat2, tiny->tmat);
+    printf(" * step: %"PRIu64" x 2^64 + %"PRIu64"\n", upper_step, lower_step);
+    printf(" */\n");
+    printf("#ifndef %s_H\n", guard);
+    printf("#define %s_H\n\n", guard);
+    printf("#include \"tinymt32.h\"\n\n");
+    printf("#if defined(__cplusplus)\n");
+    printf("extern \"C\" {\n");
+    printf("#endif\n\n");
+    printf("/**\n");
+    printf(" * jump matrix, %s_table[n][v] is the sum of columns\n", name);
+    printf(" * 4n to 4n+3 of the matrix selected by bits of v.\n");
+    printf(" */\n");
+    printf("static const uint32_t %s_table[32][16][4] = {\n", name);
+    for (int n = 0; n < 32; n++) {
+	printf("    {\n");
+	for (int v = 0; v < 16; v++) {
+	    printf("        {UINT32_C(0x%08"PRIx32"), UINT32_C(0x%08"PRIx32"),"
+		   " UINT32_C(0x%08"PRIx32"), UINT32_C(0x%08"PRIx32")}%s\n",
+		   table[n][v][0], table[n][v][1],
+		   table[n][v][2], table[n][v][3],
+		   v < 15 ? "," : "");
+	}
+	printf("    }%s\n", n < 31 ? "," : "");
+    }
+    printf("};\n\n");
+    printf("/**\n");
+    printf(" * jump %"PRIu64" x 2^64 + %"PRIu64" steps.\n",
+	   upper_step, lower_step);
+    printf(" * The result is same as tinymt32_jump_by_polynomial.\n");
+    printf(" * GCC -O3 code of this function inlined into a loop is two or\n");
+    printf(" * three times slower than out of line, so it is not inlined.\n");
+    printf(" * @param tiny tinymt32 structure, overwritten by new state.\n");
+    printf(" */\n");
+    printf("#if defined(__GNUC__)\n");
+    printf("__attribute__((noinline, unused))\n");
+    printf("static void %s(tinymt32_t * tiny)\n", name);
+    printf("#else\n");
+    printf("inline static void %s(tinymt32_t * tiny)\n", name);
+    printf("#endif\n");
+    printf("{\n");
+    for (int k = 0; k < 4; k++) {
+	printf("    uint32_t s%d = tiny->status[%d];\n", k, k);
+    }
+    for (int k = 0; k < 4; k++) {
+	printf("    uint32_t r%d = 0;\n", k);
+    }
+    printf("    const uint32_t * t;\n");
+    for (int n = 0; n < 32; n++) {
+	printf("    t = %s_table[%d][(s%d >> %d) & 0xf];\n",
+	       name, n, n / 8, 4 * (n % 8));
+	printf("    r0 ^= t[0]; r1 ^= t[1]; r2 ^= t[2]; r3 ^= t[3];\n");
+    }
+    for (int k = 0; k < 4; k++) {
+	printf("    tiny->status[%d] = r%d;\n", k, k);
+    }
+    printf("}\n\n");
+    printf("#if defined(__cplusplus)\n");
+    printf("}\n");
+    printf("#endif\n\n");
+    printf("#endif\n");
+}
+
+int main(int argc, char * argv[]) {
+    if (argc < 8) {
+	printf("usage:\n%s name polynomial mat1 mat2 tmat lower upper\n",
+	       argv[0]);
+	return -1;
+    }
+    tinymt32_t tiny;
+    f2_polynomial jump_poly;
+    static uint32_t table[32][16][4];
+    const char * name = argv[1];
+    const char * poly_str = argv[2];
+    tiny.mat1 = (uint32_t)strtoul(argv[3], NULL, 16);
+    tiny.mat2 = (uint32_t)strtoul(argv[4], NULL, 16);
+    tiny.tmat = (uint32_t)strtoul(argv[5], NULL, 16);
+    uint64_t lower_step = strtoull(argv[6], NULL, 10);
+    uint64_t upper_step = strtoull(argv[7], NULL, 10);
+
+    calculate_jump_polynomial(&jump_poly, lower_step, upper_step, poly_str);
+    calc_table(table, &tiny, &jump_poly);
+    for (uint32_t seed = 1; seed < 10; seed++) {
+	tinymt32_init(&tiny, seed);
+	if (check_table(table, &tiny, &jump_poly)) {
+	    fprintf(stderr, "jump matrix check failed\n");
+	    return 1;
+	}
+    }
+    print_header(name, table, poly_str, &tiny, lower_step, upper_step);
+    return 0;
+}
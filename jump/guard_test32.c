@@ -0,0 +1,139 @@
+/*
+ * This program should be compiled with -DTINYMT_GUARD, together with
+ * tinymt32.c, jump32.c and stream_pool32.c, see Makefile.
+ */
+#include "stream_pool32.h"
+#include "jump32.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#if !defined(TINYMT_GUARD)
+#error "compile with -DTINYMT_GUARD"
+#endif
+
+#define THREADS 4
+#define STREAMS 10000
+#define STRIDE 1000
+
+struct THREAD_ARG {
+    tinymt32_stream_pool * pool;
+    tinymt_guard_stats * shared;
+    uint64_t overflows;
+};
+
+void * worker(void * p);
+
+void * worker(void * p)
+{
+    struct THREAD_ARG * arg = p;
+    tinymt32_stream_cursor cursor;
+    tinymt_guard_stats local;
+    tinymt32_t stream;
+    uint64_t index;
+
+    tinymt32_stream_cursor_init(&cursor, arg->pool);
+    tinymt_guard_clear(&local);
+    arg->overflows = 0;
+    while (tinymt32_stream_acquire(&cursor, &stream, &index) == 0) {
+	/* every 10th stream uses more than stride */
+	uint64_t count = index % 10 == 0 ? STRIDE + 1 : index % STRIDE;
+	for (uint64_t i = 0; i < count; i++) {
+	    tinymt32_generate_uint32(&stream);
+	}
+	if (tinymt32_guard_overflow(&stream)) {
+	    arg->overflows++;
+	}
+	tinymt32_guard_retire(&stream, &local);
+	if (local.streams == 100) {
+	    tinymt_guard_flush(arg->shared, &local);
+	}
+    }
+    tinymt_guard_flush(arg->shared, &local);
+    return NULL;
+}
+
+int main(int argc, char * argv[]) {
+    if (argc < 5) {
+	printf("usage:\n%s polynomial mat1 mat2 tmat\n", argv[0]);
+	return -1;
+    }
+    static tinymt32_stream_pool pool;
+    tinymt_guard_stats shared;
+    tinymt32_t tiny;
+    pthread_t threads[THREADS];
+    struct THREAD_ARG args[THREADS];
+    uint64_t overflows = 0;
+    int check = 0;
+
+    tiny.mat1 = (uint32_t)strtoul(argv[2], NULL, 16);
+    tiny.mat2 = (uint32_t)strtoul(argv[3], NULL, 16);
+    tiny.tmat = (uint32_t)strtoul(argv[4], NULL, 16);
+    /* jump counts skipped steps */
+    tinymt32_init(&tiny, 1);
+    tinymt32_generate_uint32(&tiny);
+    tinymt32_jump(&tiny, 100, 0, argv[1]);
+    if (tiny.guard_count != 101 || tinymt32_guard_overflow(&tiny)) {
+	printf("jump count %"PRIu64"\n", tiny.guard_count);
+	check = 1;
+    }
+    if (tinymt32_stream_pool_init(&pool, &tiny, 1, argv[1], STRIDE, 0, STREAMS)
+	!= 0) {
+	printf("pool is not accepted\n");
+	return 1;
+    }
+    /* jump by table of stride counts step * stride, saturated */
+    tiny = pool.base;
+    tinymt32_jump_by_table(&tiny, &pool.stride_table, 3);
+    if (tiny.guard_count != 3 * STRIDE) {
+	printf("table count %"PRIu64"\n", tiny.guard_count);
+	check = 1;
+    }
+    tinymt32_jump_by_table(&tiny, &pool.stride_table, UINT64_MAX / 2);
+    if (tiny.guard_count != UINT64_MAX) {
+	printf("table count %"PRIu64" is not saturated\n", tiny.guard_count);
+	check = 1;
+    }
+    /* jump by polynomial of unknown steps saturates the count */
+    tinymt32_guard_set_limit(&tiny, STRIDE);
+    tinymt32_jump_by_polynomial(&tiny, &pool.stride_table.poly[0]);
+    if (tiny.guard_count != UINT64_MAX || !tinymt32_guard_overflow(&tiny)) {
+	printf("polynomial count %"PRIu64"\n", tiny.guard_count);
+	check = 1;
+    }
+    /* jump by matrix counts its steps, one rule for array */
+    tinymt32_guard_set_limit(&tiny, 2 * STRIDE);
+    tinymt32_generate_uint32(&tiny);
+    tinymt32_jump_by_matrix(&tiny, &pool.stride_matrix);
+    tinymt32_jump_array_by_matrix(&tiny, 1, &pool.stride_matrix);
+    if (tiny.guard_count != 2 * STRIDE + 1
+	|| !tinymt32_guard_overflow(&tiny)) {
+	printf("matrix count %"PRIu64"\n", tiny.guard_count);
+	check = 1;
+    }
+    tinymt_guard_clear(&shared);
+    for (int i = 0; i < THREADS; i++) {
+	args[i].pool = &pool;
+	args[i].shared = &shared;
+	pthread_create(&threads[i], NULL, worker, &args[i]);
+    }
+    for (int i = 0; i < THREADS; i++) {
+	pthread_join(threads[i], NULL);
+	overflows += args[i].overflows;
+    }
+    printf("streams:%"PRIu64" steps:%"PRIu64" overflows:%"PRIu64
+	   " max steps:%"PRIu64"\n",
+	   shared.streams, shared.steps, shared.overflows, shared.max_steps);
+    if (shared.streams != STREAMS
+	|| shared.overflows != STREAMS / 10
+	|| overflows != STREAMS / 10
+	|| shared.max_steps != STRIDE + 1) {
+	check = 1;
+    }
+    if (check == 0) {
+	printf("OK!\n");
+    } else {
+	printf("NG!\n");
+    }
+    return check;
+}
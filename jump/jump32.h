@@ -14,6 +14,32 @@ void tinymt32_jump(tinymt32_t *tiny,
 		   const char * poly_str);
 void tinymt32_jump_by_polynomial(tinymt32_t *tiny,
 				 f2_polynomial * jump_poly);
+void tinymt32_jump_by_table(tinymt32_t *tiny,
+			    const f2_jump_table * table,
+			    uint64_t step);
+uint32_t tinymt32_at(const tinymt32_t *param,
+		     uint32_t seed,
+		     const f2_jump_table * table,
+		     uint64_t index);
+void tinymt32_at_block(const tinymt32_t *param,
+		       uint32_t seed,
+		       const f2_jump_table * table,
+		       uint64_t index,
+		       uint32_t array[],
+		       int size);
+void tinymt32_calculate_jump_matrix(f2_jump_matrix * matrix,
+				    const tinymt32_t * tiny,
+				    f2_polynomial * jump_poly);
+void tinymt32_jump_matrix_key(f2_jump_matrix_key * key,
+			      const tinymt32_t * tiny,
+			      const char * poly_str,
+			      uint64_t lower_step,
+			      uint64_t upper_step);
+void tinymt32_jump_by_matrix(tinymt32_t *tiny,
+			     const f2_jump_matrix * matrix);
+void tinymt32_jump_array_by_matrix(tinymt32_t tiny[],
+				   int size,
+				   const f2_jump_matrix * matrix);
 
 #if defined(__cplusplus)
 }
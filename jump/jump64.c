@@ -19,9 +19,12 @@
  * LICENSE.txt
  */
 #include "jump64.h"
+#include "f2-dispatch.h"
 #include <stdio.h>
 
 static void tinymt64_add(tinymt64_t *dest, const tinymt64_t *src);
+static void tinymt64_jump_state(tinymt64_t *tiny,
+				const f2_polynomial * jump_poly);
 
 /**
  * Addition of internal state as F<sub>2</sub> vector.
@@ -51,20 +54,20 @@ static void tinymt64_add(tinymt64_t *dest, const tinymt64_t *src)
 
     calculate_jump_polynomial(
 	&jump_poly, lower_step, upper_step, poly_str);
-    tinymt64_jump_by_polynomial(tiny, &jump_poly);
+    tinymt64_jump_state(tiny, &jump_poly);
+#if defined(TINYMT_GUARD)
+    tinymt64_guard_skip(tiny, upper_step != 0 ? UINT64_MAX : lower_step);
+#endif
 }
 
 /**
- * jump using the jump polynomial.
- * This function is not as time consuming as calculating jump polynomial.
- * This function can use multiple time for the tinymt64 structure.
+ * jump the state using the jump polynomial, the guard is not changed.
  * @param tiny tinymt64 structure, overwritten by new state after calling
  * this function.
- * @param jump_poly the jump polynomial calculated by
- * tinymt64_calculate_jump_polynomial.
+ * @param jump_poly the jump polynomial.
  */
-void tinymt64_jump_by_polynomial(tinymt64_t *tiny,
-		   f2_polynomial * jump_poly)
+static void tinymt64_jump_state(tinymt64_t *tiny,
+				const f2_polynomial * jump_poly)
 {
     tinymt64_t work_z;
     tinymt64_t * work = &work_z;
@@ -91,3 +94,210 @@ void tinymt64_jump_by_polynomial(tinymt64_t *tiny,
     }
     *tiny = *work;
 }
+
+/**
+ * jump using the jump polynomial.
+ * This function is not as time consuming as calculating jump polynomial.
+ * This function can use multiple time for the tinymt64 structure.
+ * The polynomial does not tell the number of steps, so the count of
+ * guard is charged with UINT64_MAX, and tinymt64_guard_overflow is true
+ * unless the limit is UINT64_MAX. Call tinymt64_guard_set_limit after
+ * this function to start a new substream.
+ * @param tiny tinymt64 structure, overwritten by new state after calling
+ * this function.
+ * @param jump_poly the jump polynomial calculated by
+ * tinymt64_calculate_jump_polynomial.
+ */
+void tinymt64_jump_by_polynomial(tinymt64_t *tiny,
+		   f2_polynomial * jump_poly)
+{
+    tinymt64_jump_state(tiny, jump_poly);
+#if defined(TINYMT_GUARD)
+    tinymt64_guard_skip(tiny, UINT64_MAX);
+#endif
+}
+
+/**
+ * jump using the jump table.
+ * The jump polynomial is the product of table->poly[i] for every bit i
+ * set in step, made by f2_jump_table_polynomial, and the state is jumped
+ * once by it. The state jumps step * table->base_step steps, and the
+ * count of guard is charged with it.
+ * @param tiny tinymt64 structure, overwritten by new state after calling
+ * this function.
+ * @param table the jump table calculated by calculate_jump_table.
+ * @param step number of steps to jump.
+ */
+void tinymt64_jump_by_table(tinymt64_t *tiny,
+			    const f2_jump_table * table,
+			    uint64_t step)
+{
+    f2_polynomial jump_poly;
+
+#if defined(TINYMT_GUARD)
+    tinymt64_guard_skip(tiny, f2_jump_table_steps(table, step));
+#endif
+    f2_jump_table_polynomial(&jump_poly, table, step);
+    tinymt64_jump_state(tiny, &jump_poly);
+}
+
+/**
+ * random access to the output sequence.
+ * This function returns the index-th output of tinymt64 initialized
+ * by seed, without changing any state, i.e. the same value as the
+ * (index + 1)-th call of tinymt64_generate_uint64 after
+ * tinymt64_init.
+ * @param param tinymt64 structure which has parameters, status is not used.
+ * @param seed seed of the sequence.
+ * @param table the jump table calculated by calculate_jump_table for
+ * the characteristic polynomial of param.
+ * @param index position of the output in the sequence, starts from 0.
+ * @return the index-th output
+ */
+uint64_t tinymt64_at(const tinymt64_t *param,
+		     uint64_t seed,
+		     const f2_jump_table * table,
+		     uint64_t index)
+{
+    tinymt64_t tiny = *param;
+
+    tinymt64_init(&tiny, seed);
+    tinymt64_jump_by_table(&tiny, table, index);
+    return tinymt64_generate_uint64(&tiny);
+}
+
+/**
+ * random access to the output sequence.
+ * This function fills array with index-th, (index + 1)-th, ...,
+ * (index + size - 1)-th outputs of tinymt64 initialized by seed.
+ * @param param tinymt64 structure which has parameters, status is not used.
+ * @param seed seed of the sequence.
+ * @param table the jump table calculated by calculate_jump_table for
+ * the characteristic polynomial of param.
+ * @param index position of the first output in the sequence, starts from 0.
+ * @param array outputs are written here.
+ * @param size number of outputs.
+ */
+void tinymt64_at_block(const tinymt64_t *param,
+		       uint64_t seed,
+		       const f2_jump_table * table,
+		       uint64_t index,
+		       uint64_t array[],
+		       int size)
+{
+    tinymt64_t tiny = *param;
+
+    tinymt64_init(&tiny, seed);
+    tinymt64_jump_by_table(&tiny, table, index);
+    for (int i = 0; i < size; i++) {
+	array[i] = tinymt64_generate_uint64(&tiny);
+    }
+}
+
+/**
+ * calculate jump matrix from the jump polynomial.
+ * The jump matrix gives the same jump as the jump polynomial, and
+ * jump by matrix is much faster than jump by polynomial.
+ * This function is time consuming, the matrix should be calculated
+ * once for the parameters and the step, and be used many times.
+ * steps of the matrix is UINT64_MAX, set it if the step is known.
+ * @param matrix the result of this calculation.
+ * @param tiny tinymt64 structure which has parameters, status is not used.
+ * @param jump_poly the jump polynomial calculated by
+ * calculate_jump_polynomial.
+ */
+void tinymt64_calculate_jump_matrix(f2_jump_matrix * matrix,
+				    const tinymt64_t * tiny,
+				    f2_polynomial * jump_poly)
+{
+    tinymt64_t work = *tiny;
+    uint64_t column[128][2];
+
+    for (int j = 0; j < 128; j++) {
+	work.status[0] = 0;
+	work.status[1] = 0;
+	work.status[j / 64] = UINT64_C(1) << (j % 64);
+	tinymt64_jump_state(&work, jump_poly);
+	column[j][0] = work.status[0];
+	column[j][1] = work.status[1];
+    }
+    f2_jump_matrix_set_columns(matrix, column);
+}
+
+/**
+ * make key of jump matrix, which is saved with the matrix by
+ * f2_jump_matrix_save and checked by f2_jump_matrix_load.
+ * @param key the key
+ * @param tiny tinymt64 structure which has parameters, status is not used.
+ * @param poly_str string of the characteristic polynomial generated by
+ * tinymt64dc
+ * @param lower_step lower bit of 128-bit step of the matrix
+ * @param upper_step upper bit of 128-bit step of the matrix
+ */
+void tinymt64_jump_matrix_key(f2_jump_matrix_key * key,
+			      const tinymt64_t * tiny,
+			      const char * poly_str,
+			      uint64_t lower_step,
+			      uint64_t upper_step)
+{
+    key->bits = 64;
+    key->mat1 = tiny->mat1;
+    key->mat2 = tiny->mat2;
+    strtopolynomial(&key->characteristic, poly_str);
+    key->lower_step = lower_step;
+    key->upper_step = upper_step;
+}
+
+/**
+ * jump using the jump matrix.
+ * The count of guard is charged with matrix->steps, which is UINT64_MAX
+ * unless the matrix is loaded by f2_jump_matrix_load or its steps is
+ * set by the caller.
+ * @param tiny tinymt64 structure, overwritten by new state after calling
+ * this function.
+ * @param matrix the jump matrix calculated by
+ * tinymt64_calculate_jump_matrix.
+ */
+void tinymt64_jump_by_matrix(tinymt64_t *tiny,
+			     const f2_jump_matrix * matrix)
+{
+    f2_jump_matrix_apply(tiny->status, matrix, tiny->status);
+#if defined(TINYMT_GUARD)
+    tinymt64_guard_skip(tiny, matrix->steps);
+#endif
+}
+
+/**
+ * jump all elements of array using the same jump matrix.
+ * The count of guard of every element is charged with matrix->steps.
+ * States are jumped by the matrix kernel of f2_kernels(),
+ * F2_DISPATCH_CHUNK states at a time.
+ * @param tiny array of tinymt64 structures, overwritten by new states
+ * after calling this function.
+ * @param size number of elements of array.
+ * @param matrix the jump matrix calculated by
+ * tinymt64_calculate_jump_matrix.
+ */
+void tinymt64_jump_array_by_matrix(tinymt64_t tiny[],
+				   int size,
+				   const f2_jump_matrix * matrix)
+{
+    uint64_t s[F2_DISPATCH_CHUNK][2];
+    const struct F2_KERNELS_T * kernels = f2_kernels();
+
+    for (int i = 0; i < size; i += F2_DISPATCH_CHUNK) {
+	int n = size - i < F2_DISPATCH_CHUNK ? size - i : F2_DISPATCH_CHUNK;
+	for (int j = 0; j < n; j++) {
+	    s[j][0] = tiny[i + j].status[0];
+	    s[j][1] = tiny[i + j].status[1];
+	}
+	kernels->matrix_apply_array(s, n, matrix);
+	for (int j = 0; j < n; j++) {
+	    tiny[i + j].status[0] = s[j][0];
+	    tiny[i + j].status[1] = s[j][1];
+#if defined(TINYMT_GUARD)
+	    tinymt64_guard_skip(&tiny[i + j], matrix->steps);
+#endif
+	}
+    }
+}
@@ -14,6 +14,32 @@ void tinymt64_jump(tinymt64_t *tiny,
 		   const char * poly_str);
 void tinymt64_jump_by_polynomial(tinymt64_t *tiny,
 				 f2_polynomial * jump_poly);
+void tinymt64_jump_by_table(tinymt64_t *tiny,
+			    const f2_jump_table * table,
+			    uint64_t step);
+uint64_t tinymt64_at(const tinymt64_t *param,
+		     uint64_t seed,
+		     const f2_jump_table * table,
+		     uint64_t index);
+void tinymt64_at_block(const tinymt64_t *param,
+		       uint64_t seed,
+		       const f2_jump_table * table,
+		       uint64_t index,
+		       uint64_t array[],
+		       int size);
+void tinymt64_calculate_jump_matrix(f2_jump_matrix * matrix,
+				    const tinymt64_t * tiny,
+				    f2_polynomial * jump_poly);
+void tinymt64_jump_matrix_key(f2_jump_matrix_key * key,
+			      const tinymt64_t * tiny,
+			      const char * poly_str,
+			      uint64_t lower_step,
+			      uint64_t upper_step);
+void tinymt64_jump_by_matrix(tinymt64_t *tiny,
+			     const f2_jump_matrix * matrix);
+void tinymt64_jump_array_by_matrix(tinymt64_t tiny[],
+				   int size,
+				   const f2_jump_matrix * matrix);
 #if defined(__cplusplus)
 }
 #endif
@@ -2,9 +2,14 @@
 #include "tinymt32.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 
 void test(tinymt32_t * tiny, const char * poly_str, uint32_t seed);
 int check_tiny(tinymt32_t *a, tinymt32_t *b);
+int test_random_access(tinymt32_t * tiny, const char * poly_str, uint32_t seed);
+int test_jump_matrix(tinymt32_t * tiny, const char * poly_str, uint32_t seed);
+int test_small_jump(tinymt32_t * tiny, const char * poly_str, uint32_t seed);
+int test_at_speed(tinymt32_t * tiny, const char * poly_str, uint32_t seed);
 
 int check_tiny(tinymt32_t *a, tinymt32_t *b)
 {
@@ -120,6 +125,184 @@ void test(tinymt32_t * tiny, const char * poly_str, uint32_t seed)
     }
 }
 
+int test_random_access(tinymt32_t * tiny, const char * poly_str, uint32_t seed)
+{
+    f2_jump_table table;
+    uint64_t test[] = {0, 3, 1279, 100003, (UINT64_C(1) << 40) + 3};
+    uint32_t block[10];
+    tinymt32_t new_tiny;
+
+    calculate_jump_table(&table, poly_str);
+    for (int index = 0; index < 5; index++) {
+	int check = 0;
+	printf("random access %"PRIu64"\n", test[index]);
+	tinymt32_init(tiny, seed);
+	if (index < 4) {
+	    for (uint64_t i = 0; i < test[index]; i++) {
+		tinymt32_generate_uint32(tiny);
+	    }
+	} else {
+	    tinymt32_jump(tiny, test[index], 0, poly_str);
+	}
+	new_tiny = *tiny;
+	tinymt32_init(&new_tiny, seed);
+	tinymt32_jump_by_table(&new_tiny, &table, test[index]);
+	tinymt32_at_block(tiny, seed, &table, test[index], block, 10);
+	for (int i = 0; i < 10; i++) {
+	    uint32_t x = tinymt32_generate_uint32(tiny);
+	    uint32_t y = tinymt32_at(tiny, seed, &table,
+				test[index] + (uint64_t)i);
+	    uint32_t z = tinymt32_generate_uint32(&new_tiny);
+	    if (x != y || x != z || x != block[i]) {
+		printf("%d[%08"PRIx32",%08"PRIx32",%08"PRIx32"]\n", i, x, y, z);
+		check |= 1;
+	    }
+	}
+	if (check == 0) {
+	    printf("OK!\n");
+	} else {
+	    printf("NG!\n");
+	    return check;
+	}
+    }
+    return 0;
+}
+
+int test_jump_matrix(tinymt32_t * tiny, const char * poly_str, uint32_t seed)
+{
+    static f2_jump_matrix matrix;
+    static f2_jump_matrix loaded;
+    f2_jump_matrix_key key;
+    f2_jump_matrix_key other;
+    f2_polynomial jump_poly;
+    tinymt32_t a[10];
+    tinymt32_t b[10];
+    uint64_t test[] = {3, 1279, UINT64_C(12157665459056928801)};
+    FILE * fp;
+
+    for (int index = 0; index < 3; index++) {
+	printf("jump by matrix %"PRIu64"\n", test[index]);
+	calculate_jump_polynomial(&jump_poly, test[index], 0, poly_str);
+	tinymt32_calculate_jump_matrix(&matrix, tiny, &jump_poly);
+	tinymt32_jump_matrix_key(&key, tiny, poly_str, test[index], 0);
+	fp = tmpfile();
+	if (fp == NULL
+	    || f2_jump_matrix_save(fp, &key, &matrix) != 0
+	    || fseek(fp, 0, SEEK_SET) != 0
+	    || f2_jump_matrix_load(fp, &key, &loaded) != 0) {
+	    printf("save and load failed\n");
+	    printf("NG!\n");
+	    return 1;
+	}
+	/* matrix of other step or other generator is rejected */
+	for (int k = 0; k < 3; k++) {
+	    other = key;
+	    if (k == 0) {
+		other.lower_step++;
+	    } else if (k == 1) {
+		other.bits = 64;
+	    } else {
+		other.mat1 ^= 1;
+	    }
+	    if (fseek(fp, 0, SEEK_SET) != 0
+		|| f2_jump_matrix_load(fp, &other, &loaded) == 0) {
+		printf("load with wrong key %d succeeded\n", k);
+		printf("NG!\n");
+		return 1;
+	    }
+	}
+	fseek(fp, 0, SEEK_SET);
+	f2_jump_matrix_load(fp, &key, &loaded);
+	fclose(fp);
+	for (int i = 0; i < 10; i++) {
+	    a[i] = *tiny;
+	    tinymt32_init(&a[i], seed + (uint32_t)i);
+	    b[i] = a[i];
+	    tinymt32_jump_by_polynomial(&a[i], &jump_poly);
+	}
+	tinymt32_jump_array_by_matrix(b, 5, &matrix);
+	tinymt32_jump_array_by_matrix(b + 5, 5, &loaded);
+	for (int i = 0; i < 10; i++) {
+	    if (check_tiny(&a[i], &b[i])) {
+		return 1;
+	    }
+	}
+    }
+    return 0;
+}
+
+/*
+ * jump by every step up to 300. Shift by 64 bits in reduction of
+ * polynomials made jump polynomials wrong for some steps, for example
+ * 193 and 194.
+ */
+int test_small_jump(tinymt32_t * tiny, const char * poly_str, uint32_t seed)
+{
+    tinymt32_t a;
+    tinymt32_t b;
+
+    printf("jump 1 to 300\n");
+    tinymt32_init(tiny, seed);
+    b = *tiny;
+    for (uint64_t step = 1; step <= 300; step++) {
+	tinymt32_generate_uint32(&b);
+	a = *tiny;
+	tinymt32_jump(&a, step, 0, poly_str);
+	/* compare outputs, the top bit of status[0] is not in the state */
+	tinymt32_t c = b;
+	for (int i = 0; i < 4; i++) {
+	    if (tinymt32_generate_uint32(&a)
+		!= tinymt32_generate_uint32(&c)) {
+		printf("jump %"PRIu64" NG!\n", step);
+		return 1;
+	    }
+	}
+    }
+    printf("OK!\n");
+    return 0;
+}
+
+/*
+ * tinymt32_at multiplies the jump polynomials in the table and jumps
+ * the state once, so it should be faster than tinymt32_jump, which
+ * calculates the jump polynomial by powering. Both loops make the same
+ * outputs, so their exclusive or should be zero.
+ */
+int test_at_speed(tinymt32_t * tiny, const char * poly_str, uint32_t seed)
+{
+    f2_jump_table table;
+    uint64_t step = UINT64_C(12157665459056928801); /* 3^40 */
+    int count = 300;
+    uint32_t sum = 0;
+    clock_t start;
+    clock_t jump_clock;
+    clock_t at_clock;
+
+    printf("speed of tinymt32_at\n");
+    calculate_jump_table(&table, poly_str);
+    start = clock();
+    for (int i = 0; i < count; i++) {
+	tinymt32_init(tiny, seed);
+	tinymt32_jump(tiny, step + (uint64_t)i, 0, poly_str);
+	sum ^= tinymt32_generate_uint32(tiny);
+    }
+    jump_clock = clock() - start;
+    start = clock();
+    for (int i = 0; i < count; i++) {
+	sum ^= tinymt32_at(tiny, seed, &table, step + (uint64_t)i);
+    }
+    at_clock = clock() - start;
+    printf("jump:%.3fms at:%.3fms\n",
+	   (double)jump_clock * 1000 / CLOCKS_PER_SEC,
+	   (double)at_clock * 1000 / CLOCKS_PER_SEC);
+    if (sum != 0 || at_clock >= jump_clock) {
+	printf("NG!\n");
+	return 1;
+    }
+    printf("OK!\n");
+    return 0;
+}
+
 int main(int argc, char * argv[]) {
     if (argc < 5) {
 	printf("usage:\n%s polynomial mat1 mat2 tmat [seed]\n", argv[0]);
@@ -139,4 +322,8 @@ int main(int argc, char * argv[]) {
     printf("tmat:%08"PRIx32"\n", tiny.tmat);
     printf("seed:%d\n", seed);
     test(&tiny, argv[1], seed);
+    test_random_access(&tiny, argv[1], seed);
+    test_jump_matrix(&tiny, argv[1], seed);
+    test_small_jump(&tiny, argv[1], seed);
+    test_at_speed(&tiny, argv[1], seed);
 }
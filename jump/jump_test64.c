@@ -2,10 +2,15 @@
 #include "tinymt64.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 #include <inttypes.h>
 
 void test(tinymt64_t * tiny, const char * poly_str, uint64_t seed);
 int check_tiny(tinymt64_t *a, tinymt64_t *b);
+int test_random_access(tinymt64_t * tiny, const char * poly_str, uint64_t seed);
+int test_jump_matrix(tinymt64_t * tiny, const char * poly_str, uint64_t seed);
+int test_small_jump(tinymt64_t * tiny, const char * poly_str, uint64_t seed);
+int test_at_speed(tinymt64_t * tiny, const char * poly_str, uint64_t seed);
 
 int check_tiny(tinymt64_t *a, tinymt64_t *b)
 {
@@ -121,6 +126,184 @@ void test(tinymt64_t * tiny, const char * poly_str, uint64_t seed)
     }
 }
 
+int test_random_access(tinymt64_t * tiny, const char * poly_str, uint64_t seed)
+{
+    f2_jump_table table;
+    uint64_t test[] = {0, 3, 1279, 100003, (UINT64_C(1) << 40) + 3};
+    uint64_t block[10];
+    tinymt64_t new_tiny;
+
+    calculate_jump_table(&table, poly_str);
+    for (int index = 0; index < 5; index++) {
+	int check = 0;
+	printf("random access %"PRIu64"\n", test[index]);
+	tinymt64_init(tiny, seed);
+	if (index < 4) {
+	    for (uint64_t i = 0; i < test[index]; i++) {
+		tinymt64_generate_uint64(tiny);
+	    }
+	} else {
+	    tinymt64_jump(tiny, test[index], 0, poly_str);
+	}
+	new_tiny = *tiny;
+	tinymt64_init(&new_tiny, seed);
+	tinymt64_jump_by_table(&new_tiny, &table, test[index]);
+	tinymt64_at_block(tiny, seed, &table, test[index], block, 10);
+	for (int i = 0; i < 10; i++) {
+	    uint64_t x = tinymt64_generate_uint64(tiny);
+	    uint64_t y = tinymt64_at(tiny, seed, &table,
+				test[index] + (uint64_t)i);
+	    uint64_t z = tinymt64_generate_uint64(&new_tiny);
+	    if (x != y || x != z || x != block[i]) {
+		printf("%d[%016"PRIx64",%016"PRIx64",%016"PRIx64"]\n", i, x, y, z);
+		check |= 1;
+	    }
+	}
+	if (check == 0) {
+	    printf("OK!\n");
+	} else {
+	    printf("NG!\n");
+	    return check;
+	}
+    }
+    return 0;
+}
+
+int test_jump_matrix(tinymt64_t * tiny, const char * poly_str, uint64_t seed)
+{
+    static f2_jump_matrix matrix;
+    static f2_jump_matrix loaded;
+    f2_jump_matrix_key key;
+    f2_jump_matrix_key other;
+    f2_polynomial jump_poly;
+    tinymt64_t a[10];
+    tinymt64_t b[10];
+    uint64_t test[] = {3, 1279, UINT64_C(12157665459056928801)};
+    FILE * fp;
+
+    for (int index = 0; index < 3; index++) {
+	printf("jump by matrix %"PRIu64"\n", test[index]);
+	calculate_jump_polynomial(&jump_poly, test[index], 0, poly_str);
+	tinymt64_calculate_jump_matrix(&matrix, tiny, &jump_poly);
+	tinymt64_jump_matrix_key(&key, tiny, poly_str, test[index], 0);
+	fp = tmpfile();
+	if (fp == NULL
+	    || f2_jump_matrix_save(fp, &key, &matrix) != 0
+	    || fseek(fp, 0, SEEK_SET) != 0
+	    || f2_jump_matrix_load(fp, &key, &loaded) != 0) {
+	    printf("save and load failed\n");
+	    printf("NG!\n");
+	    return 1;
+	}
+	/* matrix of other step or other generator is rejected */
+	for (int k = 0; k < 3; k++) {
+	    other = key;
+	    if (k == 0) {
+		other.lower_step++;
+	    } else if (k == 1) {
+		other.bits = 32;
+	    } else {
+		other.mat1 ^= 1;
+	    }
+	    if (fseek(fp, 0, SEEK_SET) != 0
+		|| f2_jump_matrix_load(fp, &other, &loaded) == 0) {
+		printf("load with wrong key %d succeeded\n", k);
+		printf("NG!\n");
+		return 1;
+	    }
+	}
+	fseek(fp, 0, SEEK_SET);
+	f2_jump_matrix_load(fp, &key, &loaded);
+	fclose(fp);
+	for (int i = 0; i < 10; i++) {
+	    a[i] = *tiny;
+	    tinymt64_init(&a[i], seed + (uint64_t)i);
+	    b[i] = a[i];
+	    tinymt64_jump_by_polynomial(&a[i], &jump_poly);
+	}
+	tinymt64_jump_array_by_matrix(b, 5, &matrix);
+	tinymt64_jump_array_by_matrix(b + 5, 5, &loaded);
+	for (int i = 0; i < 10; i++) {
+	    if (check_tiny(&a[i], &b[i])) {
+		return 1;
+	    }
+	}
+    }
+    return 0;
+}
+
+/*
+ * jump by every step up to 300. Shift by 64 bits in reduction of
+ * polynomials made jump polynomials wrong for some steps, for example
+ * 193 and 194.
+ */
+int test_small_jump(tinymt64_t * tiny, const char * poly_str, uint64_t seed)
+{
+    tinymt64_t a;
+    tinymt64_t b;
+
+    printf("jump 1 to 300\n");
+    tinymt64_init(tiny, seed);
+    b = *tiny;
+    for (uint64_t step = 1; step <= 300; step++) {
+	tinymt64_generate_uint64(&b);
+	a = *tiny;
+	tinymt64_jump(&a, step, 0, poly_str);
+	/* compare outputs, the top bit of status[0] is not in the state */
+	tinymt64_t c = b;
+	for (int i = 0; i < 4; i++) {
+	    if (tinymt64_generate_uint64(&a)
+		!= tinymt64_generate_uint64(&c)) {
+		printf("jump %"PRIu64" NG!\n", step);
+		return 1;
+	    }
+	}
+    }
+    printf("OK!\n");
+    return 0;
+}
+
+/*
+ * tinymt64_at multiplies the jump polynomials in the table and jumps
+ * the state once, so it should be faster than tinymt64_jump, which
+ * calculates the jump polynomial by powering. Both loops make the same
+ * outputs, so their exclusive or should be zero.
+ */
+int test_at_speed(tinymt64_t * tiny, const char * poly_str, uint64_t seed)
+{
+    f2_jump_table table;
+    uint64_t step = UINT64_C(12157665459056928801); /* 3^40 */
+    int count = 300;
+    uint64_t sum = 0;
+    clock_t start;
+    clock_t jump_clock;
+    clock_t at_clock;
+
+    printf("speed of tinymt64_at\n");
+    calculate_jump_table(&table, poly_str);
+    start = clock();
+    for (int i = 0; i < count; i++) {
+	tinymt64_init(tiny, seed);
+	tinymt64_jump(tiny, step + (uint64_t)i, 0, poly_str);
+	sum ^= tinymt64_generate_uint64(tiny);
+    }
+    jump_clock = clock() - start;
+    start = clock();
+    for (int i = 0; i < count; i++) {
+	sum ^= tinymt64_at(tiny, seed, &table, step + (uint64_t)i);
+    }
+    at_clock = clock() - start;
+    printf("jump:%.3fms at:%.3fms\n",
+	   (double)jump_clock * 1000 / CLOCKS_PER_SEC,
+	   (double)at_clock * 1000 / CLOCKS_PER_SEC);
+    if (sum != 0 || at_clock >= jump_clock) {
+	printf("NG!\n");
+	return 1;
+    }
+    printf("OK!\n");
+    return 0;
+}
+
 int main(int argc, char * argv[]) {
     if (argc < 5) {
 	printf("usage:\n%s polynomial mat1 mat2 tmat [seed]\n", argv[0]);
@@ -140,4 +323,8 @@ int main(int argc, char * argv[]) {
     printf("tmat:%016"PRIx64"\n", tiny.tmat);
     printf("seed:%"PRIu64"\n", seed);
     test(&tiny, argv[1], seed);
+    test_random_access(&tiny, argv[1], seed);
+    test_jump_matrix(&tiny, argv[1], seed);
+    test_small_jump(&tiny, argv[1], seed);
+    test_at_speed(&tiny, argv[1], seed);
 }
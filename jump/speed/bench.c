@@ -0,0 +1,749 @@
+/**
+ * @file bench.c
+ *
+ * @brief micro benchmark of tinymt32, tinymt64 and jump functions.
+ *
+ * This program measures every tinymt32_generate_* and tinymt64_generate_*
+ * function, initialization, and jump functions, and prints results in
+ * JSON to standard output. Group "reference" is generation with
+ * tempering by branch, which was replaced by branch free tempering.
+ *
+ * Time is measured by CLOCK_MONOTONIC. Each benchmark is run once for
+ * warm up, then repeated, and minimum and median of ns per call are
+ * reported. On Linux, the process is pinned to one CPU.
+ *
+ * With -p, on Linux, hardware counters of perf_event, cycles,
+ * instructions, branches, branch misses and L1 data cache read misses,
+ * are read around the measured repeats, and per call values, IPC and
+ * branch miss rate are reported. If perf_event is not permitted, for
+ * example by kernel.perf_event_paranoid, or counters are not supported,
+ * the reason is printed to standard error and only time is reported.
+ *
+ * usage: bench [-n count] [-r repeat] [-c cpu] [-p]
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and The University of Tokyo.
+ * All rights reserved.
+ *
+ * The 3-clause BSD License is applied to this software, see
+ * LICENSE.txt
+ */
+#if defined(__linux__)
+#define _GNU_SOURCE
+#include <sched.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#else
+#define _POSIX_C_SOURCE 199309L
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <inttypes.h>
+#include "tinymt32.h"
+#include "tinymt64.h"
+#include "jump32.h"
+#include "jump64.h"
+#include "f2-dispatch.h"
+#include "fixed_jump32_sample.h"
+
+#define POLY32 "d8524022ed8dff4a8dcc50c798faba43"
+#define POLY64 "945e0ad4a30ec19432dfa9d5959e5d5d"
+#define STEP UINT64_C(12157665459056928801) /* 3^40 */
+#define MAX_REPEAT 101
+#define PERF_NUM 5
+#define JUMP_ARRAY 64
+#define FILL_SIZE 1024
+
+/**
+ * benchmark function, calls measured function count times.
+ */
+typedef void (*bench_func)(long count);
+
+/**
+ * benchmark entry
+ */
+struct BENCH_T {
+    const char * name;
+    const char * group;
+    int bytes;			/* bytes of output per call, 0 for none */
+    long scale;			/* divisor of count */
+    bench_func func;
+};
+
+static tinymt32_t tiny32;
+static tinymt64_t tiny64;
+static f2_polynomial jump_poly32;
+static f2_polynomial jump_poly64;
+static f2_jump_table jump_table32;
+static f2_jump_table jump_table64;
+static f2_jump_matrix jump_matrix32;
+static f2_jump_matrix jump_matrix64;
+static tinymt32_t jump_array32[JUMP_ARRAY];
+static tinymt64_t jump_array64[JUMP_ARRAY];
+static uint64_t fill_uint64[FILL_SIZE];
+static double fill_double[FILL_SIZE];
+static volatile uint64_t sink;
+
+/**
+ * hardware counters, PERF_NUM counters in one group.
+ * fd[0] is the group leader, fd[i] is -1 if the counter is not supported.
+ */
+struct PERF_T {
+    int enabled;
+    int fd[PERF_NUM];
+    double count[PERF_NUM];	/* per call, scaled by multiplexing */
+    int valid[PERF_NUM];
+};
+
+enum PERF_INDEX {
+    PERF_CYCLES = 0,
+    PERF_INSTRUCTIONS,
+    PERF_BRANCHES,
+    PERF_BRANCH_MISSES,
+    PERF_L1D_MISSES
+};
+
+static const char * perf_names[PERF_NUM] = {
+    "cycles", "instructions", "branches", "branch_misses", "l1d_misses"
+};
+
+static struct PERF_T perf;
+
+static double now(void);
+static void pin_cpu(int cpu);
+static void setup(void);
+static int compare_double(const void * a, const void * b);
+static void run(const struct BENCH_T * b, long count, int repeat,
+		int first);
+static void print_cpu(void);
+static void perf_open(void);
+static void perf_start(void);
+static void perf_stop(double calls);
+static void print_perf(void);
+
+/*
+ * loops of inline generation functions are written by macros, so that
+ * the functions are inlined in the loops.
+ */
+#define BENCH_GENERATE(NAME, STATE, TYPE, FUNC)		\
+    static void NAME(long count);			\
+    static void NAME(long count) {			\
+	TYPE sum = 0;					\
+	for (long i = 0; i < count; i++) {		\
+	    sum += FUNC(&STATE);			\
+	}						\
+	sink += (uint64_t)sum;				\
+    }
+
+BENCH_GENERATE(b32_uint32, tiny32, uint32_t, tinymt32_generate_uint32)
+BENCH_GENERATE(b32_float, tiny32, float, tinymt32_generate_float)
+BENCH_GENERATE(b32_float12, tiny32, float, tinymt32_generate_float12)
+BENCH_GENERATE(b32_float01, tiny32, float, tinymt32_generate_float01)
+BENCH_GENERATE(b32_floatOC, tiny32, float, tinymt32_generate_floatOC)
+BENCH_GENERATE(b32_floatOO, tiny32, float, tinymt32_generate_floatOO)
+BENCH_GENERATE(b32_32double, tiny32, double, tinymt32_generate_32double)
+BENCH_GENERATE(b32_uint64, tiny32, uint64_t, tinymt32_generate_uint64)
+BENCH_GENERATE(b32_double53, tiny32, double, tinymt32_generate_double53)
+BENCH_GENERATE(b64_uint64, tiny64, uint64_t, tinymt64_generate_uint64)
+BENCH_GENERATE(b64_double, tiny64, double, tinymt64_generate_double)
+BENCH_GENERATE(b64_double01, tiny64, double, tinymt64_generate_double01)
+BENCH_GENERATE(b64_double12, tiny64, double, tinymt64_generate_double12)
+BENCH_GENERATE(b64_doubleOC, tiny64, double, tinymt64_generate_doubleOC)
+BENCH_GENERATE(b64_doubleOO, tiny64, double, tinymt64_generate_doubleOO)
+
+/*
+ * tempering with branch, as before ver. 1.2, to compare with branch free
+ * tempering of tinymt32.h and tinymt64.h. Outputs are the same.
+ */
+static float branch32_float12(tinymt32_t * random);
+static float branch32_float12(tinymt32_t * random) {
+    uint32_t t0, t1;
+    union {
+	uint32_t u;
+	float f;
+    } conv;
+
+    tinymt32_next_state(random);
+    t0 = random->status[3];
+    t1 = random->status[0] + (random->status[2] >> TINYMT32_SH8);
+    t0 ^= t1;
+    if ((t1 & 1) != 0) {
+	conv.u  = ((t0 ^ random->tmat) >> 9) | UINT32_C(0x3f800000);
+    } else {
+	conv.u  = (t0 >> 9) | UINT32_C(0x3f800000);
+    }
+    return conv.f;
+}
+
+static double branch64_double12(tinymt64_t * random);
+static double branch64_double12(tinymt64_t * random) {
+    uint64_t x;
+    union {
+	uint64_t u;
+	double d;
+    } conv;
+
+    random->status[0] &= TINYMT64_MASK;
+    x = random->status[0] ^ random->status[1];
+    x ^= x << TINYMT64_SH0;
+    x ^= x >> 32;
+    x ^= x << 32;
+    x ^= x << TINYMT64_SH1;
+    random->status[0] = random->status[1];
+    random->status[1] = x;
+    if ((x & 1) != 0) {
+	random->status[0] ^= random->mat1;
+	random->status[1] ^= ((uint64_t)random->mat2 << 32);
+    }
+    x = random->status[0] + random->status[1];
+    x ^= random->status[0] >> TINYMT64_SH8;
+    if ((x & 1) != 0) {
+	conv.u = ((x ^ random->tmat) >> 12) | UINT64_C(0x3ff0000000000000);
+    } else {
+	conv.u = (x  >> 12) | UINT64_C(0x3ff0000000000000);
+    }
+    return conv.d;
+}
+
+BENCH_GENERATE(b32_branch_float12, tiny32, float, branch32_float12)
+BENCH_GENERATE(b64_branch_double12, tiny64, double, branch64_double12)
+
+/*
+ * bulk generation, count is the number of elements.
+ */
+static void b32_fill_uint64(long count);
+static void b32_fill_uint64(long count) {
+    uint64_t sum = 0;
+    for (long i = 0; i < count; i += FILL_SIZE) {
+	int n = count - i < FILL_SIZE ? (int)(count - i) : FILL_SIZE;
+	tinymt32_fill_uint64(&tiny32, fill_uint64, n);
+	sum += fill_uint64[n - 1];
+    }
+    sink += sum;
+}
+
+static void b32_fill_double53(long count);
+static void b32_fill_double53(long count) {
+    double sum = 0;
+    for (long i = 0; i < count; i += FILL_SIZE) {
+	int n = count - i < FILL_SIZE ? (int)(count - i) : FILL_SIZE;
+	tinymt32_fill_double53(&tiny32, fill_double, n);
+	sum += fill_double[n - 1];
+    }
+    sink += (uint64_t)sum;
+}
+
+static void b32_init(long count);
+static void b32_init(long count) {
+    for (long i = 0; i < count; i++) {
+	tinymt32_init(&tiny32, (uint32_t)i);
+    }
+    sink += tiny32.status[0];
+}
+
+static void b32_init_by_array(long count);
+static void b32_init_by_array(long count) {
+    uint32_t key[4] = {1, 2, 3, 4};
+    for (long i = 0; i < count; i++) {
+	key[0] = (uint32_t)i;
+	tinymt32_init_by_array(&tiny32, key, 4);
+    }
+    sink += tiny32.status[0];
+}
+
+static void b64_init(long count);
+static void b64_init(long count) {
+    for (long i = 0; i < count; i++) {
+	tinymt64_init(&tiny64, (uint64_t)i);
+    }
+    sink += tiny64.status[0];
+}
+
+static void b64_init_by_array(long count);
+static void b64_init_by_array(long count) {
+    uint64_t key[4] = {1, 2, 3, 4};
+    for (long i = 0; i < count; i++) {
+	key[0] = (uint64_t)i;
+	tinymt64_init_by_array(&tiny64, key, 4);
+    }
+    sink += tiny64.status[0];
+}
+
+static void b32_calc_jump_poly(long count);
+static void b32_calc_jump_poly(long count) {
+    f2_polynomial poly;
+    for (long i = 0; i < count; i++) {
+	calculate_jump_polynomial(&poly, STEP + (uint64_t)i, 0, POLY32);
+    }
+    sink += poly.ar[0];
+}
+
+static void b32_jump(long count);
+static void b32_jump(long count) {
+    for (long i = 0; i < count; i++) {
+	tinymt32_jump(&tiny32, STEP, 0, POLY32);
+    }
+    sink += tiny32.status[0];
+}
+
+static void b32_jump_by_polynomial(long count);
+static void b32_jump_by_polynomial(long count) {
+    for (long i = 0; i < count; i++) {
+	tinymt32_jump_by_polynomial(&tiny32, &jump_poly32);
+    }
+    sink += tiny32.status[0];
+}
+
+static void b32_jump_by_table(long count);
+static void b32_jump_by_table(long count) {
+    for (long i = 0; i < count; i++) {
+	tinymt32_jump_by_table(&tiny32, &jump_table32, STEP);
+    }
+    sink += tiny32.status[0];
+}
+
+static void b32_jump_by_matrix(long count);
+static void b32_jump_by_matrix(long count) {
+    for (long i = 0; i < count; i++) {
+	tinymt32_jump_by_matrix(&tiny32, &jump_matrix32);
+    }
+    sink += tiny32.status[0];
+}
+
+/* per state, JUMP_ARRAY states at a time */
+static void b32_jump_array_by_matrix(long count);
+static void b32_jump_array_by_matrix(long count) {
+    for (long i = 0; i < count; i += JUMP_ARRAY) {
+	tinymt32_jump_array_by_matrix(jump_array32, JUMP_ARRAY,
+				      &jump_matrix32);
+    }
+    sink += jump_array32[0].status[0];
+}
+
+static void b32_fixed_jump(long count);
+static void b32_fixed_jump(long count) {
+    for (long i = 0; i < count; i++) {
+	tinymt32_fixed_jump(&tiny32);
+    }
+    sink += tiny32.status[0];
+}
+
+static void b32_at(long count);
+static void b32_at(long count) {
+    uint32_t sum = 0;
+    for (long i = 0; i < count; i++) {
+	sum += tinymt32_at(&tiny32, 1234, &jump_table32,
+			   STEP + (uint64_t)i);
+    }
+    sink += sum;
+}
+
+static void b64_jump(long count);
+static void b64_jump(long count) {
+    for (long i = 0; i < count; i++) {
+	tinymt64_jump(&tiny64, STEP, 0, POLY64);
+    }
+    sink += tiny64.status[0];
+}
+
+static void b64_jump_by_polynomial(long count);
+static void b64_jump_by_polynomial(long count) {
+    for (long i = 0; i < count; i++) {
+	tinymt64_jump_by_polynomial(&tiny64, &jump_poly64);
+    }
+    sink += tiny64.status[0];
+}
+
+static void b64_jump_by_table(long count);
+static void b64_jump_by_table(long count) {
+    for (long i = 0; i < count; i++) {
+	tinymt64_jump_by_table(&tiny64, &jump_table64, STEP);
+    }
+    sink += tiny64.status[0];
+}
+
+static void b64_jump_by_matrix(long count);
+static void b64_jump_by_matrix(long count) {
+    for (long i = 0; i < count; i++) {
+	tinymt64_jump_by_matrix(&tiny64, &jump_matrix64);
+    }
+    sink += tiny64.status[0];
+}
+
+static void b64_jump_array_by_matrix(long count);
+static void b64_jump_array_by_matrix(long count) {
+    for (long i = 0; i < count; i += JUMP_ARRAY) {
+	tinymt64_jump_array_by_matrix(jump_array64, JUMP_ARRAY,
+				      &jump_matrix64);
+    }
+    sink += jump_array64[0].status[0];
+}
+
+static void b64_at(long count);
+static void b64_at(long count) {
+    uint64_t sum = 0;
+    for (long i = 0; i < count; i++) {
+	sum += tinymt64_at(&tiny64, 1234, &jump_table64,
+			   STEP + (uint64_t)i);
+    }
+    sink += sum;
+}
+
+/*
+ * scale is the ratio of generation count to call count, slow functions
+ * are called count / scale times.
+ */
+static const struct BENCH_T benches[] = {
+    {"tinymt32_generate_uint32", "generate", 4, 1, b32_uint32},
+    {"tinymt32_generate_float", "generate", 4, 1, b32_float},
+    {"tinymt32_generate_float12", "generate", 4, 1, b32_float12},
+    {"tinymt32_generate_float01", "generate", 4, 1, b32_float01},
+    {"tinymt32_generate_floatOC", "generate", 4, 1, b32_floatOC},
+    {"tinymt32_generate_floatOO", "generate", 4, 1, b32_floatOO},
+    {"tinymt32_generate_32double", "generate", 8, 1, b32_32double},
+    {"tinymt32_generate_uint64", "generate", 8, 1, b32_uint64},
+    {"tinymt32_generate_double53", "generate", 8, 1, b32_double53},
+    {"tinymt32_fill_uint64", "generate", 8, 1, b32_fill_uint64},
+    {"tinymt32_fill_double53", "generate", 8, 1, b32_fill_double53},
+    {"tinymt64_generate_uint64", "generate", 8, 1, b64_uint64},
+    {"tinymt64_generate_double", "generate", 8, 1, b64_double},
+    {"tinymt64_generate_double01", "generate", 8, 1, b64_double01},
+    {"tinymt64_generate_double12", "generate", 8, 1, b64_double12},
+    {"tinymt64_generate_doubleOC", "generate", 8, 1, b64_doubleOC},
+    {"tinymt64_generate_doubleOO", "generate", 8, 1, b64_doubleOO},
+    {"tinymt32_generate_float12_branch", "reference", 4, 1,
+     b32_branch_float12},
+    {"tinymt64_generate_double12_branch", "reference", 8, 1,
+     b64_branch_double12},
+    {"tinymt32_init", "init", 0, 100, b32_init},
+    {"tinymt32_init_by_array", "init", 0, 100, b32_init_by_array},
+    {"tinymt64_init", "init", 0, 100, b64_init},
+    {"tinymt64_init_by_array", "init", 0, 100, b64_init_by_array},
+    {"calculate_jump_polynomial", "jump", 0, 10000, b32_calc_jump_poly},
+    {"tinymt32_jump", "jump", 0, 10000, b32_jump},
+    {"tinymt32_jump_by_polynomial", "jump", 0, 1000,
+     b32_jump_by_polynomial},
+    {"tinymt32_jump_by_table", "jump", 0, 1000, b32_jump_by_table},
+    {"tinymt32_jump_by_matrix", "jump", 0, 100, b32_jump_by_matrix},
+    {"tinymt32_jump_array_by_matrix", "jump", 0, 100,
+     b32_jump_array_by_matrix},
+    {"tinymt32_fixed_jump", "jump", 0, 100, b32_fixed_jump},
+    {"tinymt32_at", "jump", 0, 10000, b32_at},
+    {"tinymt64_jump", "jump", 0, 10000, b64_jump},
+    {"tinymt64_jump_by_polynomial", "jump", 0, 1000,
+     b64_jump_by_polynomial},
+    {"tinymt64_jump_by_table", "jump", 0, 1000, b64_jump_by_table},
+    {"tinymt64_jump_by_matrix", "jump", 0, 100, b64_jump_by_matrix},
+    {"tinymt64_jump_array_by_matrix", "jump", 0, 100,
+     b64_jump_array_by_matrix},
+    {"tinymt64_at", "jump", 0, 10000, b64_at},
+};
+
+int main(int argc, char * argv[]) {
+    long count = 10000000;
+    int repeat = 11;
+    int cpu = 0;
+    int use_perf = 0;
+
+    for (int i = 1; i < argc; i++) {
+	if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+	    count = strtol(argv[++i], NULL, 10);
+	} else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+	    repeat = (int)strtol(argv[++i], NULL, 10);
+	} else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+	    cpu = (int)strtol(argv[++i], NULL, 10);
+	} else if (strcmp(argv[i], "-p") == 0) {
+	    use_perf = 1;
+	} else {
+	    fprintf(stderr,
+		    "usage:\n%s [-n count] [-r repeat] [-c cpu] [-p]\n",
+		    argv[0]);
+	    return -1;
+	}
+    }
+    if (count <= 0 || repeat <= 0 || repeat > MAX_REPEAT) {
+	fprintf(stderr, "count should be positive, "
+		"repeat should be from 1 to %d\n", MAX_REPEAT);
+	return -1;
+    }
+    pin_cpu(cpu);
+    if (use_perf) {
+	perf_open();
+    }
+    setup();
+    printf("{\n");
+#if defined(__VERSION__)
+    printf("  \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+    print_cpu();
+    printf("  \"pinned_cpu\": %d,\n", cpu);
+    printf("  \"isa\": \"%s\",\n", f2_dispatch_name(f2_dispatch_active()));
+    printf("  \"count\": %ld,\n", count);
+    printf("  \"repeat\": %d,\n", repeat);
+    printf("  \"perf\": %s,\n", perf.enabled ? "true" : "false");
+    printf("  \"results\": [\n");
+    int num = (int)(sizeof(benches) / sizeof(benches[0]));
+    for (int i = 0; i < num; i++) {
+	run(&benches[i], count, repeat, i == 0);
+    }
+    printf("\n  ],\n");
+    printf("  \"sink\": %" PRIu64 "\n", (uint64_t)sink);
+    printf("}\n");
+    return 0;
+}
+
+/**
+ * monotonic clock
+ * @return seconds
+ */
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+}
+
+/**
+ * pin this process to a cpu, only on Linux
+ * @param cpu cpu number
+ */
+static void pin_cpu(int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+	fprintf(stderr, "can't pin to cpu %d\n", cpu);
+    }
+#else
+    (void)cpu;
+#endif
+}
+
+/**
+ * initialize generators and jump data
+ */
+static void setup(void) {
+    tiny32.mat1 = 0x8f7011ee;
+    tiny32.mat2 = 0xfc78ff1f;
+    tiny32.tmat = 0x3793fdff;
+    tinymt32_init(&tiny32, 1234);
+    tiny64.mat1 = 0xfa051f40;
+    tiny64.mat2 = 0xffd0fff4;
+    tiny64.tmat = UINT64_C(0x58d02ffeffbfffbc);
+    tinymt64_init(&tiny64, 1234);
+    calculate_jump_polynomial(&jump_poly32, STEP, 0, POLY32);
+    calculate_jump_polynomial(&jump_poly64, STEP, 0, POLY64);
+    calculate_jump_table(&jump_table32, POLY32);
+    calculate_jump_table(&jump_table64, POLY64);
+    tinymt32_calculate_jump_matrix(&jump_matrix32, &tiny32, &jump_poly32);
+    tinymt64_calculate_jump_matrix(&jump_matrix64, &tiny64, &jump_poly64);
+    for (int i = 0; i < JUMP_ARRAY; i++) {
+	jump_array32[i] = tiny32;
+	jump_array64[i] = tiny64;
+	tinymt32_init(&jump_array32[i], (uint32_t)i);
+	tinymt64_init(&jump_array64[i], (uint64_t)i);
+    }
+}
+
+static int compare_double(const void * a, const void * b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * run a benchmark and print JSON object of the result
+ * @param b benchmark
+ * @param count number of generation
+ * @param repeat number of measurements
+ * @param first true for the first result
+ */
+static void run(const struct BENCH_T * b, long count, int repeat,
+		int first) {
+    double ns[MAX_REPEAT];
+    long calls = count / b->scale;
+    if (calls < 1) {
+	calls = 1;
+    }
+    /* warm up */
+    b->func(calls / 10 + 1);
+    perf_start();
+    for (int i = 0; i < repeat; i++) {
+	double start = now();
+	b->func(calls);
+	ns[i] = (now() - start) * 1.0e9 / (double)calls;
+    }
+    perf_stop((double)calls * repeat);
+    qsort(ns, (size_t)repeat, sizeof(double), compare_double);
+    if (!first) {
+	printf(",\n");
+    }
+    printf("    {\"name\": \"%s\", \"group\": \"%s\", \"calls\": %ld, "
+	   "\"ns_min\": %.3f, \"ns_median\": %.3f",
+	   b->name, b->group, calls, ns[0], ns[repeat / 2]);
+    if (b->bytes > 0) {
+	printf(", \"bytes\": %d, \"gb_per_s\": %.3f",
+	       b->bytes, (double)b->bytes / ns[0]);
+    }
+    print_perf();
+    printf("}");
+}
+
+#if defined(__linux__)
+static int perf_event_open(struct perf_event_attr * attr, int group_fd) {
+    return (int)syscall(__NR_perf_event_open, attr, 0, -1, group_fd, 0);
+}
+#endif
+
+/**
+ * open hardware counters of this process, only on Linux.
+ * If the group leader, cycles, can't be opened, counters are disabled.
+ */
+static void perf_open(void) {
+#if defined(__linux__)
+    static const struct {
+	uint32_t type;
+	uint64_t config;
+    } events[PERF_NUM] = {
+	{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+	{PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+	{PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+	{PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+	{PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D
+	 | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+	 | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)}
+    };
+    struct perf_event_attr attr;
+    for (int i = 0; i < PERF_NUM; i++) {
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = events[i].type;
+	attr.config = events[i].config;
+	attr.disabled = i == 0;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID
+	    | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	perf.fd[i] = perf_event_open(&attr, i == 0 ? -1 : perf.fd[0]);
+	if (perf.fd[i] < 0) {
+	    fprintf(stderr, "perf_event %s: %s\n", perf_names[i],
+		    strerror(errno));
+	    if (i == 0) {
+		fprintf(stderr, "hardware counters are disabled\n");
+		return;
+	    }
+	}
+    }
+    perf.enabled = 1;
+#endif
+}
+
+/**
+ * reset and start counters
+ */
+static void perf_start(void) {
+#if defined(__linux__)
+    if (!perf.enabled) {
+	return;
+    }
+    ioctl(perf.fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(perf.fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+/**
+ * stop counters and calculate counts per call.
+ * A counter which did not run is marked invalid.
+ * @param calls total number of calls
+ */
+static void perf_stop(double calls) {
+#if defined(__linux__)
+    /* nr, time_enabled, time_running, {value, id} * PERF_NUM */
+    uint64_t buf[3 + 2 * PERF_NUM];
+    uint64_t ids[PERF_NUM];
+    if (!perf.enabled) {
+	return;
+    }
+    ioctl(perf.fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    for (int i = 0; i < PERF_NUM; i++) {
+	perf.valid[i] = 0;
+	ids[i] = UINT64_MAX;
+	if (perf.fd[i] >= 0) {
+	    ioctl(perf.fd[i], PERF_EVENT_IOC_ID, &ids[i]);
+	}
+    }
+    ssize_t size = read(perf.fd[0], buf, sizeof(buf));
+    if (size < (ssize_t)(3 * sizeof(uint64_t)) || buf[2] == 0) {
+	return;
+    }
+    /* scale for multiplexing */
+    double scale = (double)buf[1] / (double)buf[2] / calls;
+    for (uint64_t j = 0; j < buf[0] && j < PERF_NUM; j++) {
+	for (int i = 0; i < PERF_NUM; i++) {
+	    if (ids[i] == buf[4 + 2 * j]) {
+		perf.count[i] = (double)buf[3 + 2 * j] * scale;
+		perf.valid[i] = 1;
+	    }
+	}
+    }
+#else
+    (void)calls;
+#endif
+}
+
+/**
+ * print counters per call, IPC and branch miss rate as JSON members
+ */
+static void print_perf(void) {
+    if (!perf.enabled) {
+	return;
+    }
+    for (int i = 0; i < PERF_NUM; i++) {
+	if (perf.valid[i]) {
+	    printf(", \"%s\": %.3f", perf_names[i], perf.count[i]);
+	}
+    }
+    if (perf.valid[PERF_CYCLES] && perf.valid[PERF_INSTRUCTIONS]
+	&& perf.count[PERF_CYCLES] > 0) {
+	printf(", \"ipc\": %.3f",
+	       perf.count[PERF_INSTRUCTIONS] / perf.count[PERF_CYCLES]);
+    }
+    if (perf.valid[PERF_BRANCHES] && perf.valid[PERF_BRANCH_MISSES]
+	&& perf.count[PERF_BRANCHES] > 0) {
+	printf(", \"branch_miss_rate\": %.5f",
+	       perf.count[PERF_BRANCH_MISSES] / perf.count[PERF_BRANCHES]);
+    }
+}
+
+/**
+ * print cpu model name, only on Linux
+ */
+static void print_cpu(void) {
+#if defined(__linux__)
+    FILE * fp = fopen("/proc/cpuinfo", "r");
+    char line[256];
+    if (fp == NULL) {
+	return;
+    }
+    while (fgets(line, sizeof(line), fp) != NULL) {
+	if (strncmp(line, "model name", 10) == 0) {
+	    char * p = strchr(line, ':');
+	    if (p != NULL) {
+		p += 2;
+		p[strcspn(p, "\n\"\\")] = '\0';
+		printf("  \"cpu\": \"%s\",\n", p);
+	    }
+	    break;
+	}
+    }
+    fclose(fp);
+#endif
+}
@@ -0,0 +1,734 @@
+/**
+ * @file stat_test.c
+ *
+ * @brief statistical smoke test of tinymt32 and tinymt64 parameter sets.
+ *
+ * This program runs a fast subset of standard statistical tests over
+ * one parameter set, without any external test battery:
+ * - chi-square test of frequency of the top 8 bits,
+ * - birthday spacings test of the top and the bottom 24 bits of pairs
+ *   of outputs,
+ * - collision test of the top 20 bits,
+ * - gap test of the top 4 bits,
+ * - binary rank test of 32x32 (tinymt32) or 64x64 (tinymt64) matrices,
+ * - linear complexity test (NIST SP800-22) of the least significant
+ *   bits in blocks of 200 bits.
+ *
+ * Outputs are streamed through the tests in buffers, by threads. Thread
+ * i uses the stream jumped i * 2<sup>64</sup> steps from the initial
+ * state, so that streams do not overlap. Statistics of threads are
+ * summed up and p-values are printed.
+ *
+ * The least significant bit of the output of TinyMT is F<sub>2</sub>
+ * linear, and its linear complexity is 127, the degree of the
+ * characteristic polynomial. Therefore the linear complexity test uses
+ * blocks shorter than 254 bits, and the linear complexity of the first
+ * 512 bits is checked to be 127.
+ *
+ * usage: stat_test 32|64 polynomial mat1 mat2 tmat [count [threads [seed]]]
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and The University of Tokyo.
+ * All rights reserved.
+ *
+ * The 3-clause BSD License is applied to this software, see
+ * LICENSE.txt
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "tinymt32.h"
+#include "tinymt64.h"
+#include "jump32.h"
+#include "jump64.h"
+
+#define BUFFER_SIZE (1 << 18)
+#define FREQ_BITS 8
+#define FREQ_BINS (1 << FREQ_BITS)
+#define BDAY_N (1 << 17)
+#define BDAY_BITS 24
+#define COLL_BALLS 16384
+#define COLL_BITS 20
+#define COLL_WORDS ((1 << COLL_BITS) / 64)
+#define GAP_BITS 4
+#define GAP_T 64
+#define LC_M 200
+#define LC_CLASSES 7
+#define LC_FULL 512
+#define LC_DEGREE 127
+#define LC_MAX_WORDS (LC_FULL / 64 + 1)
+#define RANK_CLASSES 4
+#define SUSPECT 1.0e-4
+#define FAILURE 1.0e-10
+
+/**
+ * generator of a thread, tinymt32 or tinymt64.
+ */
+struct GENERATOR_T {
+    int bits;
+    tinymt32_t tiny32;
+    tinymt64_t tiny64;
+};
+
+/**
+ * statistics of a thread.
+ */
+struct STAT_T {
+    struct GENERATOR_T gen;
+    uint64_t count;
+    uint64_t freq[FREQ_BINS];
+    uint64_t bday_hi;
+    uint64_t bday_lo;
+    uint64_t bday_reps;
+    uint64_t coll;
+    uint64_t coll_reps;
+    uint64_t gap[GAP_T + 1];
+    uint64_t gap_len;
+    uint64_t rank[RANK_CLASSES];
+    uint64_t lc[LC_CLASSES];
+    uint8_t lc_bits[LC_M];
+    int lc_pos;
+    uint64_t coll_table[COLL_WORDS];
+    uint64_t work[2][BDAY_N];
+    /** outputs, left aligned to 64 bits */
+    uint64_t buffer[BUFFER_SIZE];
+};
+
+static int failed;
+
+static void * worker(void * p);
+static void fill(struct GENERATOR_T * gen, uint64_t * buffer, int size);
+static void process(struct STAT_T * st, const uint64_t * v, int size);
+static void radix_sort48(uint64_t * a, uint64_t * tmp, int n);
+static uint64_t birthday(struct STAT_T * st, const uint64_t * v,
+			 int shift);
+static void collision(struct STAT_T * st, const uint64_t * v);
+static int rank(const uint64_t * v, int n);
+static int parity(uint64_t x);
+static int linear_complexity(const uint8_t * s, int n);
+static double igam(double a, double x);
+static double igamc(double a, double x);
+static double chi_square(const uint64_t * count, const double * prob,
+			 int size, uint64_t total, double * stat);
+static double rank_prob(int r, int n);
+static void report(const char * name, const char * stat, double p);
+static void merge(struct STAT_T * total, const struct STAT_T * st);
+static void print_results(const struct STAT_T * st, int bits,
+			  int complexity);
+
+/**
+ * thread function, streams count outputs through the tests.
+ * @param p statistics of the thread, count is set.
+ */
+static void * worker(void * p)
+{
+    struct STAT_T * st = p;
+    uint64_t remain = st->count;
+
+    while (remain > 0) {
+	int size = BUFFER_SIZE;
+	if (remain < BUFFER_SIZE) {
+	    size = (int)remain;
+	}
+	fill(&st->gen, st->buffer, size);
+	process(st, st->buffer, size);
+	remain -= (uint64_t)size;
+    }
+    return NULL;
+}
+
+/**
+ * generate outputs, 32-bit outputs are shifted to upper bits.
+ * @param gen generator
+ * @param buffer output
+ * @param size number of outputs
+ */
+static void fill(struct GENERATOR_T * gen, uint64_t * buffer, int size)
+{
+    if (gen->bits == 32) {
+	for (int i = 0; i < size; i++) {
+	    buffer[i] = (uint64_t)tinymt32_generate_uint32(&gen->tiny32) << 32;
+	}
+    } else {
+	for (int i = 0; i < size; i++) {
+	    buffer[i] = tinymt64_generate_uint64(&gen->tiny64);
+	}
+    }
+}
+
+/**
+ * feed outputs to all tests. Tests which use a fixed number of outputs
+ * use whole repetitions in the buffer only.
+ * @param st statistics
+ * @param v outputs
+ * @param size number of outputs
+ */
+static void process(struct STAT_T * st, const uint64_t * v, int size)
+{
+    const int bits = st->gen.bits;
+
+    for (int i = 0; i < size; i++) {
+	st->freq[v[i] >> (64 - FREQ_BITS)]++;
+	if ((v[i] >> (64 - GAP_BITS)) == 0) {
+	    st->gap[st->gap_len < GAP_T ? st->gap_len : GAP_T]++;
+	    st->gap_len = 0;
+	} else {
+	    st->gap_len++;
+	}
+	st->lc_bits[st->lc_pos++] = (uint8_t)((v[i] >> (64 - bits)) & 1);
+	if (st->lc_pos == LC_M) {
+	    /* T = L - mu + 2/9 for even M, mu = M/2 + 2/9 */
+	    int t = linear_complexity(st->lc_bits, LC_M) - LC_M / 2;
+	    if (t < -2) {
+		t = -3;
+	    } else if (t > 2) {
+		t = 3;
+	    }
+	    st->lc[t + 3]++;
+	    st->lc_pos = 0;
+	}
+    }
+    for (int i = 0; i + 2 * BDAY_N <= size; i += 2 * BDAY_N) {
+	st->bday_hi += birthday(st, &v[i], 64 - BDAY_BITS);
+	st->bday_lo += birthday(st, &v[i], 64 - bits);
+	st->bday_reps++;
+    }
+    for (int i = 0; i + COLL_BALLS <= size; i += COLL_BALLS) {
+	collision(st, &v[i]);
+    }
+    for (int i = 0; i + bits <= size; i += bits) {
+	int r = bits - rank(&v[i], bits);
+	st->rank[r < RANK_CLASSES - 1 ? r : RANK_CLASSES - 1]++;
+    }
+}
+
+/**
+ * LSD radix sort of 48-bit integers.
+ * @param a array to be sorted
+ * @param tmp work area of n elements
+ * @param n number of elements
+ */
+static void radix_sort48(uint64_t * a, uint64_t * tmp, int n)
+{
+    static const int digit = 12;
+    int count[1 << 12];
+
+    for (int shift = 0; shift < 48; shift += digit) {
+	memset(count, 0, sizeof(count));
+	for (int i = 0; i < n; i++) {
+	    count[(a[i] >> shift) & 0xfff]++;
+	}
+	for (int i = 0, sum = 0; i < (1 << digit); i++) {
+	    int c = count[i];
+	    count[i] = sum;
+	    sum += c;
+	}
+	for (int i = 0; i < n; i++) {
+	    tmp[count[(a[i] >> shift) & 0xfff]++] = a[i];
+	}
+	memcpy(a, tmp, sizeof(uint64_t) * (size_t)n);
+    }
+}
+
+/**
+ * birthday spacings, BDAY_N birthdays in a year of 2<sup>48</sup> days.
+ * A birthday is made of 24 bits of two outputs. The year is long, so
+ * that the bias of Poisson approximation is negligible for 10<sup>10</sup>
+ * or more outputs.
+ * @param st statistics, for work area
+ * @param v 2 * BDAY_N outputs
+ * @param shift 24 bits from bit shift of output are used
+ * @return number of duplicated spacings
+ */
+static uint64_t birthday(struct STAT_T * st, const uint64_t * v, int shift)
+{
+    uint64_t * a = st->work[0];
+    uint64_t * tmp = st->work[1];
+    const uint64_t mask = (UINT64_C(1) << BDAY_BITS) - 1;
+    uint64_t dup = 0;
+
+    for (int i = 0; i < BDAY_N; i++) {
+	a[i] = (((v[2 * i] >> shift) & mask) << BDAY_BITS)
+	    | ((v[2 * i + 1] >> shift) & mask);
+    }
+    radix_sort48(a, tmp, BDAY_N);
+    for (int i = BDAY_N - 1; i > 0; i--) {
+	a[i] -= a[i - 1];
+    }
+    radix_sort48(a, tmp, BDAY_N);
+    for (int i = 1; i < BDAY_N; i++) {
+	if (a[i] == a[i - 1]) {
+	    dup++;
+	}
+    }
+    return dup;
+}
+
+/**
+ * collision test, COLL_BALLS balls into 2<sup>20</sup> urns.
+ * @param st statistics
+ * @param v outputs
+ */
+static void collision(struct STAT_T * st, const uint64_t * v)
+{
+    memset(st->coll_table, 0, sizeof(st->coll_table));
+    for (int i = 0; i < COLL_BALLS; i++) {
+	uint64_t urn = v[i] >> (64 - COLL_BITS);
+	uint64_t bit = UINT64_C(1) << (urn & 63);
+	if (st->coll_table[urn >> 6] & bit) {
+	    st->coll++;
+	} else {
+	    st->coll_table[urn >> 6] |= bit;
+	}
+    }
+    st->coll_reps++;
+}
+
+/**
+ * rank of n x n binary matrix over F<sub>2</sub>, whose rows are upper
+ * n bits of outputs.
+ * @param v outputs
+ * @param n size of matrix, 32 or 64
+ * @return rank
+ */
+static int rank(const uint64_t * v, int n)
+{
+    uint64_t m[64];
+    int r = 0;
+
+    memcpy(m, v, sizeof(uint64_t) * (size_t)n);
+    for (int col = 63; col >= 64 - n && r < n; col--) {
+	uint64_t bit = UINT64_C(1) << col;
+	int pivot = r;
+	while (pivot < n && (m[pivot] & bit) == 0) {
+	    pivot++;
+	}
+	if (pivot == n) {
+	    continue;
+	}
+	uint64_t row = m[pivot];
+	m[pivot] = m[r];
+	m[r] = row;
+	/* without branch, bits of random matrix are unpredictable */
+	for (int i = r + 1; i < n; i++) {
+	    m[i] ^= row & (0 - ((m[i] >> col) & 1));
+	}
+	r++;
+    }
+    return r;
+}
+
+/**
+ * parity of bits
+ */
+static int parity(uint64_t x)
+{
+    x ^= x >> 32;
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    x ^= x >> 2;
+    x ^= x >> 1;
+    return (int)(x & 1);
+}
+
+/**
+ * linear complexity by Berlekamp-Massey algorithm, polynomials and
+ * the recent bits are packed in words.
+ * @param s bit sequence
+ * @param n length of sequence, n <= LC_FULL
+ * @return linear complexity
+ */
+static int linear_complexity(const uint8_t * s, int n)
+{
+    const int words = n / 64 + 1;
+    uint64_t c[LC_MAX_WORDS];
+    uint64_t b[LC_MAX_WORDS];
+    uint64_t t[LC_MAX_WORDS];
+    /* bit i of recent is s[k - i] */
+    uint64_t recent[LC_MAX_WORDS];
+    int len = 0;
+    int m = 1;
+
+    memset(c, 0, sizeof(c));
+    memset(b, 0, sizeof(b));
+    memset(recent, 0, sizeof(recent));
+    c[0] = 1;
+    b[0] = 1;
+    for (int k = 0; k < n; k++) {
+	for (int i = words - 1; i > 0; i--) {
+	    recent[i] = (recent[i] << 1) | (recent[i - 1] >> 63);
+	}
+	recent[0] = (recent[0] << 1) | s[k];
+	uint64_t d = 0;
+	for (int i = 0; i < words; i++) {
+	    d ^= c[i] & recent[i];
+	}
+	if (parity(d) == 0) {
+	    m++;
+	    continue;
+	}
+	memcpy(t, c, sizeof(uint64_t) * (size_t)words);
+	/* c ^= b << m */
+	int ws = m / 64;
+	int bs = m % 64;
+	for (int i = words - 1; i >= ws; i--) {
+	    uint64_t x = b[i - ws] << bs;
+	    if (bs != 0 && i - ws > 0) {
+		x |= b[i - ws - 1] >> (64 - bs);
+	    }
+	    c[i] ^= x;
+	}
+	if (2 * len <= k) {
+	    len = k + 1 - len;
+	    memcpy(b, t, sizeof(uint64_t) * (size_t)words);
+	    m = 1;
+	} else {
+	    m++;
+	}
+    }
+    return len;
+}
+
+/**
+ * regularized lower incomplete gamma function P(a, x).
+ */
+static double igam(double a, double x)
+{
+    if (x <= 0) {
+	return 0;
+    }
+    if (x >= a + 1) {
+	return 1.0 - igamc(a, x);
+    }
+    double term = 1.0 / a;
+    double sum = term;
+    for (int n = 1; n < 100000; n++) {
+	term *= x / (a + n);
+	sum += term;
+	if (fabs(term) < fabs(sum) * 1.0e-15) {
+	    break;
+	}
+    }
+    return sum * exp(-x + a * log(x) - lgamma(a));
+}
+
+/**
+ * regularized upper incomplete gamma function Q(a, x), by continued
+ * fraction.
+ */
+static double igamc(double a, double x)
+{
+    if (x < a + 1) {
+	return 1.0 - igam(a, x);
+    }
+    const double tiny = 1.0e-300;
+    double b = x + 1.0 - a;
+    double c = 1.0 / tiny;
+    double d = 1.0 / b;
+    double h = d;
+    for (int i = 1; i < 100000; i++) {
+	double an = -i * (i - a);
+	b += 2.0;
+	d = an * d + b;
+	if (fabs(d) < tiny) {
+	    d = tiny;
+	}
+	c = b + an / c;
+	if (fabs(c) < tiny) {
+	    c = tiny;
+	}
+	d = 1.0 / d;
+	double delta = d * c;
+	h *= delta;
+	if (fabs(delta - 1.0) < 1.0e-15) {
+	    break;
+	}
+    }
+    return exp(-x + a * log(x) - lgamma(a)) * h;
+}
+
+/**
+ * chi-square test.
+ * @param count observed counts
+ * @param prob probabilities of classes
+ * @param size number of classes
+ * @param total number of observations
+ * @param stat output, chi-square statistic
+ * @return p-value
+ */
+static double chi_square(const uint64_t * count, const double * prob,
+			 int size, uint64_t total, double * stat)
+{
+    double chi = 0;
+
+    for (int i = 0; i < size; i++) {
+	double e = prob[i] * (double)total;
+	double d = (double)count[i] - e;
+	chi += d * d / e;
+    }
+    *stat = chi;
+    return igamc((size - 1) / 2.0, chi / 2.0);
+}
+
+/**
+ * probability that rank of random n x n binary matrix is r.
+ */
+static double rank_prob(int r, int n)
+{
+    double p = ldexp(1.0, r * (2 * n - r) - n * n);
+
+    for (int i = 0; i < r; i++) {
+	double x = 1.0 - ldexp(1.0, i - n);
+	p *= x * x / (1.0 - ldexp(1.0, i - r));
+    }
+    return p;
+}
+
+/**
+ * print result of a test.
+ * @param name test name
+ * @param stat statistic
+ * @param p p-value
+ */
+static void report(const char * name, const char * stat, double p)
+{
+    const char * judge = "pass";
+
+    if (p < FAILURE || p > 1.0 - FAILURE) {
+	judge = "FAIL";
+	failed = 1;
+    } else if (p < SUSPECT || p > 1.0 - SUSPECT) {
+	judge = "suspect";
+    }
+    printf("%-24s %-36s p = %.6g %s\n", name, stat, p, judge);
+}
+
+/**
+ * add statistics of a thread to total.
+ */
+static void merge(struct STAT_T * total, const struct STAT_T * st)
+{
+    total->count += st->count;
+    for (int i = 0; i < FREQ_BINS; i++) {
+	total->freq[i] += st->freq[i];
+    }
+    total->bday_hi += st->bday_hi;
+    total->bday_lo += st->bday_lo;
+    total->bday_reps += st->bday_reps;
+    total->coll += st->coll;
+    total->coll_reps += st->coll_reps;
+    for (int i = 0; i <= GAP_T; i++) {
+	total->gap[i] += st->gap[i];
+    }
+    for (int i = 0; i < RANK_CLASSES; i++) {
+	total->rank[i] += st->rank[i];
+    }
+    for (int i = 0; i < LC_CLASSES; i++) {
+	total->lc[i] += st->lc[i];
+    }
+}
+
+/**
+ * calculate and print p-values.
+ * @param st total statistics
+ * @param bits 32 or 64
+ * @param complexity linear complexity of the first LC_FULL LSBs
+ */
+static void print_results(const struct STAT_T * st, int bits,
+			  int complexity)
+{
+    char buf[100];
+    char name[30];
+    double prob[FREQ_BINS];
+    uint64_t total;
+    double stat;
+    double p;
+
+    /* frequency */
+    for (int i = 0; i < FREQ_BINS; i++) {
+	prob[i] = 1.0 / FREQ_BINS;
+    }
+    p = chi_square(st->freq, prob, FREQ_BINS, st->count, &stat);
+    sprintf(buf, "chi2 = %.2f df = %d", stat, FREQ_BINS - 1);
+    report("frequency(top 8)", buf, p);
+
+    /* birthday spacings, Poisson of lambda = n^3 / 4m */
+    double lambda = (double)BDAY_N * BDAY_N * BDAY_N
+	/ (4.0 * ldexp(1.0, 2 * BDAY_BITS)) * (double)st->bday_reps;
+    if (st->bday_reps > 0) {
+	p = st->bday_hi == 0 ? 1.0 : igam((double)st->bday_hi, lambda);
+	sprintf(buf, "dup = %" PRIu64 " mean = %.0f", st->bday_hi, lambda);
+	report("birthday(top 24x2)", buf, p);
+	p = st->bday_lo == 0 ? 1.0 : igam((double)st->bday_lo, lambda);
+	sprintf(buf, "dup = %" PRIu64 " mean = %.0f", st->bday_lo, lambda);
+	report("birthday(bottom 24x2)", buf, p);
+    }
+
+    /* collision, normal approximation */
+    if (st->coll_reps > 0) {
+	double m = ldexp(1.0, COLL_BITS);
+	double n = COLL_BALLS;
+	double a = exp(n * log1p(-1.0 / m));
+	double b = exp(n * log1p(-2.0 / m));
+	double mean = n - m + m * a;
+	double var = m * m * a * a * expm1(n * log1p(-1.0 / ((m - 1) * (m - 1))))
+	    + m * (a - b);
+	double reps = (double)st->coll_reps;
+	double z = ((double)st->coll - reps * mean) / sqrt(reps * var);
+	p = 0.5 * erfc(z / sqrt(2.0));
+	sprintf(buf, "coll = %" PRIu64 " mean = %.0f", st->coll, reps * mean);
+	report("collision(top 20)", buf, p);
+    }
+
+    /* gap */
+    total = 0;
+    for (int i = 0; i <= GAP_T; i++) {
+	total += st->gap[i];
+    }
+    if (total > 0) {
+	double q = 1.0 - ldexp(1.0, -GAP_BITS);
+	for (int i = 0; i < GAP_T; i++) {
+	    prob[i] = (1.0 - q) * pow(q, i);
+	}
+	prob[GAP_T] = pow(q, GAP_T);
+	p = chi_square(st->gap, prob, GAP_T + 1, total, &stat);
+	sprintf(buf, "chi2 = %.2f df = %d", stat, GAP_T);
+	report("gap(top 4)", buf, p);
+    }
+
+    /* rank */
+    total = 0;
+    for (int i = 0; i < RANK_CLASSES; i++) {
+	total += st->rank[i];
+    }
+    if (total > 0) {
+	prob[RANK_CLASSES - 1] = 1.0;
+	for (int i = 0; i < RANK_CLASSES - 1; i++) {
+	    prob[i] = rank_prob(bits - i, bits);
+	    prob[RANK_CLASSES - 1] -= prob[i];
+	}
+	p = chi_square(st->rank, prob, RANK_CLASSES, total, &stat);
+	sprintf(buf, "chi2 = %.2f df = %d", stat, RANK_CLASSES - 1);
+	sprintf(name, "rank(%dx%d)", bits, bits);
+	report(name, buf, p);
+    }
+
+    /* linear complexity, NIST SP800-22 */
+    total = 0;
+    for (int i = 0; i < LC_CLASSES; i++) {
+	total += st->lc[i];
+    }
+    if (total > 0) {
+	static const double lc_prob[LC_CLASSES] = {
+	    1.0 / 96, 1.0 / 32, 1.0 / 8, 1.0 / 2, 1.0 / 4, 1.0 / 16, 1.0 / 48
+	};
+	p = chi_square(st->lc, lc_prob, LC_CLASSES, total, &stat);
+	sprintf(buf, "chi2 = %.2f df = %d", stat, LC_CLASSES - 1);
+	report("linear complexity(LSB)", buf, p);
+    }
+    printf("linear complexity of first %d LSBs = %d", LC_FULL, complexity);
+    if (complexity == LC_DEGREE) {
+	printf(" O.K.\n");
+    } else {
+	printf(" N.G. (expected %d)\n", LC_DEGREE);
+	failed = 1;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    if (argc < 6) {
+	printf("usage:\n%s 32|64 polynomial mat1 mat2 tmat "
+	       "[count [threads [seed]]]\n", argv[0]);
+	return -1;
+    }
+    int bits = (int)strtol(argv[1], NULL, 10);
+    const char * poly = argv[2];
+    uint64_t count = UINT64_C(100000000);
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    uint64_t seed = 1234;
+    struct GENERATOR_T gen;
+    uint8_t lsb[LC_FULL];
+
+    if (argc > 6) {
+	count = (uint64_t)strtod(argv[6], NULL);
+    }
+    if (argc > 7) {
+	threads = strtol(argv[7], NULL, 10);
+    }
+    if (argc > 8) {
+	seed = strtoull(argv[8], NULL, 10);
+    }
+    if ((bits != 32 && bits != 64) || strlen(poly) != 32
+	|| count == 0 || threads <= 0) {
+	printf("argument error\n");
+	return -1;
+    }
+    gen.bits = bits;
+    if (bits == 32) {
+	gen.tiny32.mat1 = (uint32_t)strtoul(argv[3], NULL, 16);
+	gen.tiny32.mat2 = (uint32_t)strtoul(argv[4], NULL, 16);
+	gen.tiny32.tmat = (uint32_t)strtoul(argv[5], NULL, 16);
+	tinymt32_init(&gen.tiny32, (uint32_t)seed);
+    } else {
+	gen.tiny64.mat1 = (uint32_t)strtoul(argv[3], NULL, 16);
+	gen.tiny64.mat2 = (uint32_t)strtoul(argv[4], NULL, 16);
+	gen.tiny64.tmat = strtoull(argv[5], NULL, 16);
+	tinymt64_init(&gen.tiny64, seed);
+    }
+    printf("tinymt%d %s %s %s %s seed = %" PRIu64 "\n",
+	   bits, poly, argv[3], argv[4], argv[5], seed);
+    printf("count = %" PRIu64 " threads = %ld\n", count, threads);
+    fflush(stdout);
+
+    /* linear complexity of LSB */
+    {
+	struct GENERATOR_T work = gen;
+	uint64_t v[LC_FULL];
+	fill(&work, v, LC_FULL);
+	for (int i = 0; i < LC_FULL; i++) {
+	    lsb[i] = (uint8_t)((v[i] >> (64 - bits)) & 1);
+	}
+    }
+
+    struct STAT_T * st = calloc((size_t)threads + 1, sizeof(struct STAT_T));
+    pthread_t * tid = calloc((size_t)threads, sizeof(pthread_t));
+    if (st == NULL || tid == NULL) {
+	printf("can't allocate memory\n");
+	return -1;
+    }
+    for (long i = 0; i < threads; i++) {
+	st[i].gen = gen;
+	st[i].count = count / (uint64_t)threads;
+	if ((uint64_t)i < count % (uint64_t)threads) {
+	    st[i].count++;
+	}
+	/* stream i starts from i * 2^64 steps */
+	if (bits == 32) {
+	    tinymt32_jump(&st[i].gen.tiny32, 0, (uint64_t)i, poly);
+	} else {
+	    tinymt64_jump(&st[i].gen.tiny64, 0, (uint64_t)i, poly);
+	}
+	if (pthread_create(&tid[i], NULL, worker, &st[i]) != 0) {
+	    printf("can't create thread\n");
+	    return -1;
+	}
+    }
+    for (long i = 0; i < threads; i++) {
+	pthread_join(tid[i], NULL);
+	merge(&st[threads], &st[i]);
+    }
+    print_results(&st[threads], bits, linear_complexity(lsb, LC_FULL));
+    free(st);
+    free(tid);
+    return failed;
+}
@@ -0,0 +1,119 @@
+#ifndef STREAM_POOL_H
+#define STREAM_POOL_H
+/**
+ * @file stream_pool.h
+ *
+ * @brief common part of stream pools of tinymt32 and tinymt64
+ *
+ * Claim of indices, check of parameters and merge of statistics do not
+ * depend on the generator. They are shared by stream_pool32.c and
+ * stream_pool64.c, which differ only in the generator type.
+ * Users should not call these functions directly.
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and University of Tokyo.
+ * All rights reserved.
+ *
+ * The 3-clause BSD License is applied to this software, see
+ * LICENSE.txt
+ */
+
+#include <stdint.h>
+
+#if !defined(__GNUC__)
+#error "stream pool needs __atomic builtin functions of gcc or clang"
+#endif
+
+/**
+ * check parameters of stream pool.
+ * Streams use stride * max_streams steps, which should be less than
+ * the period 2<sup>127</sup>-1 of tinymt32 and tinymt64.
+ * @param lower_stride lower bit of 128-bit stride
+ * @param upper_stride upper bit of 128-bit stride
+ * @param max_streams maximum number of streams
+ * @return 0 if valid, -1 if stride or max_streams is zero, or streams
+ * exceed the period.
+ */
+inline static int tinymt_stream_check(uint64_t lower_stride,
+				      uint64_t upper_stride,
+				      uint64_t max_streams)
+{
+    unsigned __int128 lo;
+    unsigned __int128 hi;
+
+    if ((lower_stride == 0 && upper_stride == 0) || max_streams == 0) {
+	return -1;
+    }
+    /* hi is stride * max_streams >> 64, and must be less than 2^63 */
+    lo = (unsigned __int128)lower_stride * max_streams;
+    hi = (unsigned __int128)upper_stride * max_streams + (lo >> 64);
+    if (hi >= (unsigned __int128)1 << 63) {
+	return -1;
+    }
+    return 0;
+}
+
+/**
+ * claim at most block consecutive indices less than max_streams.
+ * next_index never exceeds max_streams, so it does not overflow
+ * however many times claims fail.
+ * @param next_index shared next index, updated atomically
+ * @param max_streams maximum number of streams
+ * @param block number of indices to claim
+ * @param start first claimed index
+ * @param end next of the last claimed index
+ * @return 0 if success, -1 if all indices are claimed
+ */
+inline static int tinymt_stream_claim(uint64_t * next_index,
+				      uint64_t max_streams,
+				      uint64_t block,
+				      uint64_t * start,
+				      uint64_t * end)
+{
+    uint64_t s = __atomic_load_n(next_index, __ATOMIC_RELAXED);
+    uint64_t e;
+
+    do {
+	if (s >= max_streams) {
+	    return -1;
+	}
+	e = max_streams - s < block ? max_streams : s + block;
+    } while (!__atomic_compare_exchange_n(next_index, &s, e, 1,
+					  __ATOMIC_RELAXED,
+					  __ATOMIC_RELAXED));
+    *start = s;
+    *end = e;
+    return 0;
+}
+
+/**
+ * add statistics of a cursor to shared statistics.
+ * @param issued shared number of issued streams, updated atomically
+ * @param max_consumed shared maximum consumption, updated atomically
+ * @param cursor_issued number of streams issued by the cursor
+ * @param cursor_max_consumed maximum consumption reported to the cursor
+ */
+inline static void tinymt_stream_merge_stats(uint64_t * issued,
+					     uint64_t * max_consumed,
+					     uint64_t cursor_issued,
+					     uint64_t cursor_max_consumed)
+{
+    uint64_t max = __atomic_load_n(max_consumed, __ATOMIC_RELAXED);
+
+    __atomic_fetch_add(issued, cursor_issued, __ATOMIC_RELAXED);
+    while (cursor_max_consumed > max) {
+	if (__atomic_compare_exchange_n(max_consumed,
+					&max,
+					cursor_max_consumed,
+					0,
+					__ATOMIC_RELAXED,
+					__ATOMIC_RELAXED)) {
+	    break;
+	}
+    }
+}
+
+#endif
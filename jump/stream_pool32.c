@@ -0,0 +1,182 @@
+/**
+ * @file stream_pool32.c
+ *
+ * @brief non-overlapping substreams of tinymt32 for multi-thread
+ *
+ * Stream pool hands out the states jumped 0, stride, 2 * stride, ...
+ * steps from one base generator, to threads. Each thread has its own
+ * cursor, which claims TINYMT32_STREAM_BLOCK consecutive streams by one
+ * atomic operation, and makes the next stream from the previous one by
+ * the jump matrix of stride. Only the first stream of the block needs
+ * jump by polynomials.
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and University of Tokyo.
+ * All rights reserved.
+ *
+ * The 3-clause BSD License is applied to this software, see
+ * LICENSE.txt
+ */
+#include "stream_pool32.h"
+#include "stream_pool.h"
+#include "jump32.h"
+
+/**
+ * initialize stream pool.
+ * The stride should be large enough for the consumption of each stream,
+ * and stride * max_streams should be less than the period
+ * 2<sup>127</sup>-1. This function is time consuming.
+ * @param pool stream pool
+ * @param param tinymt32 structure which has parameters
+ * @param seed seed of the base generator
+ * @param poly_str string of the characteristic polynomial generated by
+ * tinymt32dc
+ * @param lower_stride lower bit of 128-bit stride
+ * @param upper_stride upper bit of 128-bit stride
+ * @param max_streams maximum number of streams
+ * @return 0 if success, -1 if stride or max_streams is zero, or
+ * stride * max_streams is not less than the period.
+ */
+int tinymt32_stream_pool_init(tinymt32_stream_pool * pool,
+			      const tinymt32_t * param,
+			      uint32_t seed,
+			      const char * poly_str,
+			      uint64_t lower_stride,
+			      uint64_t upper_stride,
+			      uint64_t max_streams)
+{
+    f2_jump_table * table = &pool->stride_table;
+
+    if (tinymt_stream_check(lower_stride, upper_stride, max_streams) != 0) {
+	return -1;
+    }
+    pool->base = *param;
+    tinymt32_init(&pool->base, seed);
+    strtopolynomial(&pool->characteristic, poly_str);
+    calculate_jump_polynomial(&table->poly[0],
+			      lower_stride, upper_stride, poly_str);
+    for (int i = 1; i < 64; i++) {
+	polynomial_power_mod(&table->poly[i],
+			     &table->poly[i - 1],
+			     2,
+			     0,
+			     &pool->characteristic);
+    }
+    tinymt32_calculate_jump_matrix(&pool->stride_matrix, param,
+				   &table->poly[0]);
+    pool->max_streams = max_streams;
+    if (upper_stride != 0) {
+	pool->stride_limit = UINT64_MAX;
+    } else {
+	pool->stride_limit = lower_stride;
+    }
+    table->base_step = pool->stride_limit;
+    pool->stride_matrix.steps = pool->stride_limit;
+    table->characteristic = pool->characteristic;
+    pool->next_index = 0;
+    pool->issued = 0;
+    pool->max_consumed = 0;
+    return 0;
+}
+
+/**
+ * get statistics of stream pool.
+ * Statistics of cursors are included after they are flushed.
+ * @param pool stream pool
+ * @param issued number of streams handed out
+ * @param max_consumed maximum consumption reported
+ */
+void tinymt32_stream_pool_stats(tinymt32_stream_pool * pool,
+				uint64_t * issued,
+				uint64_t * max_consumed)
+{
+    *issued = __atomic_load_n(&pool->issued, __ATOMIC_RELAXED);
+    *max_consumed = __atomic_load_n(&pool->max_consumed, __ATOMIC_RELAXED);
+}
+
+/**
+ * initialize cursor. A cursor should be used by one thread.
+ * @param cursor cursor
+ * @param pool stream pool
+ */
+void tinymt32_stream_cursor_init(tinymt32_stream_cursor * cursor,
+				 tinymt32_stream_pool * pool)
+{
+    cursor->pool = pool;
+    cursor->next_index = 0;
+    cursor->end_index = 0;
+    cursor->issued = 0;
+    cursor->max_consumed = 0;
+}
+
+/**
+ * get a stream which is not handed out to any other cursor.
+ * @param cursor cursor
+ * @param stream the state of the stream
+ * @param index the index of the stream, stream is the base generator
+ * jumped index * stride steps.
+ * @return 0 if success, -1 if all streams are used.
+ */
+int tinymt32_stream_acquire(tinymt32_stream_cursor * cursor,
+			    tinymt32_t * stream,
+			    uint64_t * index)
+{
+    tinymt32_stream_pool * pool = cursor->pool;
+
+    if (cursor->next_index == cursor->end_index) {
+	uint64_t start;
+	uint64_t end;
+
+	if (tinymt_stream_claim(&pool->next_index, pool->max_streams,
+				TINYMT32_STREAM_BLOCK, &start, &end) != 0) {
+	    return -1;
+	}
+	cursor->next_index = start;
+	cursor->end_index = end;
+	cursor->next = pool->base;
+	tinymt32_jump_by_table(&cursor->next, &pool->stride_table, start);
+	tinymt32_stream_cursor_flush(cursor);
+    }
+    *stream = cursor->next;
+#if defined(TINYMT_GUARD)
+    tinymt32_guard_set_limit(stream, pool->stride_limit);
+#endif
+    *index = cursor->next_index;
+    cursor->next_index++;
+    cursor->issued++;
+    if (cursor->next_index != cursor->end_index) {
+	tinymt32_jump_by_matrix(&cursor->next, &pool->stride_matrix);
+    }
+    return 0;
+}
+
+/**
+ * report consumption of a stream.
+ * The report is kept in the cursor until it is flushed.
+ * @param cursor cursor
+ * @param consumed number of outputs generated from the stream
+ */
+void tinymt32_stream_report(tinymt32_stream_cursor * cursor,
+			    uint64_t consumed)
+{
+    if (consumed > cursor->max_consumed) {
+	cursor->max_consumed = consumed;
+    }
+}
+
+/**
+ * add statistics of cursor to stream pool.
+ * This is done automatically when the cursor claims next block.
+ * @param cursor cursor
+ */
+void tinymt32_stream_cursor_flush(tinymt32_stream_cursor * cursor)
+{
+    tinymt32_stream_pool * pool = cursor->pool;
+
+    tinymt_stream_merge_stats(&pool->issued, &pool->max_consumed,
+			      cursor->issued, cursor->max_consumed);
+    cursor->issued = 0;
+}
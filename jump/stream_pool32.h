@@ -0,0 +1,91 @@
+#ifndef STREAM_POOL32_H
+#define STREAM_POOL32_H
+/**
+ * @file stream_pool32.h
+ *
+ * @brief non-overlapping substreams of tinymt32 for multi-thread
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and University of Tokyo.
+ * All rights reserved.
+ *
+ * The 3-clause BSD License is applied to this software, see
+ * LICENSE.txt
+ */
+
+#include "f2-polynomial.h"
+#include "tinymt32.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * number of streams claimed at once by a cursor.
+ */
+#define TINYMT32_STREAM_BLOCK 64
+
+/**
+ * stream pool, shared by threads.
+ * Stream i is the state of base generator jumped i * stride steps.
+ */
+struct TINYMT32_STREAM_POOL_T {
+    tinymt32_t base;
+    f2_polynomial characteristic;
+    /** jump polynomials for stride * 2<sup>i</sup> steps */
+    f2_jump_table stride_table;
+    /** jump matrix for stride steps */
+    f2_jump_matrix stride_matrix;
+    uint64_t max_streams;
+    /** limit of consumption of a stream, used if TINYMT_GUARD is defined */
+    uint64_t stride_limit;
+    /** following members are updated atomically */
+    uint64_t next_index;
+    uint64_t issued;
+    uint64_t max_consumed;
+};
+
+typedef struct TINYMT32_STREAM_POOL_T tinymt32_stream_pool;
+
+/**
+ * cursor of stream pool, owned by one thread.
+ */
+struct TINYMT32_STREAM_CURSOR_T {
+    tinymt32_stream_pool * pool;
+    /** state of the stream next_index */
+    tinymt32_t next;
+    uint64_t next_index;
+    uint64_t end_index;
+    uint64_t issued;
+    uint64_t max_consumed;
+};
+
+typedef struct TINYMT32_STREAM_CURSOR_T tinymt32_stream_cursor;
+
+int tinymt32_stream_pool_init(tinymt32_stream_pool * pool,
+			      const tinymt32_t * param,
+			      uint32_t seed,
+			      const char * poly_str,
+			      uint64_t lower_stride,
+			      uint64_t upper_stride,
+			      uint64_t max_streams);
+void tinymt32_stream_pool_stats(tinymt32_stream_pool * pool,
+				uint64_t * issued,
+				uint64_t * max_consumed);
+void tinymt32_stream_cursor_init(tinymt32_stream_cursor * cursor,
+				 tinymt32_stream_pool * pool);
+int tinymt32_stream_acquire(tinymt32_stream_cursor * cursor,
+			    tinymt32_t * stream,
+			    uint64_t * index);
+void tinymt32_stream_report(tinymt32_stream_cursor * cursor,
+			    uint64_t consumed);
+void tinymt32_stream_cursor_flush(tinymt32_stream_cursor * cursor);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
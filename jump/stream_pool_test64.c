@@ -0,0 +1,125 @@
+#include "stream_pool64.h"
+#include "jump64.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#define THREADS 4
+#define STREAMS 100000
+#define CHECK_STREAMS 300
+
+struct THREAD_ARG {
+    tinymt64_stream_pool * pool;
+    uint64_t * first;
+    unsigned char * used;
+    int count;
+};
+
+void * worker(void * p);
+
+void * worker(void * p)
+{
+    struct THREAD_ARG * arg = p;
+    tinymt64_stream_cursor cursor;
+    tinymt64_t stream;
+    uint64_t index;
+
+    tinymt64_stream_cursor_init(&cursor, arg->pool);
+    arg->count = 0;
+    while (tinymt64_stream_acquire(&cursor, &stream, &index) == 0) {
+	arg->first[index] = tinymt64_generate_uint64(&stream);
+	arg->used[index]++;
+	arg->count++;
+	tinymt64_stream_report(&cursor, index % 100 + 1);
+    }
+    tinymt64_stream_cursor_flush(&cursor);
+    return NULL;
+}
+
+int main(int argc, char * argv[]) {
+    if (argc < 5) {
+	printf("usage:\n%s polynomial mat1 mat2 tmat\n", argv[0]);
+	return -1;
+    }
+    static tinymt64_stream_pool pool;
+    static uint64_t first[STREAMS];
+    static unsigned char used[STREAMS];
+    tinymt64_t tiny;
+    tinymt64_t work;
+    f2_polynomial stride;
+    pthread_t threads[THREADS];
+    struct THREAD_ARG args[THREADS];
+    uint64_t lower = UINT64_C(12157665459056928801); /* 3^40 */
+    uint64_t issued;
+    uint64_t max_consumed;
+    int check = 0;
+
+    tiny.mat1 = (uint32_t)strtoul(argv[2], NULL, 16);
+    tiny.mat2 = (uint32_t)strtoul(argv[3], NULL, 16);
+    tiny.tmat = (uint64_t)strtoull(argv[4], NULL, 16);
+    /* stride and max_streams must be non-zero and fit in the period */
+    if (tinymt64_stream_pool_init(&pool, &tiny, 1234, argv[1], 0, 0, 1) == 0
+	|| tinymt64_stream_pool_init(&pool, &tiny, 1234, argv[1], 1, 0, 0) == 0
+	|| tinymt64_stream_pool_init(&pool, &tiny, 1234, argv[1],
+				     0, UINT64_C(1) << 63, 1) == 0
+	|| tinymt64_stream_pool_init(&pool, &tiny, 1234, argv[1],
+				     0, UINT64_C(1) << 62, 2) == 0
+	|| tinymt64_stream_pool_init(&pool, &tiny, 1234, argv[1],
+				     UINT64_MAX, UINT64_MAX >> 2,
+				     3) == 0) {
+	printf("invalid pool is accepted\n");
+	check = 1;
+    }
+    if (tinymt64_stream_pool_init(&pool, &tiny, 1234, argv[1], lower, 0,
+				  STREAMS) != 0) {
+	printf("pool is not accepted\n");
+	return 1;
+    }
+    memset(used, 0, sizeof(used));
+    for (int i = 0; i < THREADS; i++) {
+	args[i].pool = &pool;
+	args[i].first = first;
+	args[i].used = used;
+	pthread_create(&threads[i], NULL, worker, &args[i]);
+    }
+    for (int i = 0; i < THREADS; i++) {
+	pthread_join(threads[i], NULL);
+	printf("thread %d: %d streams\n", i, args[i].count);
+    }
+    for (int i = 0; i < STREAMS; i++) {
+	if (used[i] != 1) {
+	    printf("stream %d is used %d times\n", i, used[i]);
+	    check = 1;
+	}
+    }
+    /* stream i is the base jumped i * stride steps */
+    calculate_jump_polynomial(&stride, lower, 0, argv[1]);
+    work = tiny;
+    tinymt64_init(&work, 1234);
+    for (int i = 0; i < CHECK_STREAMS; i++) {
+	tinymt64_t copy = work;
+	if (tinymt64_generate_uint64(&copy) != first[i]) {
+	    printf("stream %d differs\n", i);
+	    check = 1;
+	}
+	tinymt64_jump_by_polynomial(&work, &stride);
+    }
+    /* claims after exhaustion do not move next index */
+    if (pool.next_index != STREAMS) {
+	printf("next index %"PRIu64"\n", pool.next_index);
+	check = 1;
+    }
+    tinymt64_stream_pool_stats(&pool, &issued, &max_consumed);
+    printf("issued:%"PRIu64" max consumed:%"PRIu64"\n",
+	   issued, max_consumed);
+    if (issued != STREAMS || max_consumed != 100) {
+	check = 1;
+    }
+    if (check == 0) {
+	printf("OK!\n");
+    } else {
+	printf("NG!\n");
+    }
+    return check;
+}
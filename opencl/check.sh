@@ -1,10 +1,17 @@
 #!/bin/sh
-list=('test32 tinymt32dc.0.2000.txt 10 100 100000' \
+list=('param_convert 32 tinymt32dc.0.2000.txt tinymt32dc.0.2000.bin' \
+      'param_convert 64 tinymt64dc.0.2000.txt tinymt64dc.0.2000.bin' \
+      'test32 tinymt32dc.0.2000.txt 10 100 100000' \
+      'test32 tinymt32dc.0.2000.bin 10 100 100000 interleaved soa' \
       'test32_jump 10 100 1000000' \
       'test32_jump2 10 100 1000000' \
       'test64 tinymt64dc.0.2000.txt 10 100 100000' \
+      'test64 tinymt64dc.0.2000.bin 10 100 100000 interleaved soa' \
       'test64_jump 10 100 1000000' \
-      'test64_jump2 10 100 1000000')
+      'test64_jump2 10 100 1000000' \
+      'multi32 tinymt32dc.0.2000.txt 10 100 100000' \
+      'jump_table_test 32 tinymt32dc.0.2000.txt 100 10 100' \
+      'jump_table_test 64 tinymt64dc.0.2000.txt 100 10 100')
 result=OK
 for f in "${list[@]}"; do
     g=($f)
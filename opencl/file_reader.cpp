@@ -14,6 +14,12 @@
  */
 #include <iostream>
 #include <iomanip>
+#include <cctype>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "file_reader.h"
 namespace tinymt {
     using namespace std;
@@ -70,6 +76,65 @@ namespace tinymt {
 	}
     }
 
+    /**
+     * get characteristic polynomial from prameter file.
+     * Coefficient of t<sup>i</sup> is bit i % 32 of characteristic[i / 32].
+     *@param characteristic characteristic polynomial
+     */
+    void file_reader::get_characteristic(uint32_t characteristic[4]) {
+	char buffer[bufsize];
+	ifstream ifs(filename.c_str(), ios::in);
+	if (ifs) {
+	    ifs.seekg(pos);
+	    for(;;) {
+		ifs.getline((char *)buffer, 500);
+		if (buffer[0] != '#') {
+		    break;
+		}
+	    }
+	    parse_characteristic(characteristic, buffer);
+	    pos = ifs.tellg();
+	    ifs.close();
+	} else {
+	    cerr << "filename:" << filename << endl;
+	    throw runtime_error("file not found");
+	}
+    }
+
+    /**
+     * get characteristic polynomial and parameters of the next line.
+     * Lines are read in one pass by one stream, which is kept open
+     * between calls, and the type column should be bits.
+     *@param record output, characteristic polynomial and parameters
+     *@param bits 32 or 64, expected type of parameter set
+     *@return false if no line is left
+     */
+    bool file_reader::get_record(param_record * record, int bits) {
+	char buffer[bufsize];
+	if (!stream.is_open()) {
+	    stream.open(filename.c_str(), ios::in);
+	    if (!stream) {
+		cerr << "filename:" << filename << endl;
+		throw runtime_error("file not found");
+	    }
+	}
+	for (;;) {
+	    if (!stream.getline(buffer, bufsize)) {
+		return false;
+	    }
+	    if (buffer[0] != '#' && buffer[0] != '\0') {
+		break;
+	    }
+	}
+	parse_characteristic(record->characteristic, buffer);
+	if (strtol(search_comma_next(buffer, 1), NULL, 10) != bits) {
+	    cerr << "type is not " << dec << bits << ":" << buffer << endl;
+	    throw runtime_error("type of parameter file differs");
+	}
+	get_params(&record->mat1, &record->mat2, &record->tmat, buffer);
+	return true;
+    }
+
     /**
      * constructor from filename
      *@param p_filename file name of prameter file
@@ -79,6 +144,31 @@ namespace tinymt {
 	pos = 0;
     }
 
+    /**
+     * parse characteristic polynomial at the head of line.
+     *@param characteristic output, characteristic polynomial
+     *@param buffer line of parameter file
+     */
+    void file_reader::parse_characteristic(uint32_t characteristic[4],
+					   char * buffer) {
+	errno = 0;
+	for (int i = 0; i < 4; i++) {
+	    char word[9];
+	    for (int j = 0; j < 8; j++) {
+		word[j] = buffer[8 * (3 - i) + j];
+		if (!isxdigit(word[j])) {
+		    errno = 1;
+		}
+	    }
+	    word[8] = '\0';
+	    characteristic[i] = strtoul(word, NULL, 16);
+	}
+	if (errno != 0 || buffer[32] != ',') {
+	    cerr << "file format error:" << buffer << endl;
+	    throw runtime_error("file format error");
+	}
+    }
+
     /**
      * search nth next comma in string
      *@param buffer string
@@ -173,6 +263,151 @@ namespace tinymt {
 	cout << "get_params end" << endl;
 #endif
     }
+
+    static const char param_magic[8] = {'T', 'M', 'T', 'P', 'A', 'R', 'A', 'M'};
+    static const uint32_t param_version = 2;
+    static const uint32_t param_byte_order = 0x01020304;
+
+    /**
+     * checksum of records of binary parameter file.
+     * FNV-1a hash of 32-bit words.
+     *@param records parameter records
+     *@param count number of records
+     *@return checksum
+     */
+    uint32_t param_checksum(const param_record records[], int count) {
+	const uint32_t * p = (const uint32_t *)records;
+	size_t size = count * sizeof(param_record) / sizeof(uint32_t);
+	uint32_t hash = 2166136261U;
+	for (size_t i = 0; i < size; i++) {
+	    hash = (hash ^ p[i]) * 16777619U;
+	}
+	return hash;
+    }
+
+    /**
+     * constructor, map binary parameter file and check header and
+     * checksum.
+     *@param p_filename file name of binary prameter file
+     */
+    binary_reader::binary_reader(const std::string& p_filename) {
+	int fd = open(p_filename.c_str(), O_RDONLY);
+	if (fd < 0) {
+	    cerr << "filename:" << p_filename << endl;
+	    throw runtime_error("file not found");
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0
+	    || (size_t)st.st_size < sizeof(param_header)) {
+	    close(fd);
+	    cerr << "filename:" << p_filename << endl;
+	    throw runtime_error("file format error");
+	}
+	map_size = st.st_size;
+	map = mmap(NULL, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED) {
+	    cerr << "filename:" << p_filename << endl;
+	    throw runtime_error("mmap failed");
+	}
+	header = (const param_header *)map;
+	const char * error = NULL;
+	if (memcmp(header->magic, param_magic, sizeof(param_magic)) != 0) {
+	    error = "not a binary parameter file";
+	} else if (header->byte_order != param_byte_order
+		   && header->byte_order != UINT32_C(0x04030201)) {
+	    error = "binary parameter file version error";
+	} else if (header->byte_order != param_byte_order) {
+	    error = "byte order of binary parameter file differs from host";
+	} else if (header->version != param_version
+		   || header->record_size != sizeof(param_record)) {
+	    error = "binary parameter file version error";
+	} else if (header->bits != 32 && header->bits != 64) {
+	    error = "file format error";
+	} else if (map_size != sizeof(param_header)
+		   + (size_t)header->count * sizeof(param_record)) {
+	    error = "file size error";
+	} else if (param_checksum(records(), header->count)
+		   != header->checksum) {
+	    error = "checksum error";
+	}
+	if (error != NULL) {
+	    munmap(map, map_size);
+	    cerr << "filename:" << p_filename << endl;
+	    throw runtime_error(error);
+	}
+    }
+
+    binary_reader::~binary_reader() {
+	munmap(map, map_size);
+    }
+
+    /**
+     * bits of tinymt
+     *@return 32 or 64
+     */
+    int binary_reader::bits() const {
+	return header->bits;
+    }
+
+    /**
+     * number of parameter sets
+     *@return number of records
+     */
+    int binary_reader::count() const {
+	return header->count;
+    }
+
+    /**
+     * parameter sets, valid while the reader exists
+     *@return array of records
+     */
+    const param_record * binary_reader::records() const {
+	return (const param_record *)(header + 1);
+    }
+
+    /**
+     * check magic of file
+     *@param filename file name
+     *@return true if filename is a binary parameter file
+     */
+    bool binary_reader::is_binary(const std::string& filename) {
+	char magic[sizeof(param_magic)];
+	ifstream ifs(filename.c_str(), ios::in | ios::binary);
+	if (!ifs.read(magic, sizeof(magic))) {
+	    return false;
+	}
+	return memcmp(magic, param_magic, sizeof(param_magic)) == 0;
+    }
+
+    /**
+     * write binary parameter file
+     *@param filename file name
+     *@param bits 32 or 64
+     *@param records parameter sets
+     *@param count number of records
+     */
+    void binary_reader::write(const std::string& filename,
+			      int bits,
+			      const param_record records[],
+			      int count) {
+	param_header h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, param_magic, sizeof(param_magic));
+	h.version = param_version;
+	h.bits = bits;
+	h.count = count;
+	h.record_size = sizeof(param_record);
+	h.checksum = param_checksum(records, count);
+	h.byte_order = param_byte_order;
+	ofstream ofs(filename.c_str(), ios::out | ios::binary);
+	ofs.write((const char *)&h, sizeof(h));
+	ofs.write((const char *)records, count * sizeof(param_record));
+	if (!ofs) {
+	    cerr << "filename:" << filename << endl;
+	    throw runtime_error("write error");
+	}
+    }
 }
 
 #if defined(MAIN)
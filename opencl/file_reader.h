@@ -27,21 +27,79 @@
 
 namespace tinymt {
 
+    /**
+     * parameter set in binary parameter file.
+     * tmat of tinymt32 is in lower 32 bits.
+     */
+    struct param_record {
+	uint32_t characteristic[4];
+	uint32_t mat1;
+	uint32_t mat2;
+	uint64_t tmat;
+    };
+
+    /**
+     * header of binary parameter file.
+     * param_record follows the header. The file is mapped and used
+     * without conversion, so integers are in the byte order of the host
+     * which made the file. byte_order is 0x01020304 written in that
+     * order, and the file is rejected by a host of other byte order.
+     */
+    struct param_header {
+	char magic[8];
+	uint32_t version;
+	uint32_t bits;
+	uint32_t count;
+	uint32_t record_size;
+	uint32_t checksum;
+	uint32_t byte_order;
+    };
+
     class file_reader {
     public:
 	void get(uint32_t * mat1, uint32_t * mat2, uint32_t * tmat);
 	void get(uint32_t * mat1, uint32_t * mat2, uint64_t * tmat);
+	void get_characteristic(uint32_t characteristic[4]);
+	bool get_record(param_record * record, int bits);
 	file_reader(const std::string& p_filename);
     private:
 	enum {bufsize = 500};
 	std::string filename;
 	int pos;
+	std::ifstream stream;
 	char * search_comma_next(char * buffer, int count);
+	void parse_characteristic(uint32_t characteristic[4], char * buffer);
 	void get_params(uint32_t *mat1, uint32_t *mat2, uint32_t *tmat,
 			char *buffer);
 	void get_params(uint32_t *mat1, uint32_t *mat2, uint64_t *tmat,
 			char *buffer);
     };
+
+    /**
+     * binary parameter file reader.
+     * The file is memory mapped, and records are used without parsing.
+     */
+    class binary_reader {
+    public:
+	binary_reader(const std::string& p_filename);
+	~binary_reader();
+	int bits() const;
+	int count() const;
+	const param_record * records() const;
+	static bool is_binary(const std::string& filename);
+	static void write(const std::string& filename,
+			  int bits,
+			  const param_record records[],
+			  int count);
+    private:
+	void * map;
+	size_t map_size;
+	const param_header * header;
+	binary_reader(const binary_reader&);
+	binary_reader& operator=(const binary_reader&);
+    };
+
+    uint32_t param_checksum(const param_record records[], int count);
 }
 #endif
 
@@ -0,0 +1,428 @@
+/**
+ * Test program for OpenCL
+ * jump tables calculated on device.
+ *
+ * Jump tables of parameter sets in the parameter file are calculated by
+ * tinymt_jump_table_kernel, and compared with jump polynomials calculated
+ * by calculate_jump_polynomial of jump/f2-polynomial.c.
+ * Then the last parameter set is initialized by tinymt_init_jump_kernel
+ * with its table, and the outputs are compared with tinymt32 or tinymt64
+ * on host side jumped by the same steps.
+ */
+#define CL_USE_DEPRECATED_OPENCL_1_1_APIS
+#define __CL_ENABLE_EXCEPTIONS
+
+#include <cstddef>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "opencl_tools.hpp"
+#include "tinymt32def.h"
+#include "tinymt64def.h"
+#include "tinymt32.h"
+#include "tinymt64.h"
+#include "test_common.h"
+#include "file_reader.h"
+#include "jump32.h"
+#include "jump64.h"
+#include "tinymt_jump_table.hpp"
+
+using namespace std;
+using namespace cl;
+
+/* ================== */
+/* OpenCL information */
+/* ================== */
+std::vector<cl::Platform> platforms;
+std::vector<cl::Device> devices;
+cl::Context context;
+std::string programBuffer;
+cl::Program program;
+cl::Program::Sources source;
+cl::CommandQueue queue;
+std::string errorMessage;
+
+/* ========================= */
+/* global variables          */
+/* ========================= */
+static int bits;
+static std::string filename;
+static int param_num;
+static int group_num;
+static int local_num;
+static int size = 100;
+static cl_device_type device_type = CL_DEVICE_TYPE_GPU;
+
+/* =========================
+   declaration
+   ========================= */
+static int test(int argc, char * argv[]);
+static int check_tables(const uint32_t characteristic[], Buffer& tables);
+static int check_jump32(const uint32_t characteristic[], Buffer& table);
+static int check_jump64(const uint32_t characteristic[], Buffer& table);
+static void make_poly_str(char * poly_str, const uint32_t characteristic[]);
+static bool parse_opt(int argc, char **argv);
+
+/**
+ * main
+ * catch errors
+ *@param argc number of arguments
+ *@param argv array of arguments
+ *@return 0 normal, -1 error
+ */
+int main(int argc, char * argv[])
+{
+    try {
+        return test(argc, argv);
+    } catch (Error e) {
+        cerr << "Error Code:" << e.err() << endl;
+        cerr << e.what() << endl;
+    } catch (std::string& er) {
+        cerr << er << endl;
+    } catch (...) {
+        cerr << "other error" << endl;
+    }
+    return -1;
+}
+
+/**
+ * test main
+ *@param argc number of arguments
+ *@param argv array of arguments
+ *@return 0 normal, -1 error
+ */
+static int test(int argc, char * argv[])
+{
+    if (!parse_opt(argc, argv)) {
+        return -1;
+    }
+    platforms = getPlatforms();
+    devices = getDevices(device_type);
+    context = getContext();
+    if (bits == 32) {
+        source = getSource("test32.cl");
+    } else {
+        source = getSource("test64.cl");
+    }
+    std::string option = "-DKERNEL_PROGRAM ";
+    program = getProgram(option.c_str());
+    queue = getCommandQueue();
+
+    uint32_t * characteristic = new uint32_t[4 * param_num];
+    readCharacteristics(characteristic, filename, param_num);
+    double start = getWallTime();
+    Buffer tables = makeJumpTables(context, queue, program,
+                                   characteristic, param_num, local_num);
+    double table_time = getWallTime() - start;
+    cout << "jump tables:" << dec << param_num << " "
+         << fixed << setprecision(3) << table_time * 1000 << "ms" << endl;
+    int mismatch = check_tables(characteristic, tables);
+    Buffer table = copyJumpTable(context, queue, tables, param_num - 1);
+    const uint32_t * last = &characteristic[4 * (param_num - 1)];
+    if (bits == 32) {
+        mismatch += check_jump32(last, table);
+    } else {
+        mismatch += check_jump64(last, table);
+    }
+    delete[] characteristic;
+    if (mismatch != 0) {
+        cout << "jump table check N.G!" << endl;
+        return -1;
+    }
+    cout << "jump table check O.K!" << endl;
+    return 0;
+}
+
+/**
+ * compare jump tables on device with jump polynomials on host
+ *@param characteristic characteristic polynomials
+ *@param tables jump tables made by makeJumpTables
+ *@return number of mismatches
+ */
+static int check_tables(const uint32_t characteristic[], Buffer& tables)
+{
+    int words = param_num * TINYMT_JUMP_TABLE_WORDS;
+    uint32_t * table = new uint32_t[words];
+    queue.enqueueReadBuffer(tables,
+                            CL_TRUE,
+                            0,
+                            words * sizeof(uint32_t),
+                            table);
+    int mismatch = 0;
+    char poly_str[40];
+    for (int k = 0; k < param_num; k++) {
+        make_poly_str(poly_str, &characteristic[4 * k]);
+        for (int i = 0; i < TINYMT_JUMP_TABLE_SIZE; i++) {
+            // step * 2^i
+            uint64_t lower = TINYMT_JUMP_STEP << i;
+            uint64_t upper = (i == 0) ? 0 : TINYMT_JUMP_STEP >> (64 - i);
+            f2_polynomial jump_poly;
+            calculate_jump_polynomial(&jump_poly, lower, upper, poly_str);
+            const uint32_t * p = &table[TINYMT_JUMP_TABLE_WORDS * k + 4 * i];
+            uint64_t ar0 = p[0] | ((uint64_t)p[1] << 32);
+            uint64_t ar1 = p[2] | ((uint64_t)p[3] << 32);
+            if (ar0 != jump_poly.ar[0] || ar1 != jump_poly.ar[1]) {
+                if (mismatch < 10) {
+                    cout << "mismatch param = " << dec << k
+                         << " entry = " << i << endl;
+                }
+                mismatch++;
+            }
+        }
+    }
+    delete[] table;
+    return mismatch;
+}
+
+/**
+ * generate by tinymt32 streams initialized by tinymt_init_jump_kernel,
+ * and compare with host side tinymt32 jumped by step from previous stream
+ *@param characteristic characteristic polynomial of the parameter set
+ *@param table jump table of the parameter set
+ *@return number of mismatches
+ */
+static int check_jump32(const uint32_t characteristic[], Buffer& table)
+{
+    tinymt::file_reader fr(filename);
+    uint32_t mat1;
+    uint32_t mat2;
+    uint32_t tmat;
+    for (int i = 0; i < param_num; i++) {
+        fr.get(&mat1, &mat2, &tmat);
+    }
+    int total_num = group_num * local_num;
+    tinymt32wp_t * params = new tinymt32wp_t[total_num];
+    for (int i = 0; i < total_num; i++) {
+        params[i].mat1 = mat1;
+        params[i].mat2 = mat2;
+        params[i].tmat = tmat;
+    }
+    Buffer status(context,
+                  CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+                  total_num * sizeof(tinymt32wp_t),
+                  params);
+    Buffer output_buffer(context,
+                         CL_MEM_READ_WRITE,
+                         total_num * size * sizeof(uint32_t));
+    uint32_t seed = 1234;
+    Kernel init_kernel(program, "tinymt_init_jump_kernel");
+    init_kernel.setArg(0, status);
+    init_kernel.setArg(1, table);
+    init_kernel.setArg(2, seed);
+    queue.enqueueNDRangeKernel(init_kernel,
+                               NullRange,
+                               NDRange(total_num),
+                               NDRange(local_num));
+    Kernel uint_kernel(program, "tinymt_uint32_kernel");
+    uint_kernel.setArg(0, status);
+    uint_kernel.setArg(1, output_buffer);
+    uint_kernel.setArg(2, size);
+    uint_kernel.setArg(3, (int)TINYMT_LAYOUT_INTERLEAVED);
+    queue.enqueueNDRangeKernel(uint_kernel,
+                               NullRange,
+                               NDRange(total_num),
+                               NDRange(local_num));
+    uint32_t * output = new uint32_t[total_num * size];
+    queue.enqueueReadBuffer(output_buffer,
+                            CL_TRUE,
+                            0,
+                            total_num * size * sizeof(uint32_t),
+                            output);
+    tinymt_output_view<uint32_t> view(output, total_num, size,
+                                      TINYMT_LAYOUT_INTERLEAVED);
+    char poly_str[40];
+    make_poly_str(poly_str, characteristic);
+    tinymt32_t tiny;
+    tiny.mat1 = mat1;
+    tiny.mat2 = mat2;
+    tiny.tmat = tmat;
+    tinymt32_init(&tiny, seed);
+    int mismatch = 0;
+    for (int id = 0; id < total_num; id++) {
+        tinymt32_t work = tiny;
+        for (int i = 0; i < size; i++) {
+            uint32_t r = tinymt32_generate_uint32(&work);
+            if (view(id, i) != r) {
+                if (mismatch < 10) {
+                    cout << "mismatch id = " << dec << id
+                         << " index = " << i
+                         << " device = " << hex << view(id, i)
+                         << " host = " << r << endl;
+                }
+                mismatch++;
+            }
+        }
+        tinymt32_jump(&tiny, TINYMT_JUMP_STEP, 0, poly_str);
+    }
+    delete[] params;
+    delete[] output;
+    return mismatch;
+}
+
+/**
+ * generate by tinymt64 streams initialized by tinymt_init_jump_kernel,
+ * and compare with host side tinymt64 jumped by step from previous stream
+ *@param characteristic characteristic polynomial of the parameter set
+ *@param table jump table of the parameter set
+ *@return number of mismatches
+ */
+static int check_jump64(const uint32_t characteristic[], Buffer& table)
+{
+    tinymt::file_reader fr(filename);
+    uint32_t mat1;
+    uint32_t mat2;
+    uint64_t tmat;
+    for (int i = 0; i < param_num; i++) {
+        fr.get(&mat1, &mat2, &tmat);
+    }
+    int total_num = group_num * local_num;
+    tinymt64wp_t * params = new tinymt64wp_t[total_num];
+    for (int i = 0; i < total_num; i++) {
+        params[i].mat1 = mat1;
+        params[i].mat2 = mat2;
+        params[i].tmat = tmat;
+    }
+    Buffer status(context,
+                  CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+                  total_num * sizeof(tinymt64wp_t),
+                  params);
+    Buffer output_buffer(context,
+                         CL_MEM_READ_WRITE,
+                         total_num * size * sizeof(uint64_t));
+    uint64_t seed = 1234;
+    Kernel init_kernel(program, "tinymt_init_jump_kernel");
+    init_kernel.setArg(0, status);
+    init_kernel.setArg(1, table);
+    init_kernel.setArg(2, seed);
+    queue.enqueueNDRangeKernel(init_kernel,
+                               NullRange,
+                               NDRange(total_num),
+                               NDRange(local_num));
+    Kernel uint_kernel(program, "tinymt_uint64_kernel");
+    uint_kernel.setArg(0, status);
+    uint_kernel.setArg(1, output_buffer);
+    uint_kernel.setArg(2, size);
+    uint_kernel.setArg(3, (int)TINYMT_LAYOUT_INTERLEAVED);
+    queue.enqueueNDRangeKernel(uint_kernel,
+                               NullRange,
+                               NDRange(total_num),
+                               NDRange(local_num));
+    uint64_t * output = new uint64_t[total_num * size];
+    queue.enqueueReadBuffer(output_buffer,
+                            CL_TRUE,
+                            0,
+                            total_num * size * sizeof(uint64_t),
+                            output);
+    tinymt_output_view<uint64_t> view(output, total_num, size,
+                                      TINYMT_LAYOUT_INTERLEAVED);
+    char poly_str[40];
+    make_poly_str(poly_str, characteristic);
+    tinymt64_t tiny;
+    tiny.mat1 = mat1;
+    tiny.mat2 = mat2;
+    tiny.tmat = tmat;
+    tinymt64_init(&tiny, seed);
+    int mismatch = 0;
+    for (int id = 0; id < total_num; id++) {
+        tinymt64_t work = tiny;
+        for (int i = 0; i < size; i++) {
+            uint64_t r = tinymt64_generate_uint64(&work);
+            if (view(id, i) != r) {
+                if (mismatch < 10) {
+                    cout << "mismatch id = " << dec << id
+                         << " index = " << i
+                         << " device = " << hex << view(id, i)
+                         << " host = " << r << endl;
+                }
+                mismatch++;
+            }
+        }
+        tinymt64_jump(&tiny, TINYMT_JUMP_STEP, 0, poly_str);
+    }
+    delete[] params;
+    delete[] output;
+    return mismatch;
+}
+
+/**
+ * make string of characteristic polynomial for jump functions on host
+ *@param poly_str output, at least 33 characters
+ *@param characteristic characteristic polynomial
+ */
+static void make_poly_str(char * poly_str, const uint32_t characteristic[])
+{
+    sprintf(poly_str, "%08" PRIx32 "%08" PRIx32 "%08" PRIx32 "%08" PRIx32,
+            characteristic[3], characteristic[2],
+            characteristic[1], characteristic[0]);
+}
+
+/**
+ * parsing command line options
+ *@param argc number of arguments
+ *@param argv array of argument strings
+ *@return true if no errors are found in command line arguments
+ */
+static bool parse_opt(int argc, char **argv)
+{
+    bool error = false;
+    std::string pgm = argv[0];
+    errno = 0;
+    if (argc <= 5) {
+        error = true;
+    }
+    while (!error) {
+        bits = strtol(argv[1], NULL, 10);
+        filename = argv[2];
+        param_num = strtol(argv[3], NULL, 10);
+        group_num = strtol(argv[4], NULL, 10);
+        local_num = strtol(argv[5], NULL, 10);
+        if (errno || param_num <= 0 || group_num <= 0 || local_num <= 0) {
+            error = true;
+            cerr << "number error!" << endl;
+            break;
+        }
+        if (bits != 32 && bits != 64) {
+            error = true;
+            cerr << "bits should be 32 or 64!" << endl;
+            break;
+        }
+        if (argc > 6) {
+            std::string type = argv[6];
+            if (type == "cpu") {
+                device_type = CL_DEVICE_TYPE_CPU;
+            } else if (type != "gpu") {
+                error = true;
+                cerr << "device type error!" << endl;
+                break;
+            }
+        }
+        ifstream ifs(filename.c_str());
+        if (!ifs) {
+            error = true;
+            cerr << "can't open file:" << filename << endl;
+            break;
+        }
+        break;
+    }
+    if (error) {
+        cerr << pgm
+             << " 32|64 paramfile param-num group-num local-num [cpu|gpu]"
+             << endl;
+        cerr << "32|64       tinymt32 or tinymt64." << endl;
+        cerr << "paramfile   parameter file of tinymt." << endl;
+        cerr << "param-num   number of parameter sets for jump tables."
+             << endl;
+        cerr << "group-num   group number of kernel call of jump test."
+             << endl;
+        cerr << "local-num   local item number of kernel calls." << endl;
+        cerr << "cpu|gpu     device type, default is gpu." << endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,300 @@
+/**
+ * Benchmark program for OpenCL
+ * comparing interleaved and blocked output layout.
+ *
+ * For each layout, this program measures the time of tinymt_uint32_kernel
+ * in test32_jump.cl, and the time of host side consumption of the output,
+ * which reads outputs of each work item as one stream through
+ * tinymt_output_view.
+ * CPU device, for example POCL, can be selected by command line.
+ */
+#define CL_USE_DEPRECATED_OPENCL_1_1_APIS
+#define __CL_ENABLE_EXCEPTIONS
+
+#include <cstddef>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <ctime>
+#include <errno.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "opencl_tools.hpp"
+#include "tinymt32def.h"
+#include "test_common.h"
+
+using namespace std;
+using namespace cl;
+
+/* ================== */
+/* OpenCL information */
+/* ================== */
+std::vector<cl::Platform> platforms;
+std::vector<cl::Device> devices;
+cl::Context context;
+std::string programBuffer;
+cl::Program program;
+cl::Program::Sources source;
+cl::CommandQueue queue;
+std::string errorMessage;
+
+/* ========================= */
+/* global variables          */
+/* ========================= */
+static int group_num;
+static int local_num;
+static int data_count;
+static int repeat = 10;
+static cl_device_type device_type = CL_DEVICE_TYPE_GPU;
+
+/* =========================
+   declaration
+   ========================= */
+static int bench(int argc, char * argv[]);
+static void initialize_by_seed(Buffer& status_buffer,
+                               int total_num,
+                               int local_num,
+                               uint32_t seed);
+static void bench_layout(Buffer& status_buffer,
+                         int total_num,
+                         int local_num,
+                         int data_size,
+                         int layout);
+static uint32_t consume(const uint32_t * data,
+                        int total_num,
+                        int size,
+                        int layout);
+static bool parse_opt(int argc, char **argv);
+
+/**
+ * main
+ * catch errors
+ *@param argc number of arguments
+ *@param argv array of arguments
+ *@return 0 normal, -1 error
+ */
+int main(int argc, char * argv[])
+{
+    try {
+        return bench(argc, argv);
+    } catch (Error e) {
+        cerr << "Error Code:" << e.err() << endl;
+        cerr << e.what() << endl;
+    } catch (std::string& er) {
+        cerr << er << endl;
+    } catch (...) {
+        cerr << "other error" << endl;
+    }
+    return -1;
+}
+
+/**
+ * benchmark main
+ *@param argc number of arguments
+ *@param argv array of arguments
+ *@return 0 normal, -1 error
+ */
+static int bench(int argc, char * argv[])
+{
+    if (!parse_opt(argc, argv)) {
+        return -1;
+    }
+    platforms = getPlatforms();
+    devices = getDevices(device_type);
+    context = getContext();
+    source = getSource("test32_jump.cl");
+    std::string option = "-DKERNEL_PROGRAM ";
+    program = getProgram(option.c_str());
+    queue = getCommandQueue();
+    int total_num = group_num * local_num;
+    int data_size = data_count;
+    if (data_size % total_num != 0) {
+        data_size = (data_size / total_num + 1) * total_num;
+    }
+    cout << "device:" << devices[0].getInfo<CL_DEVICE_NAME>() << endl;
+    cout << "work items:" << dec << total_num
+         << " outputs per item:" << (data_size / total_num)
+         << " repeat:" << repeat << endl;
+    Buffer status_buffer(context,
+                         CL_MEM_READ_WRITE,
+                         total_num * sizeof(tinymt32j_t));
+    initialize_by_seed(status_buffer, total_num, local_num, 1234);
+    bench_layout(status_buffer, total_num, local_num, data_size,
+                 TINYMT_LAYOUT_INTERLEAVED);
+    bench_layout(status_buffer, total_num, local_num, data_size,
+                 TINYMT_LAYOUT_BLOCKED);
+    return 0;
+}
+
+/**
+ * initialize tinymt status in device global memory
+ *@param status_buffer internal state of kernel side tinymt
+ *@param total_num total number of work items
+ *@param local_num number of local work items
+ *@param seed seed for initialization
+ */
+static void initialize_by_seed(Buffer& status_buffer,
+                               int total_num,
+                               int local_num,
+                               uint32_t seed)
+{
+    Kernel init_kernel(program, "tinymt_init_seed_kernel");
+    init_kernel.setArg(0, status_buffer);
+    init_kernel.setArg(1, seed);
+    NDRange global(total_num);
+    NDRange local(local_num);
+    Event event;
+    queue.enqueueNDRangeKernel(init_kernel,
+                               NullRange,
+                               global,
+                               local,
+                               NULL,
+                               &event);
+    event.wait();
+}
+
+/**
+ * measure generation and host side consumption for a layout
+ *@param status_buffer internal state of kernel side tinymt
+ *@param total_num total number of work items
+ *@param local_num number of local work items
+ *@param data_size number of data to generate by one kernel call
+ *@param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
+ */
+static void bench_layout(Buffer& status_buffer,
+                         int total_num,
+                         int local_num,
+                         int data_size,
+                         int layout)
+{
+    Kernel uint_kernel(program, "tinymt_uint32_kernel");
+    Buffer output_buffer(context,
+                         CL_MEM_READ_WRITE,
+                         data_size * sizeof(uint32_t));
+    uint_kernel.setArg(0, status_buffer);
+    uint_kernel.setArg(1, output_buffer);
+    uint_kernel.setArg(2, data_size / total_num);
+    uint_kernel.setArg(3, layout);
+    NDRange global(total_num);
+    NDRange local(local_num);
+    uint32_t * output = new uint32_t[data_size];
+    double kernel_time = 0;
+    double host_time = 0;
+    uint32_t sum = 0;
+    for (int i = 0; i < repeat; i++) {
+        Event generate_event;
+        queue.enqueueNDRangeKernel(uint_kernel,
+                                   NullRange,
+                                   global,
+                                   local,
+                                   NULL,
+                                   &generate_event);
+        kernel_time += get_time(generate_event);
+        queue.enqueueReadBuffer(output_buffer,
+                                CL_TRUE,
+                                0,
+                                data_size * sizeof(uint32_t),
+                                output);
+        clock_t start = clock();
+        sum ^= consume(output, total_num, data_size / total_num, layout);
+        host_time += (double)(clock() - start) / CLOCKS_PER_SEC;
+    }
+    delete[] output;
+    double total = (double)data_size * repeat;
+    cout << setw(12) << left << layout_name(layout)
+         << " kernel:" << fixed << setprecision(3)
+         << kernel_time * 1000 << "ms "
+         << total / kernel_time * 1.0e-6 << "M/s"
+         << " host consume:" << host_time * 1000 << "ms "
+         << total / host_time * 1.0e-6 << "M/s"
+         << " (" << hex << sum << dec << ")" << endl;
+}
+
+/**
+ * consume outputs of each work item as one stream.
+ *@param data output copied from device
+ *@param total_num total number of work items
+ *@param size number of outputs of a work item
+ *@param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
+ *@return checksum
+ */
+static uint32_t consume(const uint32_t * data,
+                        int total_num,
+                        int size,
+                        int layout)
+{
+    tinymt_output_view<uint32_t> view(data, total_num, size, layout);
+    int stride = view.stride();
+    uint32_t sum = 0;
+    for (int id = 0; id < total_num; id++) {
+        const uint32_t * p = view.stream(id);
+        uint32_t x = 0;
+        for (int i = 0; i < size; i++) {
+            x ^= p[i * stride];
+        }
+        sum += x;
+    }
+    return sum;
+}
+
+/**
+ * parsing command line options
+ *@param argc number of arguments
+ *@param argv array of argument strings
+ *@return true if no errors are found in command line arguments
+ */
+static bool parse_opt(int argc, char **argv)
+{
+    bool error = false;
+    std::string pgm = argv[0];
+    errno = 0;
+    if (argc <= 3) {
+        error = true;
+    }
+    while (!error) {
+        group_num = strtol(argv[1], NULL, 10);
+        local_num = strtol(argv[2], NULL, 10);
+        data_count = strtol(argv[3], NULL, 10);
+        if (errno || group_num <= 0 || local_num <= 0 || data_count <= 0) {
+            error = true;
+            cerr << "number error!" << endl;
+            break;
+        }
+        if (argc > 4) {
+            std::string type = argv[4];
+            if (type == "cpu") {
+                device_type = CL_DEVICE_TYPE_CPU;
+            } else if (type == "gpu") {
+                device_type = CL_DEVICE_TYPE_GPU;
+            } else {
+                error = true;
+                cerr << "device type error!" << endl;
+                break;
+            }
+        }
+        if (argc > 5) {
+            repeat = strtol(argv[5], NULL, 10);
+            if (errno || repeat <= 0) {
+                error = true;
+                cerr << "repeat error!" << endl;
+                break;
+            }
+        }
+        break;
+    }
+    if (error) {
+        cerr << pgm
+             << " group-num local-num data-count [cpu|gpu] [repeat]" << endl;
+        cerr << "group-num   group number of kernel call." << endl;
+        cerr << "local-num   local item number of kernel cal." << endl;
+        cerr << "data-count  generate random number count." << endl;
+        cerr << "cpu|gpu     device type, cpu for POCL. default is gpu."
+             << endl;
+        cerr << "repeat      number of kernel calls for each layout."
+             << endl;
+        return false;
+    }
+    return true;
+}
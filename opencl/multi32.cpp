@@ -0,0 +1,335 @@
+/**
+ * Test program for OpenCL
+ * generation by multiple devices.
+ *
+ * Work groups are split among all devices of the platform by splitGroups,
+ * and each device uses the range of parameter sets and seeds of its own
+ * work items. Output of each device is written into one host buffer by
+ * rectangular read, and the combined output is compared with the output
+ * of one device with the same total number of work items.
+ */
+#define CL_USE_DEPRECATED_OPENCL_1_1_APIS
+#define __CL_ENABLE_EXCEPTIONS
+
+#include <cstddef>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <errno.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "opencl_tools.hpp"
+#include "tinymt32def.h"
+#include "test_common.h"
+#include "file_reader.h"
+
+using namespace std;
+using namespace cl;
+
+/* ================== */
+/* OpenCL information */
+/* ================== */
+std::vector<cl::Platform> platforms;
+std::vector<cl::Device> devices;
+cl::Context context;
+std::string programBuffer;
+cl::Program program;
+cl::Program::Sources source;
+cl::CommandQueue queue;
+std::string errorMessage;
+
+/* =========================
+   declaration
+   ========================= */
+static std::string filename;
+static int group_num;
+static int local_num;
+static int data_count;
+static cl_device_type device_type = CL_DEVICE_TYPE_GPU;
+
+/**
+ * buffers and events of the part of work items on a device
+ */
+struct part_t {
+    Buffer status;
+    Buffer output;
+    Event read_event;
+};
+
+static bool parse_opt(int argc, char **argv);
+static void read_params(tinymt32wp_t params[], int total_num);
+static void generate_part(CommandQueue& q,
+                          part_t& part,
+                          const tinymt32wp_t params[],
+                          int first_item,
+                          int item_num,
+                          int total_num,
+                          int size,
+                          uint32_t seed,
+                          uint32_t output[]);
+static int test(int argc, char * argv[]);
+
+/**
+ * main
+ * catch errors
+ *@param argc number of arguments
+ *@param argv array of arguments
+ *@return 0 normal, -1 error
+ */
+int main(int argc, char * argv[])
+{
+    try {
+        return test(argc, argv);
+    } catch (Error e) {
+        cerr << "Error Code:" << e.err() << endl;
+        cerr << e.what() << endl;
+    } catch (std::string& er) {
+        cerr << er << endl;
+    } catch (...) {
+        cerr << "other error" << endl;
+    }
+    return -1;
+}
+
+/**
+ * test main
+ *@param argc number of arguments
+ *@param argv array of arguments
+ *@return 0 normal, -1 error
+ */
+static int test(int argc, char * argv[])
+{
+    if (!parse_opt(argc, argv)) {
+        return -1;
+    }
+    platforms = getPlatforms();
+    devices = getDevices(device_type);
+    context = getContext();
+    source = getSource("test32.cl");
+    std::string option = "-DKERNEL_PROGRAM ";
+    program = getProgram(option.c_str());
+    queue = getCommandQueue();
+    std::vector<CommandQueue> queues = getCommandQueues();
+    int device_num = devices.size();
+    int total_num = group_num * local_num;
+    int size = (data_count + total_num - 1) / total_num;
+    int data_size = total_num * size;
+    cout << "devices:" << dec << device_num << endl;
+
+    tinymt32wp_t * params = new tinymt32wp_t[total_num];
+    read_params(params, total_num);
+    uint32_t * single = new uint32_t[data_size];
+    uint32_t * multi = new uint32_t[data_size];
+
+    // one device
+    double start = getWallTime();
+    part_t whole;
+    generate_part(queue, whole, params, 0, total_num, total_num, size,
+                  1234, single);
+    whole.read_event.wait();
+    double single_time = getWallTime() - start;
+
+    // all devices
+    start = getWallTime();
+    std::vector<int> first = splitGroups(group_num, device_num);
+    std::vector<part_t> parts(device_num);
+    for (int d = 0; d < device_num; d++) {
+        int first_item = first[d] * local_num;
+        int item_num = (first[d + 1] - first[d]) * local_num;
+        if (item_num == 0) {
+            continue;
+        }
+        generate_part(queues[d], parts[d], params, first_item, item_num,
+                      total_num, size, 1234, multi);
+    }
+    for (int d = 0; d < device_num; d++) {
+        if (first[d + 1] > first[d]) {
+            parts[d].read_event.wait();
+        }
+    }
+    double multi_time = getWallTime() - start;
+
+    int mismatch = 0;
+    for (int i = 0; i < data_size; i++) {
+        if (single[i] != multi[i]) {
+            if (mismatch < 10) {
+                cout << "mismatch i = " << dec << i
+                     << " single = " << hex << single[i]
+                     << " multi = " << hex << multi[i] << endl;
+            }
+            mismatch++;
+        }
+    }
+    cout << "single device:" << fixed << setprecision(3)
+         << single_time * 1000 << "ms" << endl;
+    cout << "multi device: " << multi_time * 1000 << "ms" << endl;
+    delete[] params;
+    delete[] single;
+    delete[] multi;
+    if (mismatch != 0) {
+        cout << "multi device check N.G!" << endl;
+        throw cl::Error(-1, "tinymt32 multi device error!");
+    }
+    cout << "multi device check O.K!" << endl;
+    return 0;
+}
+
+/**
+ * read parameters of all work items
+ *@param params output
+ *@param total_num total number of work items
+ */
+static void read_params(tinymt32wp_t params[], int total_num)
+{
+    tinymt::file_reader fr(filename);
+    uint32_t mat1;
+    uint32_t mat2;
+    uint32_t tmat;
+    for (int i = 0; i < total_num; i++) {
+        fr.get(&mat1, &mat2, &tmat);
+        params[i].mat1 = mat1;
+        params[i].mat2 = mat2;
+        params[i].tmat = tmat;
+    }
+}
+
+/**
+ * initialize and generate on a device for work items from first_item
+ * to first_item + item_num - 1, and read the output into the part of
+ * host buffer. The output is in interleaved layout of total_num work
+ * items, then the read is rectangular.
+ * This function does not wait for the read.
+ *@param q command queue of the device
+ *@param part buffers and events of the part
+ *@param params parameters of all work items
+ *@param first_item first work item of the part
+ *@param item_num number of work items of the part
+ *@param total_num total number of work items of all devices
+ *@param size number of outputs of a work item
+ *@param seed seed for the first work item of all devices
+ *@param output host buffer for all devices
+ */
+static void generate_part(CommandQueue& q,
+                          part_t& part,
+                          const tinymt32wp_t params[],
+                          int first_item,
+                          int item_num,
+                          int total_num,
+                          int size,
+                          uint32_t seed,
+                          uint32_t output[])
+{
+    part.status = Buffer(context,
+                         CL_MEM_READ_WRITE,
+                         item_num * sizeof(tinymt32wp_t));
+    part.output = Buffer(context,
+                         CL_MEM_READ_WRITE,
+                         item_num * size * sizeof(uint32_t));
+    q.enqueueWriteBuffer(part.status,
+                         CL_FALSE,
+                         0,
+                         item_num * sizeof(tinymt32wp_t),
+                         &params[first_item]);
+    // tinymt_init_seed_kernel uses seed + id, id is local to the device.
+    Kernel init_kernel(program, "tinymt_init_seed_kernel");
+    init_kernel.setArg(0, part.status);
+    init_kernel.setArg(1, seed + first_item);
+    q.enqueueNDRangeKernel(init_kernel,
+                           NullRange,
+                           NDRange(item_num),
+                           NDRange(local_num));
+    Kernel uint_kernel(program, "tinymt_uint32_kernel");
+    uint_kernel.setArg(0, part.status);
+    uint_kernel.setArg(1, part.output);
+    uint_kernel.setArg(2, size);
+    uint_kernel.setArg(3, (int)TINYMT_LAYOUT_INTERLEAVED);
+    q.enqueueNDRangeKernel(uint_kernel,
+                           NullRange,
+                           NDRange(item_num),
+                           NDRange(local_num));
+    // row i of the part is output i of item_num work items,
+    // which is at total_num * i + first_item of host buffer.
+    cl::size_t<3> buffer_origin;
+    cl::size_t<3> host_origin;
+    cl::size_t<3> region;
+    buffer_origin[0] = 0;
+    buffer_origin[1] = 0;
+    buffer_origin[2] = 0;
+    host_origin[0] = first_item * sizeof(uint32_t);
+    host_origin[1] = 0;
+    host_origin[2] = 0;
+    region[0] = item_num * sizeof(uint32_t);
+    region[1] = size;
+    region[2] = 1;
+    q.enqueueReadBufferRect(part.output,
+                            CL_FALSE,
+                            buffer_origin,
+                            host_origin,
+                            region,
+                            item_num * sizeof(uint32_t),
+                            0,
+                            total_num * sizeof(uint32_t),
+                            0,
+                            output,
+                            NULL,
+                            &part.read_event);
+    q.flush();
+}
+
+/**
+ * parsing command line options
+ *@param argc number of arguments
+ *@param argv array of argument strings
+ *@return true if no errors are found in command line arguments
+ */
+static bool parse_opt(int argc, char **argv)
+{
+    bool error = false;
+    std::string pgm = argv[0];
+    errno = 0;
+    if (argc <= 4) {
+        error = true;
+    }
+    while (!error) {
+        filename = argv[1];
+        group_num = strtol(argv[2], NULL, 10);
+        local_num = strtol(argv[3], NULL, 10);
+        data_count = strtol(argv[4], NULL, 10);
+        if (errno || group_num <= 0 || local_num <= 0 || data_count <= 0) {
+            error = true;
+            cerr << "number error!" << endl;
+            break;
+        }
+        if (argc > 5) {
+            std::string type = argv[5];
+            if (type == "cpu") {
+                device_type = CL_DEVICE_TYPE_CPU;
+            } else if (type != "gpu") {
+                error = true;
+                cerr << "device type error!" << endl;
+                break;
+            }
+        }
+        ifstream ifs(filename.c_str());
+        if (!ifs) {
+            error = true;
+            cerr << "can't open file:" << filename << endl;
+            break;
+        }
+        break;
+    }
+    if (error) {
+        cerr << pgm
+             << " paramfile group-num local-num data-count [cpu|gpu]"
+             << endl;
+        cerr << "paramfile   parameter file of tinymt." << endl;
+        cerr << "group-num   total group number of kernel calls." << endl;
+        cerr << "local-num   local item number of kernel cal." << endl;
+        cerr << "data-count  generate random number count." << endl;
+        cerr << "cpu|gpu     device type, default is gpu." << endl;
+        return false;
+    }
+    return true;
+}
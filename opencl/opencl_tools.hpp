@@ -15,6 +15,12 @@
 #include <vector>
 #include <map>
 #include <string>
+#include <sstream>
+#include <cstdlib>
+#include <stdint.h>
+#include <cstdio>
+#include <sys/time.h>
+#include <unistd.h>
 
 /* ========================= */
 /* OpenCL interface function */
@@ -51,7 +57,8 @@ static inline std::vector<cl::Platform> getPlatforms()
     return platforms;
 }
 
-static inline std::vector<cl::Device> getDevices()
+static inline std::vector<cl::Device>
+getDevices(cl_device_type device_type = CL_DEVICE_TYPE_GPU)
 {
     using namespace std;
     using namespace cl;
@@ -60,7 +67,7 @@ static inline std::vector<cl::Device> getDevices()
     cout << "start get devices" << endl;
 #endif
     errorMessage = "getDevices failed";
-    platforms[0].getDevices(CL_DEVICE_TYPE_GPU, &devices);
+    platforms[0].getDevices(device_type, &devices);
     errorMessage = "";
 #if defined(DEBUG)
     cout << "end get devices" << endl;
@@ -145,12 +152,267 @@ static inline bool hasDoubleExtension()
     }
 }
 
-static inline cl::Program getProgram(const char * option = "")
+/* ========================= */
+/* program binary cache      */
+/* ========================= */
+/*
+ * Built programs are saved in the directory given by environment
+ * variable TINYMT_CL_CACHE, or current directory if it is not set.
+ * TINYMT_CL_CACHE=off disables the cache. The cache file is chosen by
+ * the hash of device names, driver versions, build options and source
+ * including files included by double quotes, and the whole key is saved
+ * in the file and compared when it is loaded. Included files are
+ * searched in current directory and directories given by -I options,
+ * and the path found is hashed with the content. Paths with spaces and
+ * files included by angle brackets are not followed.
+ */
+
+static inline double getWallTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec * 1.0e-6;
+}
+
+static inline uint64_t hashString(const std::string& str, uint64_t hash)
+{
+    for (std::string::size_type i = 0; i < str.size(); i++) {
+        hash ^= (unsigned char)str[i];
+        hash *= UINT64_C(0x100000001b3);
+    }
+    return hash;
+}
+
+/**
+ * directories given by -I options.
+ *@param option build option
+ *@return directories in the order of option
+ */
+static inline std::vector<std::string> getIncludeDirs(const char * option)
+{
+    using namespace std;
+    std::vector<std::string> dirs;
+    istringstream iss(option);
+    std::string word;
+    while (iss >> word) {
+        if (word == "-I") {
+            if (iss >> word) {
+                dirs.push_back(word);
+            }
+        } else if (word.compare(0, 2, "-I") == 0) {
+            dirs.push_back(word.substr(2));
+        }
+    }
+    return dirs;
+}
+
+/**
+ * hash of source text and files included by it.
+ * Included files are searched in current directory, then in dirs.
+ *@param text source text
+ *@param dirs include directories
+ *@param hash initial hash value
+ *@param depth nesting level of include
+ *@return hash value
+ */
+static inline uint64_t hashSource(const std::string& text,
+                                  const std::vector<std::string>& dirs,
+                                  uint64_t hash,
+                                  int depth)
+{
+    using namespace std;
+    hash = hashString(text, hash);
+    if (depth > 10) {
+        return hash;
+    }
+    istringstream iss(text);
+    std::string line;
+    while (getline(iss, line)) {
+        std::string::size_type pos = line.find_first_not_of(" \t");
+        if (pos == std::string::npos
+            || line.compare(pos, 8, "#include") != 0) {
+            continue;
+        }
+        std::string::size_type first = line.find('"', pos);
+        std::string::size_type last = line.find('"', first + 1);
+        if (first == std::string::npos || last == std::string::npos) {
+            continue;
+        }
+        std::string name = line.substr(first + 1, last - first - 1);
+        std::string path = name;
+        ifstream ifs(path.c_str(), fstream::in | fstream::binary);
+        for (unsigned int i = 0; !ifs && i < dirs.size(); i++) {
+            ifs.clear();
+            path = dirs[i] + "/" + name;
+            ifs.open(path.c_str(), fstream::in | fstream::binary);
+        }
+        if (!ifs) {
+            continue;
+        }
+        ostringstream oss;
+        oss << ifs.rdbuf();
+        hash = hashString(path, hash);
+        hash = hashSource(oss.str(), dirs, hash, depth + 1);
+    }
+    return hash;
+}
+
+static inline std::string getProgramCacheKey(const char * option)
+{
+    using namespace std;
+    using namespace cl;
+    ostringstream key;
+    for (unsigned int i = 0; i < devices.size(); i++) {
+        key << devices[i].getInfo<CL_DEVICE_NAME>() << ";"
+            << devices[i].getInfo<CL_DEVICE_VERSION>() << ";"
+            << devices[i].getInfo<CL_DRIVER_VERSION>() << ";";
+    }
+    key << option << ";"
+        << hex << setw(16) << setfill('0')
+        << hashSource(programBuffer, getIncludeDirs(option),
+                      UINT64_C(0xcbf29ce484222325), 0);
+    return key.str();
+}
+
+static inline std::string getProgramCacheName(const std::string& key)
+{
+    using namespace std;
+    const char * dir = getenv("TINYMT_CL_CACHE");
+    ostringstream name;
+    if (dir != NULL && dir[0] != '\0') {
+        name << dir << "/";
+    }
+    name << "tinymt-" << hex << setw(16) << setfill('0')
+         << hashString(key, UINT64_C(0xcbf29ce484222325)) << ".clbin";
+    return name.str();
+}
+
+/**
+ * load binaries from cache and build program.
+ *@param filename cache file
+ *@param key cache key
+ *@param option build option
+ *@param program output
+ *@return true if program is built from cache
+ */
+static inline bool loadProgramCache(const std::string& filename,
+                                    const std::string& key,
+                                    const char * option,
+                                    cl::Program& program)
 {
     using namespace std;
     using namespace cl;
+    ifstream ifs(filename.c_str(), fstream::in | fstream::binary);
+    if (!ifs) {
+        return false;
+    }
+    uint64_t key_size = 0;
+    ifs.read((char *)&key_size, sizeof(key_size));
+    if (!ifs || key_size != key.size()) {
+        return false;
+    }
+    std::string saved_key(key_size, ' ');
+    ifs.read(&saved_key[0], key_size);
+    if (!ifs || saved_key != key) {
+        return false;
+    }
+    std::vector<std::string> bins(devices.size());
+    Program::Binaries binaries;
+    for (unsigned int i = 0; i < devices.size(); i++) {
+        uint64_t size = 0;
+        ifs.read((char *)&size, sizeof(size));
+        if (!ifs || size == 0 || size > (UINT64_C(1) << 30)) {
+            return false;
+        }
+        bins[i].resize(size);
+        ifs.read(&bins[i][0], size);
+        if (!ifs) {
+            return false;
+        }
+        binaries.push_back(make_pair((const void *)bins[i].data(),
+                                     (::size_t)size));
+    }
+    try {
+        std::vector<cl_int> status;
+        cl_int err = 0;
+        program = Program(context, devices, binaries, &status, &err);
+        program.build(devices, option);
+    } catch (cl::Error e) {
 #if defined(DEBUG)
-    cout << "start get program" << endl;
+        cout << "program cache rejected err:" << dec << e.err() << endl;
+#endif
+        return false;
+    }
+    return true;
+}
+
+/**
+ * save binaries of built program to cache.
+ * Failure is not an error, the program is built from source next time.
+ *@param filename cache file
+ *@param key cache key
+ *@param program built program
+ */
+static inline void saveProgramCache(const std::string& filename,
+                                    const std::string& key,
+                                    const cl::Program& program)
+{
+    using namespace std;
+    using namespace cl;
+    std::vector< ::size_t> sizes(devices.size());
+    cl_int err = clGetProgramInfo(program(),
+                                  CL_PROGRAM_BINARY_SIZES,
+                                  sizes.size() * sizeof(::size_t),
+                                  &sizes[0],
+                                  NULL);
+    if (err != CL_SUCCESS) {
+        return;
+    }
+    std::vector<std::string> bins(devices.size());
+    std::vector<unsigned char *> ptrs(devices.size());
+    for (unsigned int i = 0; i < devices.size(); i++) {
+        if (sizes[i] == 0) {
+            return;
+        }
+        bins[i].resize(sizes[i]);
+        ptrs[i] = (unsigned char *)&bins[i][0];
+    }
+    err = clGetProgramInfo(program(),
+                           CL_PROGRAM_BINARIES,
+                           ptrs.size() * sizeof(unsigned char *),
+                           &ptrs[0],
+                           NULL);
+    if (err != CL_SUCCESS) {
+        return;
+    }
+    // unique name, so that processes sharing the cache do not collide
+    ostringstream tmp;
+    tmp << filename << "." << getpid() << ".tmp";
+    std::string tmpname = tmp.str();
+    ofstream ofs(tmpname.c_str(), fstream::out | fstream::binary);
+    if (!ofs) {
+        return;
+    }
+    uint64_t key_size = key.size();
+    ofs.write((const char *)&key_size, sizeof(key_size));
+    ofs.write(key.data(), key_size);
+    for (unsigned int i = 0; i < devices.size(); i++) {
+        uint64_t size = sizes[i];
+        ofs.write((const char *)&size, sizeof(size));
+        ofs.write(bins[i].data(), size);
+    }
+    ofs.close();
+    if (!ofs || rename(tmpname.c_str(), filename.c_str()) != 0) {
+        remove(tmpname.c_str());
+    }
+}
+
+static inline cl::Program buildProgram(const char * option)
+{
+    using namespace std;
+    using namespace cl;
+#if defined(DEBUG)
+    cout << "start build program" << endl;
 #endif
     cl_int err = 0;
     errorMessage = "create program failed";
@@ -177,6 +439,50 @@ static inline cl::Program getProgram(const char * option = "")
         throw e;
     }
     errorMessage = "";
+#if defined(DEBUG)
+    cout << "end build program" << endl;
+#endif
+    return program;
+}
+
+/**
+ * get program built for devices.
+ * Program is loaded from binary cache if possible, otherwise it is
+ * built from source and saved to the cache.
+ *@param option build option
+ *@return built program
+ */
+static inline cl::Program getProgram(const char * option = "")
+{
+    using namespace std;
+    using namespace cl;
+#if defined(DEBUG)
+    cout << "start get program" << endl;
+#endif
+    const char * cache = getenv("TINYMT_CL_CACHE");
+    bool use_cache = cache == NULL || std::string(cache) != "off";
+    double start = getWallTime();
+    Program program;
+    std::string key;
+    std::string filename;
+    if (use_cache) {
+        key = getProgramCacheKey(option);
+        filename = getProgramCacheName(key);
+        if (loadProgramCache(filename, key, option, program)) {
+            cout << "program cache hit:" << filename << " "
+                 << (getWallTime() - start) * 1000 << "ms" << endl;
+#if defined(DEBUG)
+            cout << "end get program" << endl;
+#endif
+            return program;
+        }
+    }
+    program = buildProgram(option);
+    cout << "program compile:" << (getWallTime() - start) * 1000
+         << "ms" << endl;
+    if (use_cache) {
+        saveProgramCache(filename, key, program);
+    }
 #if defined(DEBUG)
     cout << "end get program" << endl;
 #endif
@@ -203,6 +509,45 @@ static inline cl::CommandQueue getCommandQueue()
     return queue;
 }
 
+/**
+ * make command queues for all devices in the context,
+ * for multi device generation.
+ *@return command queues, i-th queue is for devices[i]
+ */
+static inline std::vector<cl::CommandQueue> getCommandQueues()
+{
+    using namespace std;
+    using namespace cl;
+    std::vector<cl::CommandQueue> queues;
+    errorMessage = "create command queue failed";
+    for (unsigned int i = 0; i < devices.size(); i++) {
+        cl_int err = 0;
+        queues.push_back(CommandQueue(context,
+                                      devices[i],
+                                      CL_QUEUE_PROFILING_ENABLE,
+                                      &err));
+    }
+    errorMessage = "";
+    return queues;
+}
+
+/**
+ * split work groups among devices.
+ * Device d has work groups from first[d] to first[d + 1] - 1, and the
+ * result depends only on the numbers of groups and devices.
+ *@param group_num number of work groups
+ *@param device_num number of devices
+ *@return first work group of each device, and group_num at the end
+ */
+static inline std::vector<int> splitGroups(int group_num, int device_num)
+{
+    std::vector<int> first(device_num + 1);
+    for (int d = 0; d <= device_num; d++) {
+        first[d] = (int)((int64_t)group_num * d / device_num);
+    }
+    return first;
+}
+
 static inline int getMaxGroupSize()
 {
     using namespace std;
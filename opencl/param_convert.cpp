@@ -0,0 +1,86 @@
+/**
+ * @file param_convert.cpp
+ *
+ * @brief convert parameter file to binary parameter file.
+ *
+ * Text parameter files, tinymt32dc.0.2000.txt and tinymt64dc.0.2000.txt,
+ * are converted to binary parameter files read by binary_reader in
+ * file_reader.h, which host programs load by memory map without parsing.
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and The University of Tokyo.
+ * All rights reserved.
+ *
+ * The new BSD License is applied to this software, see LICENSE.txt
+ */
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <errno.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "file_reader.h"
+
+using namespace std;
+using namespace tinymt;
+
+/**
+ * main
+ *@param argc number of arguments
+ *@param argv array of arguments
+ *@return 0 normal, -1 error
+ */
+int main(int argc, char * argv[])
+{
+    if (argc <= 3) {
+        cerr << argv[0] << " 32|64 paramfile binaryfile [count]" << endl;
+        cerr << "32|64       tinymt32 or tinymt64." << endl;
+        cerr << "paramfile   parameter file of tinymt." << endl;
+        cerr << "binaryfile  output binary parameter file." << endl;
+        cerr << "count       number of parameter sets,"
+             << " default is all." << endl;
+        return -1;
+    }
+    errno = 0;
+    int bits = strtol(argv[1], NULL, 10);
+    std::string filename = argv[2];
+    std::string binary = argv[3];
+    if (errno || (bits != 32 && bits != 64)) {
+        cerr << "bits should be 32 or 64!" << endl;
+        return -1;
+    }
+    int count = -1;
+    if (argc > 4) {
+        count = strtol(argv[4], NULL, 10);
+        if (errno || count <= 0) {
+            cerr << "count error!" << endl;
+            return -1;
+        }
+    }
+    try {
+        // one pass, type column of every line is checked against bits
+        std::vector<param_record> records;
+        file_reader reader(filename);
+        param_record record;
+        while ((count < 0 || (int)records.size() < count)
+               && reader.get_record(&record, bits)) {
+            records.push_back(record);
+        }
+        if (records.empty() || (count > 0 && (int)records.size() < count)) {
+            cerr << "count error!" << endl;
+            return -1;
+        }
+        binary_reader::write(binary, bits, &records[0], (int)records.size());
+        // read back to check header and checksum
+        binary_reader br(binary);
+        cout << "converted " << dec << br.count() << " parameters." << endl;
+    } catch (std::exception& e) {
+        cerr << e.what() << endl;
+        return -1;
+    }
+    return 0;
+}
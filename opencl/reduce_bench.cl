@@ -0,0 +1,159 @@
+/**
+ * @file reduce_bench.cl
+ *
+ * @brief Benchmark Program for openCL 1.2
+ *
+ * Kernels for reduce_bench.cpp, which compares tree reduction of
+ * tinymt_reduce.clh with serial reduction by the first work item of a
+ * work group, and checks reduction functions.
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and The University of Tokyo.
+ * All rights reserved.
+ *
+ * The new BSD License is applied to this software, see LICENSE.txt
+ */
+#include "tinymt.clh"
+#include "tinymt_reduce.clh"
+
+/**
+ * value of work item for benchmark and check.
+ * @param id sequential id
+ * @return value
+ */
+inline static uint
+reduce_value(size_t id)
+{
+    uint x = (uint)id * 2654435761U;
+    return x ^ (x >> 15);
+}
+
+/**
+ * serial summation by the first work item, as sample kernels did.
+ * @param value value of work item
+ * @param scratch local memory of local size elements
+ * @return sum, only for the first work item
+ */
+inline static uint
+serial_sum_uint(uint value, __local uint * scratch)
+{
+    const size_t local_id = get_local_id(0);
+    uint sum = 0;
+    scratch[local_id] = value;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    if (local_id == 0) {
+	for (uint i = 0; i < get_local_size(0); i++) {
+	    sum += scratch[i];
+	}
+    }
+    barrier(CLK_LOCAL_MEM_FENCE);
+    return sum;
+}
+
+/**
+ * kernel function.
+ * This function sums values of work group repeatedly by tree reduction.
+ *
+ * @param[out] d_sum sum of a work group
+ * @param[in] scratch local memory of local size uints
+ * @param[in] repeat number of reductions
+ */
+__kernel void
+reduce_tree_kernel(__global uint * d_sum,
+		   __local uint * scratch,
+		   int repeat)
+{
+    const uint value = reduce_value(tinymt_get_sequential_id());
+    uint sum = 0;
+
+    for (int i = 0; i < repeat; i++) {
+	sum += tinymt_reduce_sum_uint(value + i, scratch);
+    }
+    if (get_local_id(0) == 0) {
+	d_sum[get_group_id(0)] = sum;
+    }
+}
+
+/**
+ * kernel function.
+ * This function sums values of work group repeatedly by serial loop of
+ * the first work item.
+ *
+ * @param[out] d_sum sum of a work group
+ * @param[in] scratch local memory of local size uints
+ * @param[in] repeat number of reductions
+ */
+__kernel void
+reduce_serial_kernel(__global uint * d_sum,
+		     __local uint * scratch,
+		     int repeat)
+{
+    const uint value = reduce_value(tinymt_get_sequential_id());
+    uint sum = 0;
+
+    for (int i = 0; i < repeat; i++) {
+	sum += serial_sum_uint(value + i, scratch);
+    }
+    if (get_local_id(0) == 0) {
+	d_sum[get_group_id(0)] = sum;
+    }
+}
+
+/**
+ * kernel function.
+ * This function calculates sum, min and max of uint, ulong and float
+ * values, and histogram of a work group.
+ *
+ * @param[out] d_uint sum, min and max of uint values of a work group
+ * @param[out] d_ulong sum, min and max of ulong values of a work group
+ * @param[out] d_float sum, min and max of float values of a work group
+ * @param[out] d_bins histogram of a work group
+ * @param[in] s_uint local memory of local size uints
+ * @param[in] s_ulong local memory of local size ulongs
+ * @param[in] s_float local memory of local size floats
+ * @param[in] bins local memory of num_bins uints
+ * @param[in] num_bins number of bins of histogram
+ */
+__kernel void
+reduce_check_kernel(__global uint * d_uint,
+		    __global ulong * d_ulong,
+		    __global float * d_float,
+		    __global uint * d_bins,
+		    __local uint * s_uint,
+		    __local ulong * s_ulong,
+		    __local float * s_float,
+		    __local uint * bins,
+		    int num_bins)
+{
+    const size_t id = tinymt_get_sequential_id();
+    const size_t group_id = get_group_id(0);
+    const uint u = reduce_value(id);
+    const ulong l = ((ulong)u << 20) | (id & 0xfffff);
+    const float f = u * (1.0f / 4294967296.0f);
+    uint ur[3];
+    ulong lr[3];
+    float fr[3];
+
+    ur[0] = tinymt_reduce_sum_uint(u, s_uint);
+    ur[1] = tinymt_reduce_min_uint(u, s_uint);
+    ur[2] = tinymt_reduce_max_uint(u, s_uint);
+    lr[0] = tinymt_reduce_sum_ulong(l, s_ulong);
+    lr[1] = tinymt_reduce_min_ulong(l, s_ulong);
+    lr[2] = tinymt_reduce_max_ulong(l, s_ulong);
+    fr[0] = tinymt_reduce_sum_float(f, s_float);
+    fr[1] = tinymt_reduce_min_float(f, s_float);
+    fr[2] = tinymt_reduce_max_float(f, s_float);
+    tinymt_histogram_clear(bins, num_bins);
+    tinymt_histogram_add(bins, u % num_bins);
+    tinymt_histogram_write(&d_bins[num_bins * group_id], bins, num_bins);
+    if (get_local_id(0) == 0) {
+	for (int i = 0; i < 3; i++) {
+	    d_uint[3 * group_id + i] = ur[i];
+	    d_ulong[3 * group_id + i] = lr[i];
+	    d_float[3 * group_id + i] = fr[i];
+	}
+    }
+}
@@ -0,0 +1,352 @@
+/**
+ * Benchmark program for OpenCL
+ * comparing tree reduction and serial reduction in a work group.
+ *
+ * For local sizes from 32 to 1024, this program measures
+ * reduce_tree_kernel, which uses tinymt_reduce_sum_uint of
+ * tinymt_reduce.clh, and reduce_serial_kernel, in which the first work
+ * item sums local memory in a loop, and compares their outputs.
+ * reduce_check_kernel checks sum, min and max of uint, ulong and float,
+ * and histogram, also for local size which is not a power of two.
+ * Local sizes greater than max work group size of the device are skipped.
+ * CPU device, for example POCL, can be selected by command line.
+ */
+#define CL_USE_DEPRECATED_OPENCL_1_1_APIS
+#define __CL_ENABLE_EXCEPTIONS
+
+#include <cstddef>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <errno.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "opencl_tools.hpp"
+
+using namespace std;
+using namespace cl;
+
+/* ================== */
+/* OpenCL information */
+/* ================== */
+std::vector<cl::Platform> platforms;
+std::vector<cl::Device> devices;
+cl::Context context;
+std::string programBuffer;
+cl::Program program;
+cl::Program::Sources source;
+cl::CommandQueue queue;
+std::string errorMessage;
+
+/* ========================= */
+/* global variables          */
+/* ========================= */
+static int group_num;
+static int repeat = 100;
+static cl_device_type device_type = CL_DEVICE_TYPE_GPU;
+static const int num_bins = 16;
+
+/* =========================
+   declaration
+   ========================= */
+static int bench(int argc, char * argv[]);
+static double run_sum(const char * kernel_name, int local_num,
+                      uint32_t sum[]);
+static int bench_sum(int local_num);
+static int check_reduce(int local_num);
+static uint32_t reduce_value(uint32_t id);
+static bool parse_opt(int argc, char **argv);
+
+/**
+ * main
+ * catch errors
+ *@param argc number of arguments
+ *@param argv array of arguments
+ *@return 0 normal, -1 error
+ */
+int main(int argc, char * argv[])
+{
+    try {
+        return bench(argc, argv);
+    } catch (Error e) {
+        cerr << "Error Code:" << e.err() << endl;
+        cerr << e.what() << endl;
+    } catch (std::string& er) {
+        cerr << er << endl;
+    } catch (...) {
+        cerr << "other error" << endl;
+    }
+    return -1;
+}
+
+/**
+ * benchmark main
+ *@param argc number of arguments
+ *@param argv array of arguments
+ *@return 0 normal, -1 error
+ */
+static int bench(int argc, char * argv[])
+{
+    if (!parse_opt(argc, argv)) {
+        return -1;
+    }
+    platforms = getPlatforms();
+    devices = getDevices(device_type);
+    context = getContext();
+    source = getSource("reduce_bench.cl");
+    std::string option = "-DKERNEL_PROGRAM ";
+    program = getProgram(option.c_str());
+    queue = getCommandQueue();
+    int max_local = getMaxGroupSize();
+    cout << "device:" << devices[0].getInfo<CL_DEVICE_NAME>() << endl;
+    cout << "groups:" << dec << group_num
+         << " repeat:" << repeat << endl;
+    int mismatch = 0;
+    for (int local_num = 32; local_num <= 1024; local_num *= 2) {
+        if (local_num > max_local) {
+            cout << "local:" << local_num << " skipped" << endl;
+            continue;
+        }
+        mismatch += bench_sum(local_num);
+        mismatch += check_reduce(local_num);
+    }
+    if (max_local >= 100) {
+        mismatch += check_reduce(100);
+    }
+    if (mismatch != 0) {
+        cout << "reduction check N.G!" << endl;
+        return -1;
+    }
+    cout << "reduction check O.K!" << endl;
+    return 0;
+}
+
+/**
+ * run summation kernel
+ *@param kernel_name reduce_tree_kernel or reduce_serial_kernel
+ *@param local_num local size
+ *@param sum output, sum of each work group
+ *@return kernel time in second
+ */
+static double run_sum(const char * kernel_name, int local_num,
+                      uint32_t sum[])
+{
+    Buffer sum_buffer(context,
+                      CL_MEM_WRITE_ONLY,
+                      group_num * sizeof(uint32_t));
+    Kernel kernel(program, kernel_name);
+    kernel.setArg(0, sum_buffer);
+    kernel.setArg(1, local_num * sizeof(uint32_t), NULL);
+    kernel.setArg(2, repeat);
+    Event event;
+    queue.enqueueNDRangeKernel(kernel,
+                               NullRange,
+                               NDRange(group_num * local_num),
+                               NDRange(local_num),
+                               NULL,
+                               &event);
+    double time = get_time(event);
+    queue.enqueueReadBuffer(sum_buffer,
+                            CL_TRUE,
+                            0,
+                            group_num * sizeof(uint32_t),
+                            sum);
+    return time;
+}
+
+/**
+ * measure tree and serial summation and compare outputs
+ *@param local_num local size
+ *@return number of mismatches
+ */
+static int bench_sum(int local_num)
+{
+    uint32_t * tree = new uint32_t[group_num];
+    uint32_t * serial = new uint32_t[group_num];
+    double tree_time = run_sum("reduce_tree_kernel", local_num, tree);
+    double serial_time = run_sum("reduce_serial_kernel", local_num, serial);
+    int mismatch = 0;
+    for (int i = 0; i < group_num; i++) {
+        if (tree[i] != serial[i]) {
+            if (mismatch < 10) {
+                cout << "mismatch local = " << dec << local_num
+                     << " group = " << i
+                     << " tree = " << hex << tree[i]
+                     << " serial = " << serial[i] << endl;
+            }
+            mismatch++;
+        }
+    }
+    double reductions = (double)group_num * repeat;
+    cout << "local:" << setw(5) << dec << local_num
+         << fixed << setprecision(3)
+         << " tree:" << tree_time * 1000 << "ms "
+         << reductions / tree_time * 1.0e-6 << "M/s"
+         << " serial:" << serial_time * 1000 << "ms "
+         << reductions / serial_time * 1.0e-6 << "M/s" << endl;
+    delete[] tree;
+    delete[] serial;
+    return mismatch;
+}
+
+/**
+ * check reductions of reduce_check_kernel with host calculation
+ *@param local_num local size
+ *@return number of mismatches
+ */
+static int check_reduce(int local_num)
+{
+    Buffer uint_buffer(context, CL_MEM_WRITE_ONLY,
+                       group_num * 3 * sizeof(uint32_t));
+    Buffer ulong_buffer(context, CL_MEM_WRITE_ONLY,
+                        group_num * 3 * sizeof(uint64_t));
+    Buffer float_buffer(context, CL_MEM_WRITE_ONLY,
+                        group_num * 3 * sizeof(float));
+    Buffer bins_buffer(context, CL_MEM_WRITE_ONLY,
+                       group_num * num_bins * sizeof(uint32_t));
+    Kernel kernel(program, "reduce_check_kernel");
+    kernel.setArg(0, uint_buffer);
+    kernel.setArg(1, ulong_buffer);
+    kernel.setArg(2, float_buffer);
+    kernel.setArg(3, bins_buffer);
+    kernel.setArg(4, local_num * sizeof(uint32_t), NULL);
+    kernel.setArg(5, local_num * sizeof(uint64_t), NULL);
+    kernel.setArg(6, local_num * sizeof(float), NULL);
+    kernel.setArg(7, num_bins * sizeof(uint32_t), NULL);
+    kernel.setArg(8, num_bins);
+    queue.enqueueNDRangeKernel(kernel,
+                               NullRange,
+                               NDRange(group_num * local_num),
+                               NDRange(local_num));
+    uint32_t * ur = new uint32_t[group_num * 3];
+    uint64_t * lr = new uint64_t[group_num * 3];
+    float * fr = new float[group_num * 3];
+    uint32_t * bins = new uint32_t[group_num * num_bins];
+    queue.enqueueReadBuffer(uint_buffer, CL_TRUE, 0,
+                            group_num * 3 * sizeof(uint32_t), ur);
+    queue.enqueueReadBuffer(ulong_buffer, CL_TRUE, 0,
+                            group_num * 3 * sizeof(uint64_t), lr);
+    queue.enqueueReadBuffer(float_buffer, CL_TRUE, 0,
+                            group_num * 3 * sizeof(float), fr);
+    queue.enqueueReadBuffer(bins_buffer, CL_TRUE, 0,
+                            group_num * num_bins * sizeof(uint32_t), bins);
+    int mismatch = 0;
+    uint32_t * h_bins = new uint32_t[num_bins];
+    for (int g = 0; g < group_num; g++) {
+        uint32_t u_exp[3] = {0, UINT32_C(0xffffffff), 0};
+        uint64_t l_exp[3] = {0, UINT64_C(0xffffffffffffffff), 0};
+        double f_sum = 0;
+        float f_min = 1.0f;
+        float f_max = 0.0f;
+        for (int b = 0; b < num_bins; b++) {
+            h_bins[b] = 0;
+        }
+        for (int j = 0; j < local_num; j++) {
+            uint32_t id = g * local_num + j;
+            uint32_t u = reduce_value(id);
+            uint64_t l = ((uint64_t)u << 20) | (id & 0xfffff);
+            float f = u * (1.0f / 4294967296.0f);
+            u_exp[0] += u;
+            u_exp[1] = (u < u_exp[1]) ? u : u_exp[1];
+            u_exp[2] = (u > u_exp[2]) ? u : u_exp[2];
+            l_exp[0] += l;
+            l_exp[1] = (l < l_exp[1]) ? l : l_exp[1];
+            l_exp[2] = (l > l_exp[2]) ? l : l_exp[2];
+            f_sum += f;
+            f_min = (f < f_min) ? f : f_min;
+            f_max = (f > f_max) ? f : f_max;
+            h_bins[u % num_bins]++;
+        }
+        bool ok = true;
+        for (int i = 0; i < 3; i++) {
+            ok = ok && (ur[3 * g + i] == u_exp[i]);
+            ok = ok && (lr[3 * g + i] == l_exp[i]);
+        }
+        // order of float summation differs from host
+        ok = ok && fabs(fr[3 * g] - f_sum) <= 1.0e-5 * local_num;
+        ok = ok && fr[3 * g + 1] == f_min && fr[3 * g + 2] == f_max;
+        for (int b = 0; b < num_bins; b++) {
+            ok = ok && bins[num_bins * g + b] == h_bins[b];
+        }
+        if (!ok) {
+            if (mismatch < 10) {
+                cout << "mismatch local = " << dec << local_num
+                     << " group = " << g << endl;
+            }
+            mismatch++;
+        }
+    }
+    delete[] ur;
+    delete[] lr;
+    delete[] fr;
+    delete[] bins;
+    delete[] h_bins;
+    return mismatch;
+}
+
+/**
+ * value of work item, same as reduce_value in reduce_bench.cl
+ *@param id sequential id
+ *@return value
+ */
+static uint32_t reduce_value(uint32_t id)
+{
+    uint32_t x = id * UINT32_C(2654435761);
+    return x ^ (x >> 15);
+}
+
+/**
+ * parsing command line options
+ *@param argc number of arguments
+ *@param argv array of argument strings
+ *@return true if no errors are found in command line arguments
+ */
+static bool parse_opt(int argc, char **argv)
+{
+    bool error = false;
+    std::string pgm = argv[0];
+    errno = 0;
+    if (argc <= 1) {
+        error = true;
+    }
+    while (!error) {
+        group_num = strtol(argv[1], NULL, 10);
+        if (errno || group_num <= 0) {
+            error = true;
+            cerr << "number error!" << endl;
+            break;
+        }
+        if (argc > 2) {
+            std::string type = argv[2];
+            if (type == "cpu") {
+                device_type = CL_DEVICE_TYPE_CPU;
+            } else if (type != "gpu") {
+                error = true;
+                cerr << "device type error!" << endl;
+                break;
+            }
+        }
+        if (argc > 3) {
+            repeat = strtol(argv[3], NULL, 10);
+            if (errno || repeat <= 0) {
+                error = true;
+                cerr << "repeat error!" << endl;
+                break;
+            }
+        }
+        break;
+    }
+    if (error) {
+        cerr << pgm << " group-num [cpu|gpu] [repeat]" << endl;
+        cerr << "group-num   group number of kernel calls." << endl;
+        cerr << "cpu|gpu     device type, cpu for POCL. default is gpu."
+             << endl;
+        cerr << "repeat      number of reductions in a kernel call."
+             << endl;
+        return false;
+    }
+    return true;
+}
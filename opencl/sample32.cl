@@ -15,6 +15,7 @@
  * The new BSD License is applied to this software, see LICENSE.txt
  */
 #include "tinymt32.clh"
+#include "tinymt_reduce.clh"
 
 /**
  * kernel function.
@@ -27,7 +28,7 @@
  * @param local_sum temporary summation of points in a quadrant
  */
 __kernel void
-calc_pi(__global tinymt32wp_t * d_status,
+calc_pi(__global tinymt32wp_buffer_t * d_status,
                uint seed,
                int size,
                __global uint * global_sum,
@@ -36,7 +37,6 @@ calc_pi(__global tinymt32wp_t * d_status,
     tinymt32wp_t tiny;
     const size_t group_id = get_group_id(0);
     const size_t local_id = get_local_id(0);
-    const size_t local_size = get_local_size(0);
     const size_t id = tinymt_get_sequential_id();
 
     // initialize
@@ -51,14 +51,9 @@ calc_pi(__global tinymt32wp_t * d_status,
             sum++;
         }
     }
-    local_sum[local_id] = sum;
-    // partial reduce
-    barrier(CLK_LOCAL_MEM_FENCE);
-    sum = 0;
+    // reduce
+    sum = tinymt_reduce_sum_uint(sum, local_sum);
     if (local_id == 0) {
-        for (uint i = 0; i < local_size; i++) {
-            sum += local_sum[i];
-        }
         global_sum[group_id] = sum;
     }
 }
@@ -0,0 +1,276 @@
+/**
+ * Sample program for OpenCL
+ * feeding host side consumer by tinymt_stream.
+ *
+ * This program generates batches of 32-bit integers by
+ * tinymt_uint32_kernel in test32_jump.cl, and consumes them on host,
+ * first by blocking generate-and-read flow, then by tinymt_stream, which
+ * overlaps generation, transfer and consumption.
+ * Both flows start from the same seed, and their checksums should be
+ * same.
+ */
+#define CL_USE_DEPRECATED_OPENCL_1_1_APIS
+#define __CL_ENABLE_EXCEPTIONS
+
+#include <cstddef>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <errno.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "opencl_tools.hpp"
+#include "tinymt32def.h"
+#include "tinymt_stream.hpp"
+
+using namespace std;
+using namespace cl;
+
+/* ================== */
+/* OpenCL information */
+/* ================== */
+std::vector<cl::Platform> platforms;
+std::vector<cl::Device> devices;
+cl::Context context;
+std::string programBuffer;
+cl::Program program;
+cl::Program::Sources source;
+cl::CommandQueue queue;
+std::string errorMessage;
+
+/* =========================
+   declaration
+   ========================= */
+static int group_num;
+static int local_num;
+static int data_count;
+static int batch_count;
+static cl_device_type device_type = CL_DEVICE_TYPE_GPU;
+
+/**
+ * host side consumer, which makes checksum of each stream
+ */
+class checksum {
+public:
+    checksum(int total_num, int size)
+        : total_num(total_num), size(size), sum(0) {
+    }
+    void operator()(const uint32_t * data, long index) {
+        tinymt_output_view<uint32_t> view(data, total_num, size,
+                                          TINYMT_LAYOUT_INTERLEAVED);
+        (void)index;
+        for (int id = 0; id < total_num; id++) {
+            const uint32_t * p = view.stream(id);
+            uint32_t x = 0;
+            for (int i = 0; i < size; i++) {
+                x ^= p[i * view.stride()];
+            }
+            sum = sum * 31 + x;
+        }
+    }
+    uint64_t value() const {
+        return sum;
+    }
+private:
+    int total_num;
+    int size;
+    uint64_t sum;
+};
+
+static bool parse_opt(int argc, char **argv);
+static Buffer init_status(int total_num, int local_num, uint32_t seed);
+static uint64_t blocking_flow(int total_num, int local_num, int size);
+static uint64_t stream_flow(int total_num, int local_num, int size);
+static int sample(int argc, char * argv[]);
+
+/**
+ * main
+ * call sample main and catch errors
+ *@param argc number of arguments
+ *@param argv array of arguments
+ *@return 0 normal, -1 error
+ */
+int main(int argc, char * argv[])
+{
+    try {
+        return sample(argc, argv);
+    } catch (Error e) {
+        cerr << "Error Code:" << e.err() << endl;
+        cerr << e.what() << endl;
+    }
+    return -1;
+}
+
+/**
+ * sample main
+ *@param argc number of arguments
+ *@param argv array of arguments
+ *@return 0 normal, -1 error
+ */
+static int sample(int argc, char * argv[])
+{
+    if (!parse_opt(argc, argv)) {
+        return -1;
+    }
+    platforms = getPlatforms();
+    devices = getDevices(device_type);
+    context = getContext();
+    source = getSource("test32_jump.cl");
+    std::string option = "-DKERNEL_PROGRAM ";
+    program = getProgram(option.c_str());
+    queue = getCommandQueue();
+    int total_num = group_num * local_num;
+    int size = data_count / total_num;
+    if (size <= 0) {
+        size = 1;
+    }
+    uint64_t sum1 = blocking_flow(total_num, local_num, size);
+    uint64_t sum2 = stream_flow(total_num, local_num, size);
+    if (sum1 != sum2) {
+        cout << "checksum mismatch N.G!" << endl;
+        return -1;
+    }
+    cout << "checksum " << hex << sum1 << dec << " O.K!" << endl;
+    return 0;
+}
+
+/**
+ * make initialized status in device global memory
+ *@param total_num total number of work items
+ *@param local_num number of local work items
+ *@param seed seed for initialization
+ *@return status buffer
+ */
+static Buffer init_status(int total_num, int local_num, uint32_t seed)
+{
+    Buffer status_buffer(context,
+                         CL_MEM_READ_WRITE,
+                         total_num * sizeof(tinymt32j_t));
+    Kernel init_kernel(program, "tinymt_init_seed_kernel");
+    init_kernel.setArg(0, status_buffer);
+    init_kernel.setArg(1, seed);
+    queue.enqueueNDRangeKernel(init_kernel,
+                               NullRange,
+                               NDRange(total_num),
+                               NDRange(local_num));
+    queue.finish();
+    return status_buffer;
+}
+
+/**
+ * generate and consume batches one by one.
+ *@param total_num total number of work items
+ *@param local_num number of local work items
+ *@param size number of outputs of a work item in a batch
+ *@return checksum
+ */
+static uint64_t blocking_flow(int total_num, int local_num, int size)
+{
+    Buffer status_buffer = init_status(total_num, local_num, 1234);
+    Buffer output_buffer(context,
+                         CL_MEM_READ_WRITE,
+                         total_num * size * sizeof(uint32_t));
+    Kernel uint_kernel(program, "tinymt_uint32_kernel");
+    uint_kernel.setArg(0, status_buffer);
+    uint_kernel.setArg(1, output_buffer);
+    uint_kernel.setArg(2, size);
+    uint_kernel.setArg(3, (int)TINYMT_LAYOUT_INTERLEAVED);
+    uint32_t * output = new uint32_t[total_num * size];
+    checksum consumer(total_num, size);
+    double start = getWallTime();
+    for (long i = 0; i < batch_count; i++) {
+        queue.enqueueNDRangeKernel(uint_kernel,
+                                   NullRange,
+                                   NDRange(total_num),
+                                   NDRange(local_num));
+        queue.enqueueReadBuffer(output_buffer,
+                                CL_TRUE,
+                                0,
+                                total_num * size * sizeof(uint32_t),
+                                output);
+        consumer(output, i);
+    }
+    double time = getWallTime() - start;
+    delete[] output;
+    cout << "blocking:" << fixed << setprecision(3) << time * 1000 << "ms "
+         << (double)total_num * size * batch_count / time * 1.0e-6
+         << "M/s" << endl;
+    return consumer.value();
+}
+
+/**
+ * generate and consume batches by tinymt_stream.
+ *@param total_num total number of work items
+ *@param local_num number of local work items
+ *@param size number of outputs of a work item in a batch
+ *@return checksum
+ */
+static uint64_t stream_flow(int total_num, int local_num, int size)
+{
+    Buffer status_buffer = init_status(total_num, local_num, 1234);
+    tinymt_stream<uint32_t> stream(context, devices[0], program,
+                                   "tinymt_uint32_kernel",
+                                   status_buffer, total_num, local_num,
+                                   size);
+    double start = getWallTime();
+    checksum consumer = stream.for_each(batch_count,
+                                        checksum(total_num, size));
+    double time = getWallTime() - start;
+    cout << "stream:  " << fixed << setprecision(3) << time * 1000 << "ms "
+         << (double)total_num * size * batch_count / time * 1.0e-6
+         << "M/s" << endl;
+    return consumer.value();
+}
+
+/**
+ * parsing command line options
+ *@param argc number of arguments
+ *@param argv array of argument strings
+ *@return true if no errors are found in command line arguments
+ */
+static bool parse_opt(int argc, char **argv)
+{
+    bool error = false;
+    std::string pgm = argv[0];
+    errno = 0;
+    if (argc <= 4) {
+        error = true;
+    }
+    while (!error) {
+        group_num = strtol(argv[1], NULL, 10);
+        local_num = strtol(argv[2], NULL, 10);
+        data_count = strtol(argv[3], NULL, 10);
+        batch_count = strtol(argv[4], NULL, 10);
+        if (errno || group_num <= 0 || local_num <= 0
+            || data_count <= 0 || batch_count <= 0) {
+            error = true;
+            cerr << "number error!" << endl;
+            break;
+        }
+        if (argc > 5) {
+            std::string type = argv[5];
+            if (type == "cpu") {
+                device_type = CL_DEVICE_TYPE_CPU;
+            } else if (type != "gpu") {
+                error = true;
+                cerr << "device type error!" << endl;
+                break;
+            }
+        }
+        break;
+    }
+    if (error) {
+        cerr << pgm
+             << " group-num local-num data-count batch-count [cpu|gpu]"
+             << endl;
+        cerr << "group-num   group number of kernel call." << endl;
+        cerr << "local-num   local item number of kernel cal." << endl;
+        cerr << "data-count  number of random numbers in a batch." << endl;
+        cerr << "batch-count number of batches." << endl;
+        cerr << "cpu|gpu     device type, default is gpu." << endl;
+        return false;
+    }
+    return true;
+}
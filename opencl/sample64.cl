@@ -15,6 +15,7 @@
  * The new BSD License is applied to this software, see LICENSE.txt
  */
 #include "tinymt64.clh"
+#include "tinymt_reduce.clh"
 
 /**
  * kernel function.
@@ -27,7 +28,7 @@
  * @param local_sum temporary summation of points in a quadrant
  */
 __kernel void
-calc_pi(__global tinymt64wp_t * d_status,
+calc_pi(__global tinymt64wp_buffer_t * d_status,
                ulong seed,
                int num,
                __global uint * global_sum,
@@ -52,13 +53,8 @@ calc_pi(__global tinymt64wp_t * d_status,
         }
     }
     // reduce
-    local_sum[local_id] = sum;
-    sum = 0;
-    barrier(CLK_LOCAL_MEM_FENCE);
+    sum = tinymt_reduce_sum_uint(sum, local_sum);
     if (local_id == 0) {
-        for (uint i = 0; i < get_local_size(0); i++) {
-            sum += local_sum[i];
-        }
         global_sum[group_id] = sum;
     }
 }
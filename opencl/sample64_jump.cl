@@ -15,6 +15,7 @@
  * The new BSD License is applied to this software, see LICENSE.txt
  */
 #include "tinymt64_jump.clh"
+#include "tinymt_reduce.clh"
 
 /**
  * kernel function.
@@ -52,13 +53,8 @@ calc_pi(ulong seed,
         }
     }
     // reduce
-    local_sum[local_id] = sum;
-    sum = 0;
-    barrier(CLK_LOCAL_MEM_FENCE);
+    sum = tinymt_reduce_sum_uint(sum, local_sum);
     if (local_id == 0) {
-        for (uint i = 0; i < get_local_size(0); i++) {
-            sum += local_sum[i];
-        }
         global_sum[group_id] = sum;
     }
 }
@@ -20,6 +20,7 @@
  * The new BSD License is applied to this software, see LICENSE.txt
  */
 #include "tinymt32.clh"
+#include "tinymt32x4.clh"
 
 /**
  * kernel function.
@@ -29,7 +30,7 @@
  * @param seed seed of initialization
  */
 __kernel void
-tinymt_init_seed_kernel(__global tinymt32wp_t * d_status,
+tinymt_init_seed_kernel(__global tinymt32wp_buffer_t * d_status,
                         uint seed)
 {
     const size_t id = tinymt_get_sequential_id();
@@ -49,7 +50,7 @@ tinymt_init_seed_kernel(__global tinymt32wp_t * d_status,
  * @param length length of seeds.
  */
 __kernel void
-tinymt_init_array_kernel(__global tinymt32wp_t * d_status,
+tinymt_init_array_kernel(__global tinymt32wp_buffer_t * d_status,
                          __global uint * seeds,
                         int length)
 {
@@ -74,11 +75,13 @@ tinymt_init_array_kernel(__global tinymt32wp_t * d_status,
  * @param d_status internal state of kernel side tinymt
  * @param d_data output
  * @param size number of output data requested.
+ * @param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
  */
 __kernel void
-tinymt_uint32_kernel(__global tinymt32wp_t * d_status,
+tinymt_uint32_kernel(__global tinymt32wp_buffer_t * d_status,
                      __global uint * d_data,
-                     int size)
+                     int size,
+                     int layout)
 {
     const size_t id = tinymt_get_sequential_id();
     const size_t global_size = tinymt_get_sequential_size();
@@ -86,7 +89,8 @@ tinymt_uint32_kernel(__global tinymt32wp_t * d_status,
 
     tinymt32_status_read(&tiny, d_status);
     for (int i = 0; i < size; i++) {
-        d_data[global_size * i + id] = tinymt32_uint32(&tiny);
+        d_data[tinymt_layout_index(layout, id, global_size, size, i)]
+            = tinymt32_uint32(&tiny);
     }
     tinymt32_status_write(d_status, &tiny);
 }
@@ -98,11 +102,13 @@ tinymt_uint32_kernel(__global tinymt32wp_t * d_status,
  * @param d_status internal state of kernel side tinymt
  * @param d_data output
  * @param size number of output data requested.
+ * @param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
  */
 __kernel void
-tinymt_single12_kernel(__global tinymt32wp_t * d_status,
+tinymt_single12_kernel(__global tinymt32wp_buffer_t * d_status,
                        __global float * d_data,
-                       int size)
+                       int size,
+                       int layout)
 {
     const size_t id = tinymt_get_sequential_id();
     const size_t sequential_size = tinymt_get_sequential_size();
@@ -110,7 +116,8 @@ tinymt_single12_kernel(__global tinymt32wp_t * d_status,
 
     tinymt32_status_read(&tiny, d_status);
     for (int i = 0; i < size; i++) {
-        d_data[sequential_size * i + id] = tinymt32_single12(&tiny);
+        d_data[tinymt_layout_index(layout, id, sequential_size, size, i)]
+            = tinymt32_single12(&tiny);
     }
     tinymt32_status_write(d_status, &tiny);
 }
@@ -122,11 +129,13 @@ tinymt_single12_kernel(__global tinymt32wp_t * d_status,
  * @param[in,out] d_status internal state of kernel side tinymt
  * @param[out] d_data output
  * @param[in] size number of output data requested.
+ * @param[in] layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
  */
 __kernel void
-tinymt_single01_kernel(__global tinymt32wp_t * d_status,
+tinymt_single01_kernel(__global tinymt32wp_buffer_t * d_status,
                        __global float * d_data,
-                       int size)
+                       int size,
+                       int layout)
 {
     const size_t id = tinymt_get_sequential_id();
     const size_t sequential_size = tinymt_get_sequential_size();
@@ -134,8 +143,117 @@ tinymt_single01_kernel(__global tinymt32wp_t * d_status,
 
     tinymt32_status_read(&tiny, d_status);
     for (int i = 0; i < size; i++) {
-        d_data[sequential_size * i + id] = tinymt32_single01(&tiny);
+        d_data[tinymt_layout_index(layout, id, sequential_size, size, i)]
+            = tinymt32_single01(&tiny);
     }
     tinymt32_status_write(d_status, &tiny);
 }
 
+
+/**
+ * kernel function.
+ * This function calculates jump tables for characteristic polynomials.
+ * Work item id calculates the table of characteristic polynomial id.
+ *
+ * @param[out] d_table jump tables, TINYMT_JUMP_TABLE_SIZE * 4 uints
+ * for each polynomial
+ * @param[in] d_characteristic characteristic polynomials, four uints for
+ * each
+ * @param[in] step step of jump between adjacent sequential ids
+ * @param[in] num number of characteristic polynomials
+ */
+__kernel void
+tinymt_jump_table_kernel(__global uint * d_table,
+                         __global const uint * d_characteristic,
+                         ulong step,
+                         int num)
+{
+    const size_t id = tinymt_get_sequential_id();
+    if (id >= num) {
+        return;
+    }
+    tinymt_calc_jump_table(&d_table[TINYMT_JUMP_TABLE_SIZE * 4 * id],
+                           &d_characteristic[4 * id],
+                           step);
+}
+
+/**
+ * kernel function.
+ * This function initializes internal state of tinymt32 by seed, and
+ * jumps by sequential id * step of the jump table.
+ * All work items should have the same parameters, for which
+ * jump_table is calculated by tinymt_jump_table_kernel.
+ *
+ * @param[in,out] d_status internal state of kernel side tinymt
+ * @param[in] jump_table jump table of the parameters
+ * @param[in] seed seed of initialization
+ */
+__kernel void
+tinymt_init_jump_kernel(__global tinymt32wp_buffer_t * d_status,
+                        __constant uint * jump_table,
+                        uint seed)
+{
+    const size_t id = tinymt_get_sequential_id();
+    tinymt32wp_t tiny;
+
+    tinymt32_status_read(&tiny, d_status);
+    tinymt32_init(&tiny, seed);
+    tinymt32_jump_by_table(&tiny, jump_table, id);
+    tinymt32_status_write(d_status, &tiny);
+}
+
+/**
+ * kernel function.
+ * This function generates 32-bit unsigned integers in d_data by
+ * tinymt32x4, four streams a work item.
+ * The status and output of stream 4 * id + k are same as those of
+ * tinymt_uint32_kernel called with four times the work items.
+ *
+ * @param[in,out] d_status internal state of kernel side tinymt,
+ * four times the work items
+ * @param[out] d_data output
+ * @param[in] size number of output data of a stream.
+ * @param[in] layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
+ */
+__kernel void
+tinymt_uint32x4_kernel(__global tinymt32wp_buffer_t * d_status,
+                       __global uint * d_data,
+                       int size,
+                       int layout)
+{
+    tinymt32x4_t tiny;
+
+    tinymt32x4_status_read(&tiny, d_status);
+    for (int i = 0; i < size; i++) {
+        tinymt32x4_store_uint(d_data, layout, size, i,
+                              tinymt32x4_uint32(&tiny));
+    }
+    tinymt32x4_status_write(d_status, &tiny);
+}
+
+/**
+ * kernel function.
+ * This function generates floating points in the range [0,1) in d_data
+ * by tinymt32x4, four streams a work item.
+ *
+ * @param[in,out] d_status internal state of kernel side tinymt,
+ * four times the work items
+ * @param[out] d_data output
+ * @param[in] size number of output data of a stream.
+ * @param[in] layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
+ */
+__kernel void
+tinymt_single01x4_kernel(__global tinymt32wp_buffer_t * d_status,
+                         __global float * d_data,
+                         int size,
+                         int layout)
+{
+    tinymt32x4_t tiny;
+
+    tinymt32x4_status_read(&tiny, d_status);
+    for (int i = 0; i < size; i++) {
+        tinymt32x4_store_float(d_data, layout, size, i,
+                               tinymt32x4_single01(&tiny));
+    }
+    tinymt32x4_status_write(d_status, &tiny);
+}
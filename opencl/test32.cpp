@@ -20,6 +20,7 @@
 #include "tinymt32.h"
 #include "test_common.h"
 #include "file_reader.h"
+#include "tinymt_param_buffer.hpp"
 
 using namespace std;
 using namespace cl;
@@ -45,6 +46,8 @@ static std::string filename;
 static int group_num;
 static int local_num;
 static int data_count;
+static int layout = TINYMT_LAYOUT_INTERLEAVED;
+static bool status_soa = false;
 
 static bool parse_opt(int argc, char **argv);
 static int init_check_data(tinymt32_t tinymt32[],
@@ -77,6 +80,9 @@ static void initialize_by_array(Buffer& tinymt_status,
 static void make_tinymt(std::string& filename, int total_num);
 static Buffer get_param_buff(std::string& filename,
                              int total_num);
+static void read_status(Buffer& tinymt_status,
+                        tinymt32wp_t status[],
+                        int total_num);
 static void generate_uint32(Buffer& tinymt_status,
                             int total_num,
                             int local_num,
@@ -146,6 +152,9 @@ static int test(int argc, char * argv[])
 #if defined(DEBUG)
     option += "-DDEBUG ";
 #endif
+    if (status_soa) {
+        option += "-DTINYMT_STATUS_SOA ";
+    }
     program = getProgram(option.c_str());
     queue = getCommandQueue();
 #if defined(DEBUG)
@@ -223,11 +232,7 @@ static void initialize_by_seed(Buffer& tinymt_status,
                                &event);
     double time = get_time(event);
     tinymt32wp_t status[total];
-    queue.enqueueReadBuffer(tinymt_status,
-                            CL_TRUE,
-                            0,
-                            sizeof(tinymt32wp_t) * total,
-                            status);
+    read_status(tinymt_status, status, total);
     cout << "initializing time = " << time * 1000 << "ms" << endl;
 #if defined(DEBUG)
     cout << "status[0].s0:" << hex << status[0].s0 << endl;
@@ -282,11 +287,7 @@ static void initialize_by_array(Buffer& tinymt_status,
                                &event);
     double time = get_time(event);
     tinymt32wp_t status[total];
-    queue.enqueueReadBuffer(tinymt_status,
-                            CL_TRUE,
-                            0,
-                            sizeof(tinymt32wp_t) * total,
-                            status);
+    read_status(tinymt_status, status, total);
     cout << "initializing time = " << time * 1000 << "ms" << endl;
     check_status(status, total);
 #if defined(DEBUG)
@@ -320,6 +321,7 @@ static void generate_uint32(Buffer& tinymt_status,
     uint_kernel.setArg(0, tinymt_status);
     uint_kernel.setArg(1, output_buffer);
     uint_kernel.setArg(2, data_size / total_num);
+    uint_kernel.setArg(3, layout);
     NDRange global(total_num);
     NDRange local(local_num);
     Event generate_event;
@@ -341,7 +343,7 @@ static void generate_uint32(Buffer& tinymt_status,
                             output);
     check_data(output, data_size, total_num);
 #if defined(DEBUG)
-    print_uint32(output, data_size, total_num);
+    print_uint32(output, data_size, total_num, layout);
 #endif
     double time = get_time(generate_event);
     cout << "generate time:" << time * 1000 << "ms" << endl;
@@ -375,6 +377,7 @@ static void generate_single12(Buffer& tinymt_status,
     single_kernel.setArg(0, tinymt_status);
     single_kernel.setArg(1, output_buffer);
     single_kernel.setArg(2, data_size / total_num);
+    single_kernel.setArg(3, layout);
     NDRange global(total_num);
     NDRange local(local_num);
     Event generate_event;
@@ -393,7 +396,7 @@ static void generate_single12(Buffer& tinymt_status,
                             &output[0]);
     check_data12(output, data_size, total_num);
 #if defined(DEBUG)
-    print_float(&output[0], data_size, total_num);
+    print_float(&output[0], data_size, total_num, layout);
 #endif
     double time = get_time(generate_event);
     delete[] output;
@@ -424,6 +427,7 @@ static void generate_single01(Buffer& tinymt_status,
     single_kernel.setArg(0, tinymt_status);
     single_kernel.setArg(1, output_buffer);
     single_kernel.setArg(2, data_size / total_num);
+    single_kernel.setArg(3, layout);
     NDRange global(total_num);
     NDRange local(local_num);
     Event generate_event;
@@ -442,7 +446,7 @@ static void generate_single01(Buffer& tinymt_status,
                             &output[0]);
     check_data01(output, data_size, total_num);
 #if defined(DEBUG)
-    print_float(&output[0], data_size, local_num);
+    print_float(&output[0], data_size, total_num, layout);
 #endif
     double time = get_time(generate_event);
     delete[] output;
@@ -455,6 +459,18 @@ static void generate_single01(Buffer& tinymt_status,
  * ==============*/
 static void make_tinymt(std::string& filename, int total_num)
 {
+    if (tinymt::binary_reader::is_binary(filename)) {
+        tinymt::binary_reader br(filename);
+        checkParamFile(br, 32, total_num);
+        const tinymt::param_record * records = br.records();
+        tinymt32 = new tinymt32_t[total_num];
+        for (int i = 0; i < total_num; i++) {
+            tinymt32[i].mat1 = records[i].mat1;
+            tinymt32[i].mat2 = records[i].mat2;
+            tinymt32[i].tmat = (uint32_t)records[i].tmat;
+        }
+        return;
+    }
     tinymt::file_reader fr(filename);
     tinymt32 = new tinymt32_t[total_num];
     uint32_t mat1;
@@ -510,6 +526,7 @@ static void check_data(uint32_t * h_data,
     cout << "check_data start" << endl;
 #endif
     int size = num_data / total_num;
+    tinymt_output_view<uint32_t> view(h_data, total_num, size, layout);
 #if defined(DEBUG)
     cout << "size = " << dec << size << endl;
 #endif
@@ -519,10 +536,10 @@ static void check_data(uint32_t * h_data,
         int count = 0;
         for (int j = 0; j < size; j++) {
             uint32_t r = tinymt32_generate_uint32(&tinymt32[i]);
-            if ((h_data[j * total_num + i] != r) && disp_flg) {
+            if ((view(i, j) != r) && disp_flg) {
                 cout << "mismatch i = " << dec << i
                      << " j = " << dec << j
-                     << " data = " << hex << h_data[j * total_num + i]
+                     << " data = " << hex << view(i, j)
                      << " r = " << hex << r << endl;
                 cout << "check_data check N.G!" << endl;
                 count++;
@@ -551,6 +568,7 @@ static void check_data12(float * h_data,
     cout << "check_data start" << endl;
 #endif
     int size = num_data / total_num;
+    tinymt_output_view<float> view(h_data, total_num, size, layout);
 #if defined(DEBUG)
     cout << "size = " << dec << size << endl;
 #endif
@@ -560,13 +578,13 @@ static void check_data12(float * h_data,
         int count = 0;
         for (int j = 0; j < size; j++) {
             float r = tinymt32_generate_float12(&tinymt32[i]);
-            float d = h_data[j * total_num + i];
+            float d = view(i, j);
             bool ok = (-FLT_EPSILON <= (r - d))
                 && ((r - d) <= FLT_EPSILON);
             if (!ok && disp_flg) {
                 cout << "mismatch i = " << dec << i
                      << " j = " << dec << j
-                     << " data = " << dec << h_data[j * total_num + i]
+                     << " data = " << dec << view(i, j)
                      << " r = " << dec << r << endl;
                 cout << "check_data check N.G!" << endl;
                 count++;
@@ -595,6 +613,7 @@ static void check_data01(float * h_data,
     cout << "check_data start" << endl;
 #endif
     int size = num_data / total_num;
+    tinymt_output_view<float> view(h_data, total_num, size, layout);
 #if defined(DEBUG)
     cout << "size = " << dec << size << endl;
 #endif
@@ -604,13 +623,13 @@ static void check_data01(float * h_data,
         int count = 0;
         for (int j = 0; j < size; j++) {
             float r = tinymt32_generate_float(&tinymt32[i]);
-            float d = h_data[j * total_num + i];
+            float d = view(i, j);
             bool ok = (-FLT_EPSILON <= (r - d))
                 && ((r - d) <= FLT_EPSILON);
             if (!ok && disp_flg) {
                 cout << "mismatch i = " << dec << i
                      << " j = " << dec << j
-                     << " data = " << dec << h_data[j * total_num + i]
+                     << " data = " << dec << view(i, j)
                      << " r = " << dec << r << endl;
                 cout << "check_data check N.G!" << endl;
                 count++;
@@ -711,6 +730,10 @@ static Buffer get_param_buff(std::string& filename,
 #if defined(DEBUG)
     cout << "get_rec_buff start" << endl;
 #endif
+    if (tinymt::binary_reader::is_binary(filename)) {
+        tinymt::binary_reader br(filename);
+        return getParamBuffer32(context, queue, br, total_num, status_soa);
+    }
     tinymt::file_reader fr(filename);
     tinymt32wp_t * status_tbl = new tinymt32wp_t[total_num];
     uint32_t mat1;
@@ -725,11 +748,22 @@ static Buffer get_param_buff(std::string& filename,
     Buffer status_buffer(context,
                          CL_MEM_READ_ONLY,
                          total_num * sizeof(tinymt32wp_t));
-    queue.enqueueWriteBuffer(status_buffer,
-                             CL_TRUE,
-                             0,
-                             total_num * sizeof(tinymt32wp_t),
-                             status_tbl);
+    if (status_soa) {
+        cl_uint * soa = new cl_uint[TINYMT32WP_SOA_FIELDS * total_num];
+        tinymt32wp_to_soa(soa, status_tbl, total_num);
+        queue.enqueueWriteBuffer(status_buffer,
+                                 CL_TRUE,
+                                 0,
+                                 total_num * sizeof(tinymt32wp_t),
+                                 soa);
+        delete[] soa;
+    } else {
+        queue.enqueueWriteBuffer(status_buffer,
+                                 CL_TRUE,
+                                 0,
+                                 total_num * sizeof(tinymt32wp_t),
+                                 status_tbl);
+    }
     delete[] status_tbl;
 #if defined(DEBUG)
     cout << "get_rec_buff end" << endl;
@@ -737,6 +771,35 @@ static Buffer get_param_buff(std::string& filename,
     return status_buffer;
 }
 
+/**
+ * read kernel side tinymt status, which may be in structure of
+ * arrays form.
+ *@param tinymt_status internal state of kernel side tinymt
+ *@param status host side copy of the state
+ *@param total_num total number of work items
+ */
+static void read_status(Buffer& tinymt_status,
+                        tinymt32wp_t status[],
+                        int total_num)
+{
+    if (status_soa) {
+        cl_uint * soa = new cl_uint[TINYMT32WP_SOA_FIELDS * total_num];
+        queue.enqueueReadBuffer(tinymt_status,
+                                CL_TRUE,
+                                0,
+                                total_num * sizeof(tinymt32wp_t),
+                                soa);
+        tinymt32wp_from_soa(status, soa, total_num);
+        delete[] soa;
+    } else {
+        queue.enqueueReadBuffer(tinymt_status,
+                                CL_TRUE,
+                                0,
+                                total_num * sizeof(tinymt32wp_t),
+                                status);
+    }
+}
+
 static bool parse_opt(int argc, char **argv) {
 #if defined(DEBUG)
     cout << "parse_opt start" << endl;
@@ -770,6 +833,21 @@ static bool parse_opt(int argc, char **argv) {
             cerr << strerror(errno) << endl;
             break;
         }
+        if (argc > 5 && !parse_layout(argv[5], &layout)) {
+            error = true;
+            cerr << "layout error!" << endl;
+            break;
+        }
+        if (argc > 6) {
+            std::string form = argv[6];
+            if (form == "soa") {
+                status_soa = true;
+            } else if (form != "aos") {
+                error = true;
+                cerr << "status form error!" << endl;
+                break;
+            }
+        }
         if (!filename.empty()) {
             ifstream ifs(filename.c_str());
             if (ifs) {
@@ -784,11 +862,18 @@ static bool parse_opt(int argc, char **argv) {
     }
     if (error) {
         cerr << pgm
-             << " paramfile group-num local-num data-count" << endl;
-        cerr << "paramfile   parameter file of tinymt." << endl;
+             << " paramfile group-num local-num data-count [layout [aos|soa]]"
+             << endl;
+        cerr << "paramfile   parameter file of tinymt, or binary parameter file"
+             << endl
+             << "            made by param_convert." << endl;
         cerr << "group-num   group number of kernel call." << endl;
         cerr << "local-num   local item number of kernel cal." << endl;
         cerr << "data-count  generate random number count." << endl;
+        cerr << "layout      output layout, interleaved or blocked." << endl;
+        cerr << "aos|soa     form of kernel side status, array of structures"
+             << endl
+             << "            or structure of arrays." << endl;
         return false;
     }
 #if defined(DEBUG)
@@ -69,11 +69,13 @@ tinymt_init_array_kernel(__global tinymt32j_t * d_status,
  * @param d_status internal state of kernel side tinymt
  * @param d_data output
  * @param size number of output data requested.
+ * @param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
  */
 __kernel void
 tinymt_uint32_kernel(__global tinymt32j_t * d_status,
 		     __global uint* d_data,
-		     int size)
+		     int size,
+		     int layout)
 {
     const size_t id = tinymt_get_sequential_id();
     const size_t global_size = tinymt_get_sequential_size();
@@ -81,7 +83,8 @@ tinymt_uint32_kernel(__global tinymt32j_t * d_status,
 
     tinymt32j_status_read(&tiny, d_status);
     for (int i = 0; i < size; i++) {
-	d_data[global_size * i + id] = tinymt32j_uint32(&tiny);
+	d_data[tinymt_layout_index(layout, id, global_size, size, i)]
+	    = tinymt32j_uint32(&tiny);
     }
     tinymt32j_status_write(d_status, &tiny);
 }
@@ -93,11 +96,13 @@ tinymt_uint32_kernel(__global tinymt32j_t * d_status,
  * @param d_status internal state of kernel side tinymt
  * @param d_data output
  * @param size number of output data requested.
+ * @param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
  */
 __kernel void
 tinymt_single12_kernel(__global tinymt32j_t * d_status,
 		       __global float * d_data,
-		       int size)
+		       int size,
+		       int layout)
 {
     const size_t id = tinymt_get_sequential_id();
     const size_t sequential_size = tinymt_get_sequential_size();
@@ -105,7 +110,8 @@ tinymt_single12_kernel(__global tinymt32j_t * d_status,
 
     tinymt32j_status_read(&tiny, d_status);
     for (int i = 0; i < size; i++) {
-	d_data[sequential_size * i + id] = tinymt32j_single12(&tiny);
+	d_data[tinymt_layout_index(layout, id, sequential_size, size, i)]
+	    = tinymt32j_single12(&tiny);
     }
     tinymt32j_status_write(d_status, &tiny);
 }
@@ -117,11 +123,13 @@ tinymt_single12_kernel(__global tinymt32j_t * d_status,
  * @param d_status internal state of kernel side tinymt
  * @param d_data output
  * @param size number of output data requested.
+ * @param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
  */
 __kernel void
 tinymt_single01_kernel(__global tinymt32j_t * d_status,
 		       __global float * d_data,
-		       int size)
+		       int size,
+		       int layout)
 {
     const size_t id = tinymt_get_sequential_id();
     const size_t sequential_size = tinymt_get_sequential_size();
@@ -129,7 +137,8 @@ tinymt_single01_kernel(__global tinymt32j_t * d_status,
 
     tinymt32j_status_read(&tiny, d_status);
     for (int i = 0; i < size; i++) {
-	d_data[sequential_size * i + id] = tinymt32j_single01(&tiny);
+	d_data[tinymt_layout_index(layout, id, sequential_size, size, i)]
+	    = tinymt32j_single01(&tiny);
     }
     tinymt32j_status_write(d_status, &tiny);
 }
@@ -44,6 +44,7 @@ std::string errorMessage;
 static int group_num;
 static int local_num;
 static int data_count;
+static int layout = TINYMT_LAYOUT_INTERLEAVED;
 static tinymt32_t * tinymt32;
 static const uint64_t tinymt32j_mag = UINT64_C(12157665459056928801);
 static const char * tinymt32j_characteristic = "d8524022ed8dff4a8dcc50c798faba43";
@@ -322,6 +323,7 @@ static void generate_uint32(Buffer& tinymt_status,
     uint_kernel.setArg(0, tinymt_status);
     uint_kernel.setArg(1, output_buffer);
     uint_kernel.setArg(2, data_size / total_num);
+    uint_kernel.setArg(3, layout);
     NDRange global(total_num);
     NDRange local(local_num);
     Event generate_event;
@@ -343,7 +345,7 @@ static void generate_uint32(Buffer& tinymt_status,
                             output);
     check_data(output, data_size, total_num);
 #if defined(DEBUG)
-    print_uint32(output, data_size, total_num);
+    print_uint32(output, data_size, total_num, layout);
 #endif
     double time = get_time(generate_event);
     cout << "generate time:" << time * 1000 << "ms" << endl;
@@ -377,6 +379,7 @@ static void generate_single12(Buffer& tinymt_status,
     single_kernel.setArg(0, tinymt_status);
     single_kernel.setArg(1, output_buffer);
     single_kernel.setArg(2, data_size / total_num);
+    single_kernel.setArg(3, layout);
     NDRange global(total_num);
     NDRange local(local_num);
     Event generate_event;
@@ -395,7 +398,7 @@ static void generate_single12(Buffer& tinymt_status,
                             &output[0]);
     check_data12(output, data_size, total_num);
 #if defined(DEBUG)
-    print_float(&output[0], data_size, total_num);
+    print_float(&output[0], data_size, total_num, layout);
 #endif
     double time = get_time(generate_event);
     delete[] output;
@@ -426,6 +429,7 @@ static void generate_single01(Buffer& tinymt_status,
     single_kernel.setArg(0, tinymt_status);
     single_kernel.setArg(1, output_buffer);
     single_kernel.setArg(2, data_size / total_num);
+    single_kernel.setArg(3, layout);
     NDRange global(total_num);
     NDRange local(local_num);
     Event generate_event;
@@ -444,7 +448,7 @@ static void generate_single01(Buffer& tinymt_status,
                             &output[0]);
     check_data01(output, data_size, total_num);
 #if defined(DEBUG)
-    print_float(&output[0], data_size, local_num);
+    print_float(&output[0], data_size, total_num, layout);
 #endif
     double time = get_time(generate_event);
     delete[] output;
@@ -542,6 +546,7 @@ static void check_data(uint32_t * h_data,
     cout << "check_data start" << endl;
 #endif
     int size = num_data / total_num;
+    tinymt_output_view<uint32_t> view(h_data, total_num, size, layout);
 #if defined(DEBUG)
     cout << "size = " << dec << size << endl;
 #endif
@@ -551,10 +556,10 @@ static void check_data(uint32_t * h_data,
         int count = 0;
         for (int j = 0; j < size; j++) {
             uint32_t r = tinymt32_generate_uint32(&tinymt32[i]);
-            if ((h_data[j * total_num + i] != r) && disp_flg) {
+            if ((view(i, j) != r) && disp_flg) {
                 cout << "mismatch i = " << dec << i
                      << " j = " << dec << j
-                     << " data = " << hex << h_data[j * total_num + i]
+                     << " data = " << hex << view(i, j)
                      << " r = " << hex << r << endl;
                 cout << "check_data check N.G!" << endl;
                 count++;
@@ -589,6 +594,7 @@ static void check_data12(float * h_data,
     cout << "check_data start" << endl;
 #endif
     int size = num_data / total_num;
+    tinymt_output_view<float> view(h_data, total_num, size, layout);
 #if defined(DEBUG)
     cout << "size = " << dec << size << endl;
 #endif
@@ -598,13 +604,13 @@ static void check_data12(float * h_data,
         int count = 0;
         for (int j = 0; j < size; j++) {
             float r = tinymt32_generate_float12(&tinymt32[i]);
-            float d = h_data[j * total_num + i];
+            float d = view(i, j);
             bool ok = (-FLT_EPSILON <= (r - d))
                 && ((r - d) <= FLT_EPSILON);
             if (!ok && disp_flg) {
                 cout << "mismatch i = " << dec << i
                      << " j = " << dec << j
-                     << " data = " << dec << h_data[j * total_num + i]
+                     << " data = " << dec << view(i, j)
                      << " r = " << dec << r << endl;
                 cout << "check_data check N.G!" << endl;
                 count++;
@@ -639,6 +645,7 @@ static void check_data01(float * h_data,
     cout << "check_data start" << endl;
 #endif
     int size = num_data / total_num;
+    tinymt_output_view<float> view(h_data, total_num, size, layout);
 #if defined(DEBUG)
     cout << "size = " << dec << size << endl;
 #endif
@@ -648,13 +655,13 @@ static void check_data01(float * h_data,
         int count = 0;
         for (int j = 0; j < size; j++) {
             float r = tinymt32_generate_float(&tinymt32[i]);
-            float d = h_data[j * total_num + i];
+            float d = view(i, j);
             bool ok = (-FLT_EPSILON <= (r - d))
                 && ((r - d) <= FLT_EPSILON);
             if (!ok && disp_flg) {
                 cout << "mismatch i = " << dec << i
                      << " j = " << dec << j
-                     << " data = " << dec << h_data[j * total_num + i]
+                     << " data = " << dec << view(i, j)
                      << " r = " << dec << r << endl;
                 cout << "check_data check N.G!" << endl;
                 count++;
@@ -816,14 +823,20 @@ static bool parse_opt(int argc, char **argv)
             cerr << strerror(errno) << endl;
             break;
         }
+        if (argc > 4 && !parse_layout(argv[4], &layout)) {
+            error = true;
+            cerr << "layout error!" << endl;
+            break;
+        }
         break;
     }
     if (error) {
         cerr << pgm
-             << " group-num local-num data-count" << endl;
+             << " group-num local-num data-count [layout]" << endl;
         cerr << "group-num   group number of kernel call." << endl;
         cerr << "local-num   local item number of kernel cal." << endl;
         cerr << "data-count  generate random number count." << endl;
+        cerr << "layout      output layout, interleaved or blocked." << endl;
         return false;
     }
 #if defined(DEBUG)
@@ -51,6 +51,7 @@ std::string errorMessage;
 static cl_int group_num;
 static cl_int local_num;
 static cl_long data_count;
+static int layout = TINYMT_LAYOUT_BLOCKED;
 static tinymt32_t tiny;
 static const char * tinymt32j_characteristic = "d8524022ed8dff4a8dcc50c798faba43";
 /* =========================
@@ -333,6 +334,7 @@ static void initialize_by_seed(Buffer& status_buffer,
     init_kernel.setArg(0, status_buffer);
     init_kernel.setArg(1, jump_table_buffer);
     init_kernel.setArg(2, seed);
+    init_kernel.setArg(3, sizeof(tinymt32j_t) * local_num, NULL);
     NDRange global(total_num);
     NDRange local(local_num);
     Event event;
@@ -413,6 +415,7 @@ static void generate_uint32(Buffer& status_buffer,
     uint_kernel.setArg(0, status_buffer);
     uint_kernel.setArg(1, output_buffer);
     uint_kernel.setArg(2, data_size / total_num);
+    uint_kernel.setArg(3, layout);
     NDRange global(total_num);
     NDRange local(local_num);
     Event generate_event;
@@ -450,7 +453,7 @@ static void generate_uint32(Buffer& status_buffer,
 #endif
     check_data(output, data_size, total_num);
 #if defined(DEBUG)
-    print_uint32(&output[0], data_size, total_num);
+    print_uint32(&output[0], data_size, total_num, layout);
 #endif
     double time = get_time(generate_event);
     cout << "generate time:" << time * 1000 << "ms" << endl;
@@ -502,13 +505,16 @@ static void check_data(uint32_t * h_data, int num_data, int total_num)
     bool disp_flg = true;
     int count = 0;
     int data_per_thread = num_data / total_num;
+    tinymt_output_view<uint32_t> view(h_data, total_num, data_per_thread,
+                                      layout);
     int j;
     for (j = 0; j < num_data; j++) {
+        uint32_t d = view(j / data_per_thread, j % data_per_thread);
         uint32_t r = tinymt32_generate_uint32(&tiny);
-        if ((h_data[j] != r) && disp_flg) {
+        if ((d != r) && disp_flg) {
             cout << "mismatch"
                  << " j = " << dec << j
-                 << " data = " << hex << h_data[j]
+                 << " data = " << hex << d
                  << " r = " << hex << r << endl;
             cout << "check_data check N.G!" << endl;
             cout << "data_per_thread:" << dec << data_per_thread << endl;
@@ -598,14 +604,20 @@ static bool parse_opt(int argc, char **argv)
             cerr << strerror(errno) << endl;
             break;
         }
+        if (argc > 4 && !parse_layout(argv[4], &layout)) {
+            error = true;
+            cerr << "layout error!" << endl;
+            break;
+        }
         break;
     }
     if (error) {
         cerr << pgm
-             << " group-num local-num data-count" << endl;
+             << " group-num local-num data-count [layout]" << endl;
         cerr << "group-num   group number of kernel call." << endl;
         cerr << "local-num   local item number of kernel cal." << endl;
         cerr << "data-count  generate random number count." << endl;
+        cerr << "layout      output layout, interleaved or blocked." << endl;
         return false;
     }
 #if defined(DEBUG)
@@ -20,6 +20,7 @@
  * The new BSD License is applied to this software, see LICENSE.txt
  */
 #include "tinymt64.clh"
+#include "tinymt64x2.clh"
 
 /**
  * kernel function.
@@ -29,7 +30,7 @@
  * @param seed seed of initialization
  */
 __kernel void
-tinymt_init_seed_kernel(__global tinymt64wp_t * d_status,
+tinymt_init_seed_kernel(__global tinymt64wp_buffer_t * d_status,
 			ulong seed)
 {
     const size_t id = tinymt_get_sequential_id();
@@ -49,7 +50,7 @@ tinymt_init_seed_kernel(__global tinymt64wp_t * d_status,
  * @param length length of seeds
  */
 __kernel void
-tinymt_init_array_kernel(__global tinymt64wp_t * d_status,
+tinymt_init_array_kernel(__global tinymt64wp_buffer_t * d_status,
 			 __global ulong * seeds,
 			int length)
 {
@@ -74,11 +75,13 @@ tinymt_init_array_kernel(__global tinymt64wp_t * d_status,
  * @param d_status internal state of kernel side tinymt
  * @param d_data output
  * @param size number of output data requested.
+ * @param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
  */
 __kernel void
-tinymt_uint64_kernel(__global tinymt64wp_t * d_status,
+tinymt_uint64_kernel(__global tinymt64wp_buffer_t * d_status,
 		     __global ulong * d_data,
-		     int size)
+		     int size,
+		     int layout)
 {
     const size_t id = tinymt_get_sequential_id();
     const size_t global_size = tinymt_get_sequential_size();
@@ -86,7 +89,8 @@ tinymt_uint64_kernel(__global tinymt64wp_t * d_status,
 
     tinymt64_status_read(&tiny, d_status);
     for (int i = 0; i < size; i++) {
-	d_data[global_size * i + id] = tinymt64_uint64(&tiny);
+	d_data[tinymt_layout_index(layout, id, global_size, size, i)]
+	    = tinymt64_uint64(&tiny);
     }
     tinymt64_status_write(d_status, &tiny);
 }
@@ -99,11 +103,13 @@ tinymt_uint64_kernel(__global tinymt64wp_t * d_status,
  * @param d_status internal state of kernel side tinymt
  * @param d_data output
  * @param size number of output data requested.
+ * @param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
  */
 __kernel void
-tinymt_double12_kernel(__global tinymt64wp_t * d_status,
+tinymt_double12_kernel(__global tinymt64wp_buffer_t * d_status,
 		       __global double * d_data,
-		       int size)
+		       int size,
+		       int layout)
 {
     const size_t id = tinymt_get_sequential_id();
     const size_t sequential_size = tinymt_get_sequential_size();
@@ -111,7 +117,8 @@ tinymt_double12_kernel(__global tinymt64wp_t * d_status,
 
     tinymt64_status_read(&tiny, d_status);
     for (int i = 0; i < size; i++) {
-	d_data[sequential_size * i + id] = tinymt64_double12(&tiny);
+	d_data[tinymt_layout_index(layout, id, sequential_size, size, i)]
+	    = tinymt64_double12(&tiny);
     }
     tinymt64_status_write(d_status, &tiny);
 }
@@ -123,11 +130,13 @@ tinymt_double12_kernel(__global tinymt64wp_t * d_status,
  * @param d_status internal state of kernel side tinymt
  * @param d_data output
  * @param size number of output data requested.
+ * @param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
  */
 __kernel void
-tinymt_double01_kernel(__global tinymt64wp_t * d_status,
+tinymt_double01_kernel(__global tinymt64wp_buffer_t * d_status,
 		       __global double * d_data,
-		       int size)
+		       int size,
+		       int layout)
 {
     const size_t id = tinymt_get_sequential_id();
     const size_t sequential_size = tinymt_get_sequential_size();
@@ -135,8 +144,118 @@ tinymt_double01_kernel(__global tinymt64wp_t * d_status,
 
     tinymt64_status_read(&tiny, d_status);
     for (int i = 0; i < size; i++) {
-	d_data[sequential_size * i + id] = tinymt64_double01(&tiny);
+	d_data[tinymt_layout_index(layout, id, sequential_size, size, i)]
+	    = tinymt64_double01(&tiny);
     }
     tinymt64_status_write(d_status, &tiny);
 }
 #endif
+
+/**
+ * kernel function.
+ * This function calculates jump tables for characteristic polynomials.
+ * Work item id calculates the table of characteristic polynomial id.
+ *
+ * @param d_table jump tables, TINYMT_JUMP_TABLE_SIZE * 4 uints for each
+ * polynomial
+ * @param d_characteristic characteristic polynomials, four uints for each
+ * @param step step of jump between adjacent sequential ids
+ * @param num number of characteristic polynomials
+ */
+__kernel void
+tinymt_jump_table_kernel(__global uint * d_table,
+			 __global const uint * d_characteristic,
+			 ulong step,
+			 int num)
+{
+    const size_t id = tinymt_get_sequential_id();
+    if (id >= num) {
+	return;
+    }
+    tinymt_calc_jump_table(&d_table[TINYMT_JUMP_TABLE_SIZE * 4 * id],
+			   &d_characteristic[4 * id],
+			   step);
+}
+
+/**
+ * kernel function.
+ * This function initializes internal state of tinymt64 by seed, and
+ * jumps by sequential id * step of the jump table.
+ * All work items should have the same parameters, for which
+ * jump_table is calculated by tinymt_jump_table_kernel.
+ *
+ * @param d_status internal state of kernel side tinymt
+ * @param jump_table jump table of the parameters
+ * @param seed seed of initialization
+ */
+__kernel void
+tinymt_init_jump_kernel(__global tinymt64wp_buffer_t * d_status,
+			__constant uint * jump_table,
+			ulong seed)
+{
+    const size_t id = tinymt_get_sequential_id();
+    tinymt64wp_t tiny;
+
+    tinymt64_status_read(&tiny, d_status);
+    tinymt64_init(&tiny, seed);
+    tinymt64_jump_by_table(&tiny, jump_table, id);
+    tinymt64_status_write(d_status, &tiny);
+}
+
+/**
+ * kernel function.
+ * This function generates 64-bit unsigned integers in d_data by
+ * tinymt64x2, two streams a work item.
+ * The status and output of stream 2 * id + k are same as those of
+ * tinymt_uint64_kernel called with twice the work items.
+ *
+ * @param d_status internal state of kernel side tinymt,
+ * twice the work items
+ * @param d_data output
+ * @param size number of output data of a stream.
+ * @param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
+ */
+__kernel void
+tinymt_uint64x2_kernel(__global tinymt64wp_buffer_t * d_status,
+		       __global ulong * d_data,
+		       int size,
+		       int layout)
+{
+    tinymt64x2_t tiny;
+
+    tinymt64x2_status_read(&tiny, d_status);
+    for (int i = 0; i < size; i++) {
+	tinymt64x2_store_ulong(d_data, layout, size, i,
+			       tinymt64x2_uint64(&tiny));
+    }
+    tinymt64x2_status_write(d_status, &tiny);
+}
+
+#if defined(HAVE_DOUBLE)
+/**
+ * kernel function.
+ * This function generates double float in the range [0,1) in d_data
+ * by tinymt64x2, two streams a work item.
+ *
+ * @param d_status internal state of kernel side tinymt,
+ * twice the work items
+ * @param d_data output
+ * @param size number of output data of a stream.
+ * @param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
+ */
+__kernel void
+tinymt_double01x2_kernel(__global tinymt64wp_buffer_t * d_status,
+			 __global double * d_data,
+			 int size,
+			 int layout)
+{
+    tinymt64x2_t tiny;
+
+    tinymt64x2_status_read(&tiny, d_status);
+    for (int i = 0; i < size; i++) {
+	tinymt64x2_store_double(d_data, layout, size, i,
+				tinymt64x2_double01(&tiny));
+    }
+    tinymt64x2_status_write(d_status, &tiny);
+}
+#endif
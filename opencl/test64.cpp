@@ -20,6 +20,7 @@
 #include "tinymt64def.h"
 #include "test_common.h"
 #include "file_reader.h"
+#include "tinymt_param_buffer.hpp"
 #include "tinymt64.h"
 
 using namespace std;
@@ -45,6 +46,8 @@ static std::string filename;
 static int group_num;
 static int local_num;
 static int data_count;
+static int layout = TINYMT_LAYOUT_INTERLEAVED;
+static bool status_soa = false;
 
 static bool parse_opt(int argc, char **argv);
 static int init_check_data(tinymt64_t tinymt64[],
@@ -77,6 +80,9 @@ static void initialize_by_array(Buffer& tinymt_status,
 static void make_tinymt(std::string& filename, int total_num);
 static Buffer get_param_buff(std::string& filename,
                              int total_num);
+static void read_status(Buffer& tinymt_status,
+                        tinymt64wp_t status[],
+                        int total_num);
 static void generate_uint64(Buffer& tinymt_status,
                             int total_num,
                             int local_num,
@@ -146,6 +152,9 @@ static int test(int argc, char * argv[])
 #if defined(DEBUG)
     option += "-DDEBUG ";
 #endif
+    if (status_soa) {
+        option += "-DTINYMT_STATUS_SOA ";
+    }
     program = getProgram(option.c_str());
     queue = getCommandQueue();
 #if defined(DEBUG)
@@ -225,11 +234,7 @@ static void initialize_by_seed(Buffer& tinymt_status,
                                &event);
     double time = get_time(event);
     tinymt64wp_t status[total];
-    queue.enqueueReadBuffer(tinymt_status,
-                            CL_TRUE,
-                            0,
-                            sizeof(tinymt64wp_t) * total,
-                            status);
+    read_status(tinymt_status, status, total);
     cout << "initializing time = " << time * 1000 << "ms" << endl;
 #if defined(DEBUG)
     cout << "status[0].s0:" << hex << status[0].s0 << endl;
@@ -282,11 +287,7 @@ static void initialize_by_array(Buffer& tinymt_status,
                                &event);
     double time = get_time(event);
     tinymt64wp_t status[total];
-    queue.enqueueReadBuffer(tinymt_status,
-                            CL_TRUE,
-                            0,
-                            sizeof(tinymt64wp_t) * total,
-                            status);
+    read_status(tinymt_status, status, total);
     cout << "initializing time = " << time * 1000 << "ms" << endl;
     check_status(status, total);
 #if defined(DEBUG)
@@ -320,6 +321,7 @@ static void generate_uint64(Buffer& tinymt_status,
     uint_kernel.setArg(0, tinymt_status);
     uint_kernel.setArg(1, output_buffer);
     uint_kernel.setArg(2, data_size / total_num);
+    uint_kernel.setArg(3, layout);
     NDRange global(total_num);
     NDRange local(local_num);
     Event generate_event;
@@ -341,7 +343,7 @@ static void generate_uint64(Buffer& tinymt_status,
                             output);
     check_data(output, data_size, total_num);
 #if defined(DEBUG)
-    print_uint64(output, data_size, total_num);
+    print_uint64(output, data_size, total_num, layout);
 #endif
     double time = get_time(generate_event);
     cout << "generate time:" << time * 1000 << "ms" << endl;
@@ -375,6 +377,7 @@ static void generate_double12(Buffer& tinymt_status,
     double_kernel.setArg(0, tinymt_status);
     double_kernel.setArg(1, output_buffer);
     double_kernel.setArg(2, data_size / total_num);
+    double_kernel.setArg(3, layout);
     NDRange global(total_num);
     NDRange local(local_num);
     Event generate_event;
@@ -393,7 +396,7 @@ static void generate_double12(Buffer& tinymt_status,
                             &output[0]);
     check_data12(output, data_size, total_num);
 #if defined(DEBUG)
-    print_double(&output[0], data_size, total_num);
+    print_double(&output[0], data_size, total_num, layout);
 #endif
     double time = get_time(generate_event);
     delete[] output;
@@ -424,6 +427,7 @@ static void generate_double01(Buffer& tinymt_status,
     double_kernel.setArg(0, tinymt_status);
     double_kernel.setArg(1, output_buffer);
     double_kernel.setArg(2, data_size / total_num);
+    double_kernel.setArg(3, layout);
     NDRange global(total_num);
     NDRange local(local_num);
     Event generate_event;
@@ -442,7 +446,7 @@ static void generate_double01(Buffer& tinymt_status,
                             &output[0]);
     check_data01(output, data_size, total_num);
 #if defined(DEBUG)
-    print_double(&output[0], data_size, local_num);
+    print_double(&output[0], data_size, total_num, layout);
 #endif
     double time = get_time(generate_event);
     delete[] output;
@@ -460,6 +464,18 @@ static void generate_double01(Buffer& tinymt_status,
  */
 static void make_tinymt(std::string& filename, int total_num)
 {
+    if (tinymt::binary_reader::is_binary(filename)) {
+        tinymt::binary_reader br(filename);
+        checkParamFile(br, 64, total_num);
+        const tinymt::param_record * records = br.records();
+        tinymt64 = new tinymt64_t[total_num];
+        for (int i = 0; i < total_num; i++) {
+            tinymt64[i].mat1 = records[i].mat1;
+            tinymt64[i].mat2 = records[i].mat2;
+            tinymt64[i].tmat = records[i].tmat;
+        }
+        return;
+    }
     tinymt::file_reader fr(filename);
     tinymt64 = new tinymt64_t[total_num];
     uint32_t mat1;
@@ -536,6 +552,7 @@ static void check_data(uint64_t * h_data,
     cout << "check_data start" << endl;
 #endif
     int size = num_data / total_num;
+    tinymt_output_view<uint64_t> view(h_data, total_num, size, layout);
 #if defined(DEBUG)
     cout << "size = " << dec << size << endl;
 #endif
@@ -545,10 +562,10 @@ static void check_data(uint64_t * h_data,
         int count = 0;
         for (int j = 0; j < size; j++) {
             uint64_t r = tinymt64_generate_uint64(&tinymt64[i]);
-            if ((h_data[j * total_num + i] != r) && disp_flg) {
+            if ((view(i, j) != r) && disp_flg) {
                 cout << "mismatch i = " << dec << i
                      << " j = " << dec << j
-                     << " data = " << hex << h_data[j * total_num + i]
+                     << " data = " << hex << view(i, j)
                      << " r = " << hex << r << endl;
                 cout << "check_data check N.G!" << endl;
                 count++;
@@ -583,6 +600,7 @@ static void check_data12(double * h_data,
     cout << "check_data start" << endl;
 #endif
     int size = num_data / total_num;
+    tinymt_output_view<double> view(h_data, total_num, size, layout);
 #if defined(DEBUG)
     cout << "size = " << dec << size << endl;
 #endif
@@ -592,13 +610,13 @@ static void check_data12(double * h_data,
         int count = 0;
         for (int j = 0; j < size; j++) {
             double r = tinymt64_generate_double12(&tinymt64[i]);
-            double d = h_data[j * total_num + i];
+            double d = view(i, j);
             bool ok = (-FLT_EPSILON <= (r - d))
                 && ((r - d) <= FLT_EPSILON);
             if (!ok && disp_flg) {
                 cout << "mismatch i = " << dec << i
                      << " j = " << dec << j
-                     << " data = " << dec << h_data[j * total_num + i]
+                     << " data = " << dec << view(i, j)
                      << " r = " << dec << r << endl;
                 cout << "check_data check N.G!" << endl;
                 count++;
@@ -633,6 +651,7 @@ static void check_data01(double * h_data,
     cout << "check_data start" << endl;
 #endif
     int size = num_data / total_num;
+    tinymt_output_view<double> view(h_data, total_num, size, layout);
 #if defined(DEBUG)
     cout << "size = " << dec << size << endl;
 #endif
@@ -642,13 +661,13 @@ static void check_data01(double * h_data,
         int count = 0;
         for (int j = 0; j < size; j++) {
             double r = tinymt64_generate_double(&tinymt64[i]);
-            double d = h_data[j * total_num + i];
+            double d = view(i, j);
             bool ok = (-FLT_EPSILON <= (r - d))
                 && ((r - d) <= FLT_EPSILON);
             if (!ok && disp_flg) {
                 cout << "mismatch i = " << dec << i
                      << " j = " << dec << j
-                     << " data = " << dec << h_data[j * total_num + i]
+                     << " data = " << dec << view(i, j)
                      << " r = " << dec << r << endl;
                 cout << "check_data check N.G!" << endl;
                 count++;
@@ -756,6 +775,10 @@ static Buffer get_param_buff(std::string& filename,
 #if defined(DEBUG)
     cout << "get_rec_buff start" << endl;
 #endif
+    if (tinymt::binary_reader::is_binary(filename)) {
+        tinymt::binary_reader br(filename);
+        return getParamBuffer64(context, queue, br, total_num, status_soa);
+    }
     tinymt::file_reader fr(filename);
     tinymt64wp_t * status_tbl = new tinymt64wp_t[total_num];
     uint32_t mat1;
@@ -770,11 +793,22 @@ static Buffer get_param_buff(std::string& filename,
     Buffer status_buffer(context,
                          CL_MEM_READ_ONLY,
                          total_num * sizeof(tinymt64wp_t));
-    queue.enqueueWriteBuffer(status_buffer,
-                             CL_TRUE,
-                             0,
-                             total_num * sizeof(tinymt64wp_t),
-                             status_tbl);
+    if (status_soa) {
+        cl_ulong * soa = new cl_ulong[TINYMT64WP_SOA_SIZE64 * total_num];
+        tinymt64wp_to_soa(soa, status_tbl, total_num);
+        queue.enqueueWriteBuffer(status_buffer,
+                                 CL_TRUE,
+                                 0,
+                                 total_num * sizeof(tinymt64wp_t),
+                                 soa);
+        delete[] soa;
+    } else {
+        queue.enqueueWriteBuffer(status_buffer,
+                                 CL_TRUE,
+                                 0,
+                                 total_num * sizeof(tinymt64wp_t),
+                                 status_tbl);
+    }
     delete[] status_tbl;
 #if defined(DEBUG)
     cout << "get_rec_buff end" << endl;
@@ -782,6 +816,35 @@ static Buffer get_param_buff(std::string& filename,
     return status_buffer;
 }
 
+/**
+ * read kernel side tinymt status, which may be in structure of
+ * arrays form.
+ *@param tinymt_status internal state of kernel side tinymt
+ *@param status host side copy of the state
+ *@param total_num total number of work items
+ */
+static void read_status(Buffer& tinymt_status,
+                        tinymt64wp_t status[],
+                        int total_num)
+{
+    if (status_soa) {
+        cl_ulong * soa = new cl_ulong[TINYMT64WP_SOA_SIZE64 * total_num];
+        queue.enqueueReadBuffer(tinymt_status,
+                                CL_TRUE,
+                                0,
+                                total_num * sizeof(tinymt64wp_t),
+                                soa);
+        tinymt64wp_from_soa(status, soa, total_num);
+        delete[] soa;
+    } else {
+        queue.enqueueReadBuffer(tinymt_status,
+                                CL_TRUE,
+                                0,
+                                total_num * sizeof(tinymt64wp_t),
+                                status);
+    }
+}
+
 /**
  * parsing command line options
  *@param argc number of arguments
@@ -821,6 +884,21 @@ static bool parse_opt(int argc, char **argv) {
             cerr << strerror(errno) << endl;
             break;
         }
+        if (argc > 5 && !parse_layout(argv[5], &layout)) {
+            error = true;
+            cerr << "layout error!" << endl;
+            break;
+        }
+        if (argc > 6) {
+            std::string form = argv[6];
+            if (form == "soa") {
+                status_soa = true;
+            } else if (form != "aos") {
+                error = true;
+                cerr << "status form error!" << endl;
+                break;
+            }
+        }
         if (!filename.empty()) {
             ifstream ifs(filename.c_str());
             if (ifs) {
@@ -835,11 +913,18 @@ static bool parse_opt(int argc, char **argv) {
     }
     if (error) {
         cerr << pgm
-             << " paramfile group-num local-num data-count" << endl;
-        cerr << "paramfile   parameter file of tinymt." << endl;
+             << " paramfile group-num local-num data-count [layout [aos|soa]]"
+             << endl;
+        cerr << "paramfile   parameter file of tinymt, or binary parameter file"
+             << endl
+             << "            made by param_convert." << endl;
         cerr << "group-num   group number of kernel call." << endl;
         cerr << "local-num   local item number of kernel cal." << endl;
         cerr << "data-count  generate random number count." << endl;
+        cerr << "layout      output layout, interleaved or blocked." << endl;
+        cerr << "aos|soa     form of kernel side status, array of structures"
+             << endl
+             << "            or structure of arrays." << endl;
         return false;
     }
 #if defined(DEBUG)
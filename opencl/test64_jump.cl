@@ -74,11 +74,13 @@ tinymt_init_array_kernel(__global tinymt64j_t * d_status,
  * @param d_status internal state of kernel side tinymt
  * @param d_data output
  * @param size number of output data requested.
+ * @param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
  */
 __kernel void
 tinymt_uint64_kernel(__global tinymt64j_t * d_status,
 		     __global ulong* d_data,
-		     int size)
+		     int size,
+		     int layout)
 {
     const size_t id = tinymt_get_sequential_id();
     const size_t global_size = tinymt_get_sequential_size();
@@ -86,7 +88,8 @@ tinymt_uint64_kernel(__global tinymt64j_t * d_status,
 
     tinymt64j_status_read(&tiny, d_status);
     for (int i = 0; i < size; i++) {
-	d_data[global_size * i + id] = tinymt64j_uint64(&tiny);
+	d_data[tinymt_layout_index(layout, id, global_size, size, i)]
+	    = tinymt64j_uint64(&tiny);
     }
     tinymt64j_status_write(d_status, &tiny);
 }
@@ -99,11 +102,13 @@ tinymt_uint64_kernel(__global tinymt64j_t * d_status,
  * @param d_status internal state of kernel side tinymt
  * @param d_data output
  * @param size number of output data requested.
+ * @param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
  */
 __kernel void
 tinymt_double12_kernel(__global tinymt64j_t * d_status,
 		       __global double * d_data,
-		       int size)
+		       int size,
+		       int layout)
 {
     const size_t id = tinymt_get_sequential_id();
     const size_t sequential_size = tinymt_get_sequential_size();
@@ -111,7 +116,8 @@ tinymt_double12_kernel(__global tinymt64j_t * d_status,
 
     tinymt64j_status_read(&tiny, d_status);
     for (int i = 0; i < size; i++) {
-	d_data[sequential_size * i + id] = tinymt64j_double12(&tiny);
+	d_data[tinymt_layout_index(layout, id, sequential_size, size, i)]
+	    = tinymt64j_double12(&tiny);
     }
     tinymt64j_status_write(d_status, &tiny);
 }
@@ -123,11 +129,13 @@ tinymt_double12_kernel(__global tinymt64j_t * d_status,
  * @param d_status internal state of kernel side tinymt
  * @param d_data output
  * @param size number of output data requested.
+ * @param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
  */
 __kernel void
 tinymt_double01_kernel(__global tinymt64j_t * d_status,
 		       __global double * d_data,
-		       int size)
+		       int size,
+		       int layout)
 {
     const size_t id = tinymt_get_sequential_id();
     const size_t sequential_size = tinymt_get_sequential_size();
@@ -135,7 +143,8 @@ tinymt_double01_kernel(__global tinymt64j_t * d_status,
 
     tinymt64j_status_read(&tiny, d_status);
     for (int i = 0; i < size; i++) {
-	d_data[sequential_size * i + id] = tinymt64j_double01(&tiny);
+	d_data[tinymt_layout_index(layout, id, sequential_size, size, i)]
+	    = tinymt64j_double01(&tiny);
     }
     tinymt64j_status_write(d_status, &tiny);
 }
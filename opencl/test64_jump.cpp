@@ -44,6 +44,7 @@ std::string errorMessage;
 static int group_num;
 static int local_num;
 static int data_count;
+static int layout = TINYMT_LAYOUT_INTERLEAVED;
 static tinymt64_t * tinymt64;
 static const uint64_t tinymt64j_mag = UINT64_C(12157665459056928801);
 static const char * tinymt64j_characteristic = "945e0ad4a30ec19432dfa9d5959e5d5d";
@@ -321,6 +322,7 @@ static void generate_uint64(Buffer& tinymt_status,
     uint_kernel.setArg(0, tinymt_status);
     uint_kernel.setArg(1, output_buffer);
     uint_kernel.setArg(2, data_size / total_num);
+    uint_kernel.setArg(3, layout);
     NDRange global(total_num);
     NDRange local(local_num);
     Event generate_event;
@@ -342,7 +344,7 @@ static void generate_uint64(Buffer& tinymt_status,
                             output);
     check_data(output, data_size, total_num);
 #if defined(DEBUG)
-    print_uint64(output, data_size, total_num);
+    print_uint64(output, data_size, total_num, layout);
 #endif
     double time = get_time(generate_event);
     cout << "generate time:" << time * 1000 << "ms" << endl;
@@ -376,6 +378,7 @@ static void generate_double12(Buffer& tinymt_status,
     double_kernel.setArg(0, tinymt_status);
     double_kernel.setArg(1, output_buffer);
     double_kernel.setArg(2, data_size / total_num);
+    double_kernel.setArg(3, layout);
     NDRange global(total_num);
     NDRange local(local_num);
     Event generate_event;
@@ -394,7 +397,7 @@ static void generate_double12(Buffer& tinymt_status,
                             &output[0]);
     check_data12(output, data_size, total_num);
 #if defined(DEBUG)
-    print_double(&output[0], data_size, total_num);
+    print_double(&output[0], data_size, total_num, layout);
 #endif
     double time = get_time(generate_event);
     delete[] output;
@@ -425,6 +428,7 @@ static void generate_double01(Buffer& tinymt_status,
     double_kernel.setArg(0, tinymt_status);
     double_kernel.setArg(1, output_buffer);
     double_kernel.setArg(2, data_size / total_num);
+    double_kernel.setArg(3, layout);
     NDRange global(total_num);
     NDRange local(local_num);
     Event generate_event;
@@ -443,7 +447,7 @@ static void generate_double01(Buffer& tinymt_status,
                             &output[0]);
     check_data01(output, data_size, total_num);
 #if defined(DEBUG)
-    print_double(&output[0], data_size, local_num);
+    print_double(&output[0], data_size, total_num, layout);
 #endif
     double time = get_time(generate_event);
     delete[] output;
@@ -541,6 +545,7 @@ static void check_data(uint64_t * h_data,
     cout << "check_data start" << endl;
 #endif
     int size = num_data / total_num;
+    tinymt_output_view<uint64_t> view(h_data, total_num, size, layout);
 #if defined(DEBUG)
     cout << "size = " << dec << size << endl;
 #endif
@@ -550,10 +555,10 @@ static void check_data(uint64_t * h_data,
         int count = 0;
         for (int j = 0; j < size; j++) {
             uint64_t r = tinymt64_generate_uint64(&tinymt64[i]);
-            if ((h_data[j * total_num + i] != r) && disp_flg) {
+            if ((view(i, j) != r) && disp_flg) {
                 cout << "mismatch i = " << dec << i
                      << " j = " << dec << j
-                     << " data = " << hex << h_data[j * total_num + i]
+                     << " data = " << hex << view(i, j)
                      << " r = " << hex << r << endl;
                 cout << "check_data check N.G!" << endl;
                 count++;
@@ -588,6 +593,7 @@ static void check_data12(double * h_data,
     cout << "check_data start" << endl;
 #endif
     int size = num_data / total_num;
+    tinymt_output_view<double> view(h_data, total_num, size, layout);
 #if defined(DEBUG)
     cout << "size = " << dec << size << endl;
 #endif
@@ -597,13 +603,13 @@ static void check_data12(double * h_data,
         int count = 0;
         for (int j = 0; j < size; j++) {
             double r = tinymt64_generate_double12(&tinymt64[i]);
-            double d = h_data[j * total_num + i];
+            double d = view(i, j);
             bool ok = (-FLT_EPSILON <= (r - d))
                 && ((r - d) <= FLT_EPSILON);
             if (!ok && disp_flg) {
                 cout << "mismatch i = " << dec << i
                      << " j = " << dec << j
-                     << " data = " << dec << h_data[j * total_num + i]
+                     << " data = " << dec << view(i, j)
                      << " r = " << dec << r << endl;
                 cout << "check_data check N.G!" << endl;
                 count++;
@@ -638,6 +644,7 @@ static void check_data01(double * h_data,
     cout << "check_data start" << endl;
 #endif
     int size = num_data / total_num;
+    tinymt_output_view<double> view(h_data, total_num, size, layout);
 #if defined(DEBUG)
     cout << "size = " << dec << size << endl;
 #endif
@@ -647,13 +654,13 @@ static void check_data01(double * h_data,
         int count = 0;
         for (int j = 0; j < size; j++) {
             double r = tinymt64_generate_double(&tinymt64[i]);
-            double d = h_data[j * total_num + i];
+            double d = view(i, j);
             bool ok = (-FLT_EPSILON <= (r - d))
                 && ((r - d) <= FLT_EPSILON);
             if (!ok && disp_flg) {
                 cout << "mismatch i = " << dec << i
                      << " j = " << dec << j
-                     << " data = " << dec << h_data[j * total_num + i]
+                     << " data = " << dec << view(i, j)
                      << " r = " << dec << r << endl;
                 cout << "check_data check N.G!" << endl;
                 count++;
@@ -809,14 +816,20 @@ static bool parse_opt(int argc, char **argv)
             cerr << strerror(errno) << endl;
             break;
         }
+        if (argc > 4 && !parse_layout(argv[4], &layout)) {
+            error = true;
+            cerr << "layout error!" << endl;
+            break;
+        }
         break;
     }
     if (error) {
         cerr << pgm
-             << " group-num local-num data-count" << endl;
+             << " group-num local-num data-count [layout]" << endl;
         cerr << "group-num   group number of kernel call." << endl;
         cerr << "local-num   local item number of kernel cal." << endl;
         cerr << "data-count  generate random number count." << endl;
+        cerr << "layout      output layout, interleaved or blocked." << endl;
         return false;
     }
 #if defined(DEBUG)
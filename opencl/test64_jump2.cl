@@ -21,25 +21,52 @@
  * kernel function.
  * This function initialize internal state of tinymt64.
  *
+ * The first work item of a work group jumps to the state of its id,
+ * and other work items get their states by doubling in local memory:
+ * in round i, work items from 0 to 2<sup>i</sup> - 1 jump
+ * 2<sup>i</sup> steps and give the states to work items from
+ * 2<sup>i</sup> to 2<sup>i+1</sup> - 1. Each work item jumps at most
+ * once except the first one, and the states are same as jumping by
+ * each bit of id.
+ * NDRange should be one dimensional.
+ *
  * @param d_status internal state of kernel side tinymt
  * @param jump_table jump_table for initial jump
  * @param seed seed for initialization
+ * @param l_status local memory of local size tinymt64j_t
  */
 __kernel void
 tinymt_init_seed_kernel(__global tinymt64j_t * d_status,
 			__constant uint * jump_table,
-			ulong seed)
+			ulong seed,
+			__local tinymt64j_t * l_status)
 {
+    const size_t local_id = get_local_id(0);
+    const size_t local_size = get_local_size(0);
     tinymt64j_t tiny;
-    size_t gid = tinymt_get_sequential_id();
 
-    tinymt64j_init_seed(&tiny, seed);
-    for (int i = 0; gid != 0; i++) {
-        if ((gid & 1) != 0) {
-            tinymt64j_jump_by_array(&tiny, &jump_table[i * 4]);
-        }
-        gid = gid >> 1;
+    if (local_id == 0) {
+	size_t gid = tinymt_get_sequential_id();
+	tinymt64j_init_seed(&tiny, seed);
+	for (int i = 0; gid != 0; i++) {
+	    if ((gid & 1) != 0) {
+		tinymt64j_jump_by_array(&tiny, &jump_table[i * 4]);
+	    }
+	    gid = gid >> 1;
+	}
+	l_status[0] = tiny;
+    }
+    for (int i = 0; ((size_t)1 << i) < local_size; i++) {
+	const size_t step = (size_t)1 << i;
+	barrier(CLK_LOCAL_MEM_FENCE);
+	if (local_id < step && local_id + step < local_size) {
+	    tiny = l_status[local_id];
+	    tinymt64j_jump_by_array(&tiny, &jump_table[i * 4]);
+	    l_status[local_id + step] = tiny;
+	}
     }
+    barrier(CLK_LOCAL_MEM_FENCE);
+    tiny = l_status[local_id];
     tinymt64j_status_write(d_status, &tiny);
 }
 
@@ -69,11 +96,13 @@ tinymt_jump_kernel(__global tinymt64j_t * d_status,
  * @param d_status internal state of kernel side tinymt
  * @param d_data output
  * @param size number of output data for a work item.
+ * @param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
  */
 __kernel void
 tinymt_uint64_kernel(__global tinymt64j_t * d_status,
 		     __global ulong * d_data,
-		     int size)
+		     int size,
+		     int layout)
 {
     const size_t id = tinymt_get_sequential_id();
     const size_t global_size = tinymt_get_sequential_size();
@@ -81,7 +110,8 @@ tinymt_uint64_kernel(__global tinymt64j_t * d_status,
 
     tinymt64j_status_read(&tiny, d_status);
     for (int i = 0; i < size; i++) {
-	d_data[size * id + i] = tinymt64j_uint64(&tiny);
+	d_data[tinymt_layout_index(layout, id, global_size, size, i)]
+	    = tinymt64j_uint64(&tiny);
     }
     tinymt64j_status_write(d_status, &tiny);
 }
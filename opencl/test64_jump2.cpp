@@ -51,6 +51,7 @@ std::string errorMessage;
 static cl_int group_num;
 static cl_int local_num;
 static cl_long data_count;
+static int layout = TINYMT_LAYOUT_BLOCKED;
 static tinymt64_t tiny;
 static const char * tinymt64j_characteristic = "945e0ad4a30ec19432dfa9d5959e5d5d";
 /* =========================
@@ -338,6 +339,7 @@ static void initialize_by_seed(Buffer& status_buffer,
     init_kernel.setArg(0, status_buffer);
     init_kernel.setArg(1, jump_table_buffer);
     init_kernel.setArg(2, seed);
+    init_kernel.setArg(3, sizeof(tinymt64j_t) * local_num, NULL);
     NDRange global(total_num);
     NDRange local(local_num);
     Event event;
@@ -418,6 +420,7 @@ static void generate_uint64(Buffer& status_buffer,
     uint_kernel.setArg(0, status_buffer);
     uint_kernel.setArg(1, output_buffer);
     uint_kernel.setArg(2, data_size / total_num);
+    uint_kernel.setArg(3, layout);
     NDRange global(total_num);
     NDRange local(local_num);
     Event generate_event;
@@ -455,7 +458,7 @@ static void generate_uint64(Buffer& status_buffer,
 #endif
     check_data(output, data_size, total_num);
 #if defined(DEBUG)
-    print_uint64(&output[0], data_size, total_num);
+    print_uint64(&output[0], data_size, total_num, layout);
 #endif
     double time = get_time(generate_event);
     cout << "generate time:" << time * 1000 << "ms" << endl;
@@ -505,13 +508,16 @@ static void check_data(uint64_t * h_data, int num_data, int total_num)
     bool disp_flg = true;
     int count = 0;
     int data_per_thread = num_data / total_num;
+    tinymt_output_view<uint64_t> view(h_data, total_num, data_per_thread,
+                                      layout);
     int j;
     for (j = 0; j < num_data; j++) {
+        uint64_t d = view(j / data_per_thread, j % data_per_thread);
         uint64_t r = tinymt64_generate_uint64(&tiny);
-        if ((h_data[j] != r) && disp_flg) {
+        if ((d != r) && disp_flg) {
             cout << "mismatch"
                  << " j = " << dec << j
-                 << " data = " << hex << h_data[j]
+                 << " data = " << hex << d
                  << " r = " << hex << r << endl;
             cout << "check_data check N.G!" << endl;
             cout << "data_per_thread:" << dec << data_per_thread << endl;
@@ -601,14 +607,20 @@ static bool parse_opt(int argc, char **argv)
             cerr << strerror(errno) << endl;
             break;
         }
+        if (argc > 4 && !parse_layout(argv[4], &layout)) {
+            error = true;
+            cerr << "layout error!" << endl;
+            break;
+        }
         break;
     }
     if (error) {
         cerr << pgm
-             << " group-num local-num data-count" << endl;
+             << " group-num local-num data-count [layout]" << endl;
         cerr << "group-num   group number of kernel call." << endl;
         cerr << "local-num   local item number of kernel cal." << endl;
         cerr << "data-count  generate random number count." << endl;
+        cerr << "layout      output layout, interleaved or blocked." << endl;
         return false;
     }
 #if defined(DEBUG)
@@ -5,13 +5,103 @@
 #include <inttypes.h>
 #include <iostream>
 #include <iomanip>
+#include <cstring>
+#include "tinymt_layout.h"
 
 #define TINYMT32_MEXP 127
 #define TINYMT32_MASK UINT32_C(0x7fffffff)
 
-static inline void print_uint32(uint32_t data[], int size, int item_num)
+/**
+ * view of output of generation kernels in host memory.
+ * Output i of work item id is accessed in place, without transposing
+ * the buffer, whichever layout the kernel wrote.
+ */
+template<typename T>
+class tinymt_output_view {
+public:
+    /**
+     * constructor
+     *@param data output copied from device
+     *@param total_num total number of work items
+     *@param size number of outputs of a work item
+     *@param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
+     */
+    tinymt_output_view(const T * data, int total_num, int size, int layout)
+        : data(data), total_num(total_num), size(size), layout(layout) {
+    }
+    /**
+     * output i of work item id
+     *@param id sequential id of work item
+     *@param i index of output in the work item
+     *@return output
+     */
+    const T& operator()(int id, int i) const {
+        return data[tinymt_layout_index(layout, id, total_num, size, i)];
+    }
+    /**
+     * first output of work item id. Outputs of the work item are
+     * stream(id)[0], stream(id)[stride()], stream(id)[2 * stride()], ...
+     *@param id sequential id of work item
+     *@return pointer to the first output
+     */
+    const T * stream(int id) const {
+        return &data[tinymt_layout_index(layout, id, total_num, size, 0)];
+    }
+    /**
+     * distance between consecutive outputs of a work item
+     *@return 1 for blocked layout, total_num for interleaved layout
+     */
+    int stride() const {
+        if (layout == TINYMT_LAYOUT_BLOCKED) {
+            return 1;
+        } else {
+            return total_num;
+        }
+    }
+private:
+    const T * data;
+    int total_num;
+    int size;
+    int layout;
+};
+
+/**
+ * parse name of output layout
+ *@param str "interleaved" or "blocked"
+ *@param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
+ *@return true if str is a name of layout
+ */
+static inline bool parse_layout(const char * str, int * layout)
+{
+    if (strcmp(str, "interleaved") == 0) {
+        *layout = TINYMT_LAYOUT_INTERLEAVED;
+        return true;
+    } else if (strcmp(str, "blocked") == 0) {
+        *layout = TINYMT_LAYOUT_BLOCKED;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * name of output layout
+ *@param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
+ *@return name of layout
+ */
+static inline const char * layout_name(int layout)
+{
+    if (layout == TINYMT_LAYOUT_BLOCKED) {
+        return "blocked";
+    } else {
+        return "interleaved";
+    }
+}
+
+static inline void print_uint32(uint32_t data[], int size, int item_num,
+                                int layout = TINYMT_LAYOUT_INTERLEAVED)
 {
     using namespace std;
+    tinymt_output_view<uint32_t> view(data, item_num, size / item_num, layout);
 
     int max_seq = 10;
     int max_item = 6;
@@ -23,15 +113,17 @@ static inline void print_uint32(uint32_t data[], int size, int item_num)
     }
     for (int i = 0; i < max_seq; i++) {
 	for (int j = 0; j < max_item; j++) {
-	    cout << setw(10) << dec << data[item_num * i + j] << " ";
+	    cout << setw(10) << dec << view(j, i) << " ";
 	}
 	cout << endl;
     }
 }
 
-static inline void print_float(float data[], int size, int item_num)
+static inline void print_float(float data[], int size, int item_num,
+                               int layout = TINYMT_LAYOUT_INTERLEAVED)
 {
     using namespace std;
+    tinymt_output_view<float> view(data, item_num, size / item_num, layout);
 
     int max_seq = 10;
     int max_item = 6;
@@ -45,15 +137,18 @@ static inline void print_float(float data[], int size, int item_num)
 	for (int j = 0; j < max_item; j++) {
 	    cout << setprecision(9) << setw(12)
 		 << dec << left << setfill(' ')
-		 << data[item_num * i + j] << " ";
+		 << view(j, i) << " ";
 	}
 	cout << endl;
     }
 }
 
-static inline void print_uint64(uint64_t data[], int size, int item_num)
+static inline void print_uint64(uint64_t data[], int size, int item_num,
+                                int layout = TINYMT_LAYOUT_INTERLEAVED)
 {
     using namespace std;
+    tinymt_output_view<uint64_t> view(data, item_num, size / item_num,
+                                      layout);
 
     int max_seq = 10;
     int max_item = 3;
@@ -65,15 +160,17 @@ static inline void print_uint64(uint64_t data[], int size, int item_num)
     }
     for (int i = 0; i < max_seq; i++) {
 	for (int j = 0; j < max_item; j++) {
-	    cout << setw(20) << dec << data[item_num * i + j] << " ";
+	    cout << setw(20) << dec << view(j, i) << " ";
 	}
 	cout << endl;
     }
 }
 
-static inline void print_double(double data[], int size, int item_num)
+static inline void print_double(double data[], int size, int item_num,
+                                int layout = TINYMT_LAYOUT_INTERLEAVED)
 {
     using namespace std;
+    tinymt_output_view<double> view(data, item_num, size / item_num, layout);
 
     int max_seq = 10;
     int max_item = 3;
@@ -87,7 +184,7 @@ static inline void print_double(double data[], int size, int item_num)
 	for (int j = 0; j < max_item; j++) {
 	    cout << setprecision(18) << setw(21)
 		 << dec << left << setfill(' ')
-		 << data[item_num * i + j] << " ";
+		 << view(j, i) << " ";
 	}
 	cout << endl;
     }
@@ -44,6 +44,102 @@ typedef struct TINYMT32J_T {
     cl_uint s3;
 } tinymt32j_t;
 
+/**
+ * Fields of tinymt32wp_t in structure of arrays form, which is used when
+ * kernel program is compiled with TINYMT_STATUS_SOA.
+ * Field f of work item id is at [f * total + id] of a cl_uint array,
+ * where total is the number of work items.
+ */
+#define TINYMT32WP_SOA_S0 0
+#define TINYMT32WP_SOA_S1 1
+#define TINYMT32WP_SOA_S2 2
+#define TINYMT32WP_SOA_S3 3
+#define TINYMT32WP_SOA_MAT1 4
+#define TINYMT32WP_SOA_MAT2 5
+#define TINYMT32WP_SOA_TMAT 6
+#define TINYMT32WP_SOA_FIELDS 7
+
+#if !defined(KERNEL_PROGRAM)
+#include "tinymt32.h"
+
+/**
+ * convert array of tinymt32wp_t to structure of arrays form.
+ * @param soa output, TINYMT32WP_SOA_FIELDS * total elements
+ * @param aos input
+ * @param total number of work items
+ */
+inline static void tinymt32wp_to_soa(cl_uint soa[],
+                                     const tinymt32wp_t aos[],
+                                     int total)
+{
+    for (int i = 0; i < total; i++) {
+        soa[TINYMT32WP_SOA_S0 * total + i] = aos[i].s0;
+        soa[TINYMT32WP_SOA_S1 * total + i] = aos[i].s1;
+        soa[TINYMT32WP_SOA_S2 * total + i] = aos[i].s2;
+        soa[TINYMT32WP_SOA_S3 * total + i] = aos[i].s3;
+        soa[TINYMT32WP_SOA_MAT1 * total + i] = aos[i].mat1;
+        soa[TINYMT32WP_SOA_MAT2 * total + i] = aos[i].mat2;
+        soa[TINYMT32WP_SOA_TMAT * total + i] = aos[i].tmat;
+    }
+}
+
+/**
+ * convert structure of arrays form to array of tinymt32wp_t.
+ * @param aos output
+ * @param soa input, TINYMT32WP_SOA_FIELDS * total elements
+ * @param total number of work items
+ */
+inline static void tinymt32wp_from_soa(tinymt32wp_t aos[],
+                                       const cl_uint soa[],
+                                       int total)
+{
+    for (int i = 0; i < total; i++) {
+        aos[i].s0 = soa[TINYMT32WP_SOA_S0 * total + i];
+        aos[i].s1 = soa[TINYMT32WP_SOA_S1 * total + i];
+        aos[i].s2 = soa[TINYMT32WP_SOA_S2 * total + i];
+        aos[i].s3 = soa[TINYMT32WP_SOA_S3 * total + i];
+        aos[i].mat1 = soa[TINYMT32WP_SOA_MAT1 * total + i];
+        aos[i].mat2 = soa[TINYMT32WP_SOA_MAT2 * total + i];
+        aos[i].tmat = soa[TINYMT32WP_SOA_TMAT * total + i];
+    }
+}
+
+/**
+ * convert tinymt32_t of the host library to tinymt32wp_t, for example,
+ * a state restored from snapshot, see tinymt_snapshot.h.
+ * @param wp output
+ * @param random tinymt internal status
+ */
+inline static void tinymt32wp_from_tinymt32(tinymt32wp_t * wp,
+                                           const tinymt32_t * random)
+{
+    wp->s0 = random->status[0];
+    wp->s1 = random->status[1];
+    wp->s2 = random->status[2];
+    wp->s3 = random->status[3];
+    wp->mat1 = random->mat1;
+    wp->mat2 = random->mat2;
+    wp->tmat = random->tmat;
+}
+
+/**
+ * convert tinymt32wp_t to tinymt32_t of the host library.
+ * @param random output, tinymt internal status
+ * @param wp input
+ */
+inline static void tinymt32wp_to_tinymt32(tinymt32_t * random,
+                                         const tinymt32wp_t * wp)
+{
+    random->status[0] = wp->s0;
+    random->status[1] = wp->s1;
+    random->status[2] = wp->s2;
+    random->status[3] = wp->s3;
+    random->mat1 = wp->mat1;
+    random->mat2 = wp->mat2;
+    random->tmat = wp->tmat;
+}
+#endif
+
 #define TINYMT32J_MAT1 0x8f7011eeU
 #define TINYMT32J_MAT2 0xfc78ff1fU
 #define TINYMT32J_TMAT 0x3793fdffU
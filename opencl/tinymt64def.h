@@ -46,6 +46,100 @@ typedef struct TINYMT64J_T {
     cl_ulong s1;
 } tinymt64j_t;
 
+/**
+ * Fields of tinymt64wp_t in structure of arrays form, which is used when
+ * kernel program is compiled with TINYMT_STATUS_SOA.
+ * 64-bit field f of work item id is at [f * total + id] of a cl_ulong
+ * array, where total is the number of work items, and 32-bit field f
+ * is at [f * total + id] of a cl_uint array which follows
+ * TINYMT64WP_SOA_FIELDS64 * total elements of cl_ulong.
+ * The size of the buffer is the same as that of tinymt64wp_t[total].
+ */
+#define TINYMT64WP_SOA_S0 0
+#define TINYMT64WP_SOA_S1 1
+#define TINYMT64WP_SOA_TMAT 2
+#define TINYMT64WP_SOA_FIELDS64 3
+#define TINYMT64WP_SOA_MAT1 0
+#define TINYMT64WP_SOA_MAT2 1
+/** size of the state of a work item in cl_ulong */
+#define TINYMT64WP_SOA_SIZE64 4
+
+#if !defined(KERNEL_PROGRAM)
+#include "tinymt64.h"
+
+/**
+ * convert array of tinymt64wp_t to structure of arrays form.
+ * @param soa output, TINYMT64WP_SOA_SIZE64 * total elements
+ * @param aos input
+ * @param total number of work items
+ */
+inline static void tinymt64wp_to_soa(cl_ulong soa[],
+                                     const tinymt64wp_t aos[],
+                                     int total)
+{
+    cl_uint * soa32 = (cl_uint *)&soa[TINYMT64WP_SOA_FIELDS64 * total];
+    for (int i = 0; i < total; i++) {
+        soa[TINYMT64WP_SOA_S0 * total + i] = aos[i].s0;
+        soa[TINYMT64WP_SOA_S1 * total + i] = aos[i].s1;
+        soa[TINYMT64WP_SOA_TMAT * total + i] = aos[i].tmat;
+        soa32[TINYMT64WP_SOA_MAT1 * total + i] = aos[i].mat1;
+        soa32[TINYMT64WP_SOA_MAT2 * total + i] = aos[i].mat2;
+    }
+}
+
+/**
+ * convert structure of arrays form to array of tinymt64wp_t.
+ * @param aos output
+ * @param soa input, TINYMT64WP_SOA_SIZE64 * total elements
+ * @param total number of work items
+ */
+inline static void tinymt64wp_from_soa(tinymt64wp_t aos[],
+                                       const cl_ulong soa[],
+                                       int total)
+{
+    const cl_uint * soa32
+        = (const cl_uint *)&soa[TINYMT64WP_SOA_FIELDS64 * total];
+    for (int i = 0; i < total; i++) {
+        aos[i].s0 = soa[TINYMT64WP_SOA_S0 * total + i];
+        aos[i].s1 = soa[TINYMT64WP_SOA_S1 * total + i];
+        aos[i].tmat = soa[TINYMT64WP_SOA_TMAT * total + i];
+        aos[i].mat1 = soa32[TINYMT64WP_SOA_MAT1 * total + i];
+        aos[i].mat2 = soa32[TINYMT64WP_SOA_MAT2 * total + i];
+    }
+}
+
+/**
+ * convert tinymt64_t of the host library to tinymt64wp_t, for example,
+ * a state restored from snapshot, see tinymt_snapshot.h.
+ * @param wp output
+ * @param random tinymt internal status
+ */
+inline static void tinymt64wp_from_tinymt64(tinymt64wp_t * wp,
+                                           const tinymt64_t * random)
+{
+    wp->s0 = random->status[0];
+    wp->s1 = random->status[1];
+    wp->mat1 = random->mat1;
+    wp->mat2 = random->mat2;
+    wp->tmat = random->tmat;
+}
+
+/**
+ * convert tinymt64wp_t to tinymt64_t of the host library.
+ * @param random output, tinymt internal status
+ * @param wp input
+ */
+inline static void tinymt64wp_to_tinymt64(tinymt64_t * random,
+                                         const tinymt64wp_t * wp)
+{
+    random->status[0] = wp->s0;
+    random->status[1] = wp->s1;
+    random->mat1 = wp->mat1;
+    random->mat2 = wp->mat2;
+    random->tmat = wp->tmat;
+}
+#endif
+
 #define TINYMT64J_MAT1 0xfa051f40U
 #define TINYMT64J_MAT2 0xffd0fff4U;
 #define TINYMT64J_TMAT UINT64_C(0x58d02ffeffbfffbc)
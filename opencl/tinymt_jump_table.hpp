@@ -0,0 +1,115 @@
+#ifndef TINYMT_JUMP_TABLE_HPP
+#define TINYMT_JUMP_TABLE_HPP
+/**
+ * @file tinymt_jump_table.hpp
+ *
+ * @brief jump tables calculated on device.
+ *
+ * Functions in this file read characteristic polynomials from parameter
+ * files and calculate jump tables by tinymt_jump_table_kernel in test32.cl
+ * and test64.cl, for parameter sets which have no table in
+ * tinymt32_jump_table.clh or tinymt64_jump_table.clh.
+ *
+ * Jump tables of all parameter sets are in one buffer, and the table of
+ * one parameter set is copied to a small buffer by copyJumpTable, which
+ * is passed as a __constant argument of tinymt_init_jump_kernel.
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and The University of Tokyo.
+ * All rights reserved.
+ *
+ * The new BSD License is applied to this software, see LICENSE.txt
+ */
+#include <string>
+#include <stdint.h>
+#include "opencl_tools.hpp"
+#include "file_reader.h"
+
+/** number of entries of jump table, same as tinymt_jump_poly.clh */
+#define TINYMT_JUMP_TABLE_SIZE 32
+/** number of uints of a jump table */
+#define TINYMT_JUMP_TABLE_WORDS (TINYMT_JUMP_TABLE_SIZE * 4)
+/** step of tinymt32_jump_table.clh and tinymt64_jump_table.clh, 3^40 */
+#define TINYMT_JUMP_STEP UINT64_C(12157665459056928801)
+
+/**
+ * read characteristic polynomials from parameter file.
+ *@param characteristic output, 4 * num uints
+ *@param filename parameter file of tinymt32 or tinymt64
+ *@param num number of parameter sets
+ */
+static inline void readCharacteristics(uint32_t characteristic[],
+                                       const std::string& filename,
+                                       int num)
+{
+    tinymt::file_reader fr(filename);
+    for (int i = 0; i < num; i++) {
+        fr.get_characteristic(&characteristic[4 * i]);
+    }
+}
+
+/**
+ * calculate jump tables of parameter sets on device.
+ * The program should have tinymt_jump_table_kernel.
+ *@param context context of the device
+ *@param q command queue of the device
+ *@param program built program
+ *@param characteristic characteristic polynomials, 4 * num uints
+ *@param num number of parameter sets
+ *@param local_num number of local work items
+ *@param step step of jump between adjacent sequential ids
+ *@return buffer of num jump tables
+ */
+static inline cl::Buffer makeJumpTables(cl::Context& context,
+                                        cl::CommandQueue& q,
+                                        cl::Program& program,
+                                        const uint32_t characteristic[],
+                                        int num,
+                                        int local_num,
+                                        uint64_t step = TINYMT_JUMP_STEP)
+{
+    cl::Buffer poly_buffer(context,
+                           CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                           num * 4 * sizeof(uint32_t),
+                           (void *)characteristic);
+    cl::Buffer table_buffer(context,
+                            CL_MEM_READ_WRITE,
+                            num * TINYMT_JUMP_TABLE_WORDS * sizeof(uint32_t));
+    cl::Kernel kernel(program, "tinymt_jump_table_kernel");
+    kernel.setArg(0, table_buffer);
+    kernel.setArg(1, poly_buffer);
+    kernel.setArg(2, (cl_ulong)step);
+    kernel.setArg(3, num);
+    int global_num = (num + local_num - 1) / local_num * local_num;
+    q.enqueueNDRangeKernel(kernel,
+                           cl::NullRange,
+                           cl::NDRange(global_num),
+                           cl::NDRange(local_num));
+    q.finish();
+    return table_buffer;
+}
+
+/**
+ * copy a jump table to a new buffer for __constant argument.
+ *@param context context of the device
+ *@param q command queue of the device
+ *@param tables buffer of jump tables made by makeJumpTables
+ *@param index index of parameter set
+ *@return buffer of one jump table
+ */
+static inline cl::Buffer copyJumpTable(cl::Context& context,
+                                       cl::CommandQueue& q,
+                                       cl::Buffer& tables,
+                                       int index)
+{
+    const ::size_t bytes = TINYMT_JUMP_TABLE_WORDS * sizeof(uint32_t);
+    cl::Buffer table(context, CL_MEM_READ_ONLY, bytes);
+    q.enqueueCopyBuffer(tables, table, index * bytes, 0, bytes);
+    q.finish();
+    return table;
+}
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef TINYMT_LAYOUT_H
+#define TINYMT_LAYOUT_H
+/**
+ * @file tinymt_layout.h
+ *
+ * @brief Common definitions in host and kernel for output layout.
+ *
+ * Generation kernels write size outputs of each of total work items
+ * into one buffer. In the interleaved layout, output i of work item id
+ * is at total * i + id, and adjacent work items write adjacent
+ * addresses, which is coalesced on GPUs. In the blocked layout, it is
+ * at size * id + i, and outputs of a work item are contiguous, which is
+ * convenient to consume them as one stream.
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and The University of Tokyo.
+ * All rights reserved.
+ *
+ * The new BSD License is applied to this software, see LICENSE.txt
+ */
+
+#define TINYMT_LAYOUT_INTERLEAVED 0
+#define TINYMT_LAYOUT_BLOCKED 1
+
+/**
+ * return the index of output.
+ * @param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
+ * @param id sequential id of work item
+ * @param total number of work items
+ * @param size number of outputs of a work item
+ * @param i index of output in the work item
+ * @return index in output buffer
+ */
+inline static size_t
+tinymt_layout_index(int layout, size_t id, size_t total,
+                    size_t size, size_t i)
+{
+    if (layout == TINYMT_LAYOUT_BLOCKED) {
+        return size * id + i;
+    } else {
+        return total * i + id;
+    }
+}
+
+#endif
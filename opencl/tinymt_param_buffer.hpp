@@ -0,0 +1,147 @@
+#ifndef TINYMT_PARAM_BUFFER_HPP
+#define TINYMT_PARAM_BUFFER_HPP
+/**
+ * @file tinymt_param_buffer.hpp
+ *
+ * @brief status buffers from binary parameter files.
+ *
+ * Functions in this file make status buffers of tinymt32wp_t and
+ * tinymt64wp_t from binary parameter files made by param_convert.
+ * Buffers are allocated in host accessible memory, and parameters are
+ * written into the mapped buffer directly from the memory mapped file,
+ * without parsing and without temporary array.
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and The University of Tokyo.
+ * All rights reserved.
+ *
+ * The new BSD License is applied to this software, see LICENSE.txt
+ */
+#include <stdexcept>
+#include "opencl_tools.hpp"
+#include "tinymt32def.h"
+#include "tinymt64def.h"
+#include "file_reader.h"
+
+/**
+ * check bits and number of parameter sets of binary parameter file
+ *@param reader binary parameter file
+ *@param bits 32 or 64
+ *@param total_num number of work items
+ */
+static inline void checkParamFile(const tinymt::binary_reader& reader,
+                                  int bits,
+                                  int total_num)
+{
+    if (reader.bits() != bits) {
+        throw std::runtime_error("bits of parameter file error");
+    }
+    if (reader.count() < total_num) {
+        throw std::runtime_error("too few parameters in parameter file");
+    }
+}
+
+/**
+ * make status buffer of tinymt32wp_t with parameters of binary
+ * parameter file, internal states are zero.
+ *@param context context of the device
+ *@param q command queue of the device
+ *@param reader binary parameter file of tinymt32
+ *@param total_num number of work items
+ *@param soa true if kernel side status is structure of arrays
+ *@return status buffer
+ */
+static inline cl::Buffer getParamBuffer32(cl::Context& context,
+                                          cl::CommandQueue& q,
+                                          const tinymt::binary_reader& reader,
+                                          int total_num,
+                                          bool soa = false)
+{
+    checkParamFile(reader, 32, total_num);
+    ::size_t bytes = total_num * sizeof(tinymt32wp_t);
+    cl::Buffer buffer(context,
+                      CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR,
+                      bytes);
+    void * p = q.enqueueMapBuffer(buffer, CL_TRUE, CL_MAP_WRITE, 0, bytes);
+    const tinymt::param_record * records = reader.records();
+    if (soa) {
+        cl_uint * s = (cl_uint *)p;
+        for (int i = 0; i < total_num; i++) {
+            s[TINYMT32WP_SOA_S0 * total_num + i] = 0;
+            s[TINYMT32WP_SOA_S1 * total_num + i] = 0;
+            s[TINYMT32WP_SOA_S2 * total_num + i] = 0;
+            s[TINYMT32WP_SOA_S3 * total_num + i] = 0;
+            s[TINYMT32WP_SOA_MAT1 * total_num + i] = records[i].mat1;
+            s[TINYMT32WP_SOA_MAT2 * total_num + i] = records[i].mat2;
+            s[TINYMT32WP_SOA_TMAT * total_num + i]
+                = (cl_uint)records[i].tmat;
+        }
+    } else {
+        tinymt32wp_t * a = (tinymt32wp_t *)p;
+        for (int i = 0; i < total_num; i++) {
+            a[i].s0 = 0;
+            a[i].s1 = 0;
+            a[i].s2 = 0;
+            a[i].s3 = 0;
+            a[i].mat1 = records[i].mat1;
+            a[i].mat2 = records[i].mat2;
+            a[i].tmat = (cl_uint)records[i].tmat;
+        }
+    }
+    q.enqueueUnmapMemObject(buffer, p);
+    q.finish();
+    return buffer;
+}
+
+/**
+ * make status buffer of tinymt64wp_t with parameters of binary
+ * parameter file, internal states are zero.
+ *@param context context of the device
+ *@param q command queue of the device
+ *@param reader binary parameter file of tinymt64
+ *@param total_num number of work items
+ *@param soa true if kernel side status is structure of arrays
+ *@return status buffer
+ */
+static inline cl::Buffer getParamBuffer64(cl::Context& context,
+                                          cl::CommandQueue& q,
+                                          const tinymt::binary_reader& reader,
+                                          int total_num,
+                                          bool soa = false)
+{
+    checkParamFile(reader, 64, total_num);
+    ::size_t bytes = total_num * sizeof(tinymt64wp_t);
+    cl::Buffer buffer(context,
+                      CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR,
+                      bytes);
+    void * p = q.enqueueMapBuffer(buffer, CL_TRUE, CL_MAP_WRITE, 0, bytes);
+    const tinymt::param_record * records = reader.records();
+    if (soa) {
+        cl_ulong * s = (cl_ulong *)p;
+        cl_uint * s32 = (cl_uint *)&s[TINYMT64WP_SOA_FIELDS64 * total_num];
+        for (int i = 0; i < total_num; i++) {
+            s[TINYMT64WP_SOA_S0 * total_num + i] = 0;
+            s[TINYMT64WP_SOA_S1 * total_num + i] = 0;
+            s[TINYMT64WP_SOA_TMAT * total_num + i] = records[i].tmat;
+            s32[TINYMT64WP_SOA_MAT1 * total_num + i] = records[i].mat1;
+            s32[TINYMT64WP_SOA_MAT2 * total_num + i] = records[i].mat2;
+        }
+    } else {
+        tinymt64wp_t * a = (tinymt64wp_t *)p;
+        for (int i = 0; i < total_num; i++) {
+            a[i].s0 = 0;
+            a[i].s1 = 0;
+            a[i].mat1 = records[i].mat1;
+            a[i].mat2 = records[i].mat2;
+            a[i].tmat = records[i].tmat;
+        }
+    }
+    q.enqueueUnmapMemObject(buffer, p);
+    q.finish();
+    return buffer;
+}
+
+#endif
@@ -0,0 +1,211 @@
+#ifndef TINYMT_STREAM_HPP
+#define TINYMT_STREAM_HPP
+/**
+ * @file tinymt_stream.hpp
+ *
+ * @brief streaming generator on host side.
+ *
+ * tinymt_stream keeps the status of tinymt in device memory, and calls
+ * a generation kernel repeatedly. It has two output buffers on device
+ * and two on host, and uses one command queue for generation and another
+ * for transfer, so that the generation of batch k + 1 overlaps with
+ * the transfer of batch k and consumption of batch k - 1 by host.
+ *
+ * Because of this overlap, generation runs ahead of consumption: after
+ * next() has returned n batches, n + 2 batches have been generated and
+ * the status buffer on device has advanced n + 2 batches. The two
+ * batches in flight are discarded when the stream is destroyed. Callers
+ * who save the status, or continue from it by other kernels, should
+ * take generated() batches into account, not batches().
+ *
+ * The kernel should have arguments (status, output, size, layout),
+ * like tinymt_uint32_kernel in test32.cl and test32_jump.cl.
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and The University of Tokyo.
+ * All rights reserved.
+ *
+ * The new BSD License is applied to this software, see LICENSE.txt
+ */
+#include "opencl_tools.hpp"
+#include "test_common.h"
+
+template<typename T>
+class tinymt_stream {
+public:
+    /**
+     * constructor.
+     * The status buffer should be initialized before the first call of
+     * next(). The first call of next() enqueues generation of two
+     * batches ahead, and the status buffer is updated by them.
+     *@param context context of the device
+     *@param device device
+     *@param program built program which has the kernel
+     *@param kernel_name name of generation kernel
+     *@param status status buffer, shared with the caller
+     *@param total_num total number of work items
+     *@param local_num number of local work items
+     *@param size number of outputs of a work item in a batch
+     *@param layout TINYMT_LAYOUT_INTERLEAVED or TINYMT_LAYOUT_BLOCKED
+     */
+    tinymt_stream(cl::Context& context,
+                  cl::Device& device,
+                  cl::Program& program,
+                  const char * kernel_name,
+                  cl::Buffer& status,
+                  int total_num,
+                  int local_num,
+                  int size,
+                  int layout = TINYMT_LAYOUT_INTERLEAVED)
+        : generate_queue(context, device),
+          transfer_queue(context, device),
+          kernel(program, kernel_name),
+          status(status),
+          total_num(total_num),
+          local_num(local_num),
+          size(size),
+          layout(layout),
+          count(0) {
+        ::size_t bytes = batch_size() * sizeof(T);
+        for (int i = 0; i < 2; i++) {
+            device_buffer[i] = cl::Buffer(context, CL_MEM_WRITE_ONLY, bytes);
+            host_buffer[i] = new T[batch_size()];
+        }
+    }
+
+    ~tinymt_stream() {
+        generate_queue.finish();
+        transfer_queue.finish();
+        for (int i = 0; i < 2; i++) {
+            delete[] host_buffer[i];
+        }
+    }
+
+    /**
+     * number of outputs in a batch
+     *@return total_num * size
+     */
+    int batch_size() const {
+        return total_num * size;
+    }
+
+    /**
+     * wait for the next batch.
+     * The returned buffer is valid until the next call of next(),
+     * meanwhile following batches are generated and transferred.
+     *@return outputs of the batch, in the layout given to constructor
+     */
+    const T * next() {
+        if (count == 0) {
+            enqueue_generate(0);
+            enqueue_generate(1);
+            enqueue_read(0);
+        }
+        int slot = count % 2;
+        read_event[slot].wait();
+        // host buffer of batch count - 1 is released by the caller.
+        enqueue_read(count + 1);
+        // device buffer of batch count is already transferred.
+        enqueue_generate(count + 2);
+        generate_queue.flush();
+        transfer_queue.flush();
+        count++;
+        return host_buffer[slot];
+    }
+
+    /**
+     * view of the batch returned by the last call of next()
+     *@return view
+     */
+    tinymt_output_view<T> view() const {
+        return tinymt_output_view<T>(host_buffer[(count + 1) % 2],
+                                     total_num, size, layout);
+    }
+
+    /**
+     * call consumer for each of batches.
+     * Like std::for_each, consumer is taken by value and returned, so
+     * that its state can be read after the call.
+     *@param batches number of batches
+     *@param consumer function object called as consumer(data, index)
+     *@return consumer after the last call
+     */
+    template<typename F>
+    F for_each(long batches, F consumer) {
+        for (long i = 0; i < batches; i++) {
+            const T * data = next();
+            consumer(data, i);
+        }
+        return consumer;
+    }
+
+    /**
+     * number of batches returned.
+     * This is less than generated() by two after the first next().
+     *@return number of calls of next()
+     */
+    long batches() const {
+        return count;
+    }
+
+    /**
+     * number of batches generated on device, including two batches
+     * which are not yet returned by next().
+     *@return number of batches by which the status buffer is advanced
+     */
+    long generated() const {
+        return count == 0 ? 0 : count + 2;
+    }
+private:
+    cl::CommandQueue generate_queue;
+    cl::CommandQueue transfer_queue;
+    cl::Kernel kernel;
+    cl::Buffer status;
+    cl::Buffer device_buffer[2];
+    T * host_buffer[2];
+    cl::Event generate_event[2];
+    cl::Event read_event[2];
+    int total_num;
+    int local_num;
+    int size;
+    int layout;
+    long count;
+
+    void enqueue_generate(long index) {
+        int slot = index % 2;
+        kernel.setArg(0, status);
+        kernel.setArg(1, device_buffer[slot]);
+        kernel.setArg(2, size);
+        kernel.setArg(3, layout);
+        std::vector<cl::Event> wait;
+        if (index >= 2) {
+            wait.push_back(read_event[slot]);
+        }
+        generate_queue.enqueueNDRangeKernel(kernel,
+                                            cl::NullRange,
+                                            cl::NDRange(total_num),
+                                            cl::NDRange(local_num),
+                                            wait.empty() ? NULL : &wait,
+                                            &generate_event[slot]);
+    }
+
+    void enqueue_read(long index) {
+        int slot = index % 2;
+        std::vector<cl::Event> wait(1, generate_event[slot]);
+        transfer_queue.enqueueReadBuffer(device_buffer[slot],
+                                         CL_FALSE,
+                                         0,
+                                         batch_size() * sizeof(T),
+                                         host_buffer[slot],
+                                         &wait,
+                                         &read_event[slot]);
+    }
+
+    tinymt_stream(const tinymt_stream&);
+    tinymt_stream& operator=(const tinymt_stream&);
+};
+
+#endif
@@ -0,0 +1,381 @@
+/**
+ * Benchmark program for OpenCL
+ * comparing scalar and vectorized generation kernels.
+ *
+ * This program measures tinymt_uint32_kernel and tinymt_uint32x4_kernel
+ * in test32.cl, or tinymt_uint64_kernel and tinymt_uint64x2_kernel in
+ * test64.cl. Both kernels generate the same number of streams from the
+ * same initial status, vectorized kernels by 4 or 2 streams a work item,
+ * and their outputs should be same.
+ * CPU device, for example POCL, can be selected by command line.
+ */
+#define CL_USE_DEPRECATED_OPENCL_1_1_APIS
+#define __CL_ENABLE_EXCEPTIONS
+
+#include <cstddef>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <errno.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "opencl_tools.hpp"
+#include "tinymt32def.h"
+#include "tinymt64def.h"
+#include "test_common.h"
+#include "file_reader.h"
+
+using namespace std;
+using namespace cl;
+
+/* ================== */
+/* OpenCL information */
+/* ================== */
+std::vector<cl::Platform> platforms;
+std::vector<cl::Device> devices;
+cl::Context context;
+std::string programBuffer;
+cl::Program program;
+cl::Program::Sources source;
+cl::CommandQueue queue;
+std::string errorMessage;
+
+/* ========================= */
+/* global variables          */
+/* ========================= */
+static int bits;
+static std::string filename;
+static int group_num;
+static int local_num;
+static int data_count;
+static int repeat = 10;
+static cl_device_type device_type = CL_DEVICE_TYPE_GPU;
+
+/* =========================
+   declaration
+   ========================= */
+static int bench(int argc, char * argv[]);
+static void make_status32(Buffer status[2], int total_num);
+static void make_status64(Buffer status[2], int total_num);
+template<typename T>
+static void init_status(Buffer status[2], int total_num, T seed);
+template<typename T>
+static int bench_kernels(Buffer status[2],
+                         const char * scalar_name,
+                         const char * vector_name,
+                         int width,
+                         int total_num,
+                         int size);
+static bool parse_opt(int argc, char **argv);
+
+/**
+ * main
+ * catch errors
+ *@param argc number of arguments
+ *@param argv array of arguments
+ *@return 0 normal, -1 error
+ */
+int main(int argc, char * argv[])
+{
+    try {
+        return bench(argc, argv);
+    } catch (Error e) {
+        cerr << "Error Code:" << e.err() << endl;
+        cerr << e.what() << endl;
+    } catch (std::string& er) {
+        cerr << er << endl;
+    } catch (...) {
+        cerr << "other error" << endl;
+    }
+    return -1;
+}
+
+/**
+ * benchmark main
+ *@param argc number of arguments
+ *@param argv array of arguments
+ *@return 0 normal, -1 error
+ */
+static int bench(int argc, char * argv[])
+{
+    if (!parse_opt(argc, argv)) {
+        return -1;
+    }
+    platforms = getPlatforms();
+    devices = getDevices(device_type);
+    context = getContext();
+    if (bits == 32) {
+        source = getSource("test32.cl");
+    } else {
+        source = getSource("test64.cl");
+    }
+    std::string option = "-DKERNEL_PROGRAM ";
+    program = getProgram(option.c_str());
+    queue = getCommandQueue();
+    int total_num = group_num * local_num;
+    int size = (data_count + total_num - 1) / total_num;
+    cout << "device:" << devices[0].getInfo<CL_DEVICE_NAME>() << endl;
+    cout << "streams:" << dec << total_num
+         << " outputs per stream:" << size
+         << " repeat:" << repeat << endl;
+    Buffer status[2];
+    int mismatch;
+    if (bits == 32) {
+        make_status32(status, total_num);
+        init_status<uint32_t>(status, total_num, 1234);
+        mismatch = bench_kernels<uint32_t>(status,
+                                           "tinymt_uint32_kernel",
+                                           "tinymt_uint32x4_kernel",
+                                           4, total_num, size);
+    } else {
+        make_status64(status, total_num);
+        init_status<uint64_t>(status, total_num, 1234);
+        mismatch = bench_kernels<uint64_t>(status,
+                                           "tinymt_uint64_kernel",
+                                           "tinymt_uint64x2_kernel",
+                                           2, total_num, size);
+    }
+    if (mismatch != 0) {
+        cout << "vector kernel check N.G!" << endl;
+        return -1;
+    }
+    cout << "vector kernel check O.K!" << endl;
+    return 0;
+}
+
+/**
+ * make two status buffers of tinymt32wp_t with same parameters
+ *@param status output
+ *@param total_num total number of streams
+ */
+static void make_status32(Buffer status[2], int total_num)
+{
+    tinymt::file_reader fr(filename);
+    tinymt32wp_t * params = new tinymt32wp_t[total_num];
+    for (int i = 0; i < total_num; i++) {
+        uint32_t mat1;
+        uint32_t mat2;
+        uint32_t tmat;
+        fr.get(&mat1, &mat2, &tmat);
+        params[i].mat1 = mat1;
+        params[i].mat2 = mat2;
+        params[i].tmat = tmat;
+    }
+    for (int i = 0; i < 2; i++) {
+        status[i] = Buffer(context,
+                           CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+                           total_num * sizeof(tinymt32wp_t),
+                           params);
+    }
+    delete[] params;
+}
+
+/**
+ * make two status buffers of tinymt64wp_t with same parameters
+ *@param status output
+ *@param total_num total number of streams
+ */
+static void make_status64(Buffer status[2], int total_num)
+{
+    tinymt::file_reader fr(filename);
+    tinymt64wp_t * params = new tinymt64wp_t[total_num];
+    for (int i = 0; i < total_num; i++) {
+        uint32_t mat1;
+        uint32_t mat2;
+        uint64_t tmat;
+        fr.get(&mat1, &mat2, &tmat);
+        params[i].mat1 = mat1;
+        params[i].mat2 = mat2;
+        params[i].tmat = tmat;
+    }
+    for (int i = 0; i < 2; i++) {
+        status[i] = Buffer(context,
+                           CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+                           total_num * sizeof(tinymt64wp_t),
+                           params);
+    }
+    delete[] params;
+}
+
+/**
+ * initialize both status buffers by scalar kernel
+ *@param status status buffers
+ *@param total_num total number of streams
+ *@param seed seed for initialization
+ */
+template<typename T>
+static void init_status(Buffer status[2], int total_num, T seed)
+{
+    Kernel init_kernel(program, "tinymt_init_seed_kernel");
+    for (int i = 0; i < 2; i++) {
+        init_kernel.setArg(0, status[i]);
+        init_kernel.setArg(1, seed);
+        queue.enqueueNDRangeKernel(init_kernel,
+                                   NullRange,
+                                   NDRange(total_num),
+                                   NDRange(local_num));
+    }
+    queue.finish();
+}
+
+/**
+ * measure scalar kernel and vectorized kernel, and compare outputs.
+ *@param status status buffers, status[0] for scalar, status[1] for vector
+ *@param scalar_name name of scalar kernel
+ *@param vector_name name of vectorized kernel
+ *@param width number of streams of a work item of vectorized kernel
+ *@param total_num total number of streams
+ *@param size number of outputs of a stream
+ *@return number of mismatches
+ */
+template<typename T>
+static int bench_kernels(Buffer status[2],
+                         const char * scalar_name,
+                         const char * vector_name,
+                         int width,
+                         int total_num,
+                         int size)
+{
+    Kernel kernel[2];
+    kernel[0] = Kernel(program, scalar_name);
+    kernel[1] = Kernel(program, vector_name);
+    int data_size = total_num * size;
+    Buffer output_buffer[2];
+    T * output[2];
+    for (int i = 0; i < 2; i++) {
+        output_buffer[i] = Buffer(context,
+                                  CL_MEM_READ_WRITE,
+                                  data_size * sizeof(T));
+        output[i] = new T[data_size];
+        kernel[i].setArg(0, status[i]);
+        kernel[i].setArg(1, output_buffer[i]);
+        kernel[i].setArg(2, size);
+        kernel[i].setArg(3, (int)TINYMT_LAYOUT_INTERLEAVED);
+    }
+    NDRange global[2] = {NDRange(total_num), NDRange(total_num / width)};
+    NDRange local[2] = {NDRange(local_num), NDRange(local_num / width)};
+    double time[2] = {0, 0};
+    int mismatch = 0;
+    for (int r = 0; r < repeat; r++) {
+        for (int i = 0; i < 2; i++) {
+            Event event;
+            queue.enqueueNDRangeKernel(kernel[i],
+                                       NullRange,
+                                       global[i],
+                                       local[i],
+                                       NULL,
+                                       &event);
+            time[i] += get_time(event);
+            queue.enqueueReadBuffer(output_buffer[i],
+                                    CL_TRUE,
+                                    0,
+                                    data_size * sizeof(T),
+                                    output[i]);
+        }
+        for (int j = 0; j < data_size; j++) {
+            if (output[0][j] != output[1][j]) {
+                if (mismatch < 10) {
+                    cout << "mismatch repeat = " << dec << r
+                         << " stream = " << (j % total_num)
+                         << " index = " << (j / total_num)
+                         << " scalar = " << hex << output[0][j]
+                         << " vector = " << output[1][j] << endl;
+                }
+                mismatch++;
+            }
+        }
+    }
+    double total = (double)data_size * repeat;
+    const char * name[2] = {scalar_name, vector_name};
+    for (int i = 0; i < 2; i++) {
+        cout << setw(24) << left << name[i]
+             << " kernel:" << fixed << setprecision(3)
+             << time[i] * 1000 << "ms "
+             << total / time[i] * 1.0e-6 << "M/s" << endl;
+        delete[] output[i];
+    }
+    return mismatch;
+}
+
+/**
+ * parsing command line options
+ *@param argc number of arguments
+ *@param argv array of argument strings
+ *@return true if no errors are found in command line arguments
+ */
+static bool parse_opt(int argc, char **argv)
+{
+    bool error = false;
+    std::string pgm = argv[0];
+    errno = 0;
+    if (argc <= 5) {
+        error = true;
+    }
+    while (!error) {
+        bits = strtol(argv[1], NULL, 10);
+        filename = argv[2];
+        group_num = strtol(argv[3], NULL, 10);
+        local_num = strtol(argv[4], NULL, 10);
+        data_count = strtol(argv[5], NULL, 10);
+        if (errno || group_num <= 0 || local_num <= 0 || data_count <= 0) {
+            error = true;
+            cerr << "number error!" << endl;
+            break;
+        }
+        if (bits != 32 && bits != 64) {
+            error = true;
+            cerr << "bits should be 32 or 64!" << endl;
+            break;
+        }
+        if (local_num % 4 != 0) {
+            error = true;
+            cerr << "local-num should be a multiple of 4!" << endl;
+            break;
+        }
+        if (argc > 6) {
+            std::string type = argv[6];
+            if (type == "cpu") {
+                device_type = CL_DEVICE_TYPE_CPU;
+            } else if (type == "gpu") {
+                device_type = CL_DEVICE_TYPE_GPU;
+            } else {
+                error = true;
+                cerr << "device type error!" << endl;
+                break;
+            }
+        }
+        if (argc > 7) {
+            repeat = strtol(argv[7], NULL, 10);
+            if (errno || repeat <= 0) {
+                error = true;
+                cerr << "repeat error!" << endl;
+                break;
+            }
+        }
+        ifstream ifs(filename.c_str());
+        if (!ifs) {
+            error = true;
+            cerr << "can't open file:" << filename << endl;
+            break;
+        }
+        break;
+    }
+    if (error) {
+        cerr << pgm
+             << " 32|64 paramfile group-num local-num data-count"
+             << " [cpu|gpu] [repeat]" << endl;
+        cerr << "32|64       tinymt32 or tinymt64." << endl;
+        cerr << "paramfile   parameter file of tinymt." << endl;
+        cerr << "group-num   group number of scalar kernel call." << endl;
+        cerr << "local-num   local item number of scalar kernel call,"
+             << " multiple of 4." << endl;
+        cerr << "data-count  generate random number count." << endl;
+        cerr << "cpu|gpu     device type, cpu for POCL. default is gpu."
+             << endl;
+        cerr << "repeat      number of kernel calls." << endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,772 @@
+/**
+ * @file kat.c
+ *
+ * @brief known answer test vectors of tinymt32 and tinymt64
+ *
+ * kat make writes a binary file of known answer test vectors, and
+ * kat check verifies implementations against the file, by threads.
+ * A vector is made for each parameter set, seed, initialization and
+ * output mode (generate_* function), and has the first values and the
+ * hash of count values.
+ *
+ * Every implementation in kat_impls is verified against vectors of its
+ * mode, so that a new implementation of an output mode, for example a
+ * bulk or SIMD version, is checked bit exactly by adding a row.
+ *
+ * File format, all integers are in little endian:
+ * - header: 8 bytes of magic "TMTKATVC", 32-bit version, 32-bit number
+ *   of vectors, 32-bit number of first values, 32-bit reserved and
+ *   64-bit number of hashed values.
+ * - vectors: 32-bit bits (32 or 64), 32-bit mode, 32-bit init (0 for
+ *   init, 1 for init_by_array), 32-bit mat1, 32-bit mat2, 32-bit
+ *   reserved, 64-bit tmat, 64-bit seed, 64-bit hash, and first values
+ *   as 64-bit integers.
+ *
+ * An output value is the unsigned integer or the bit pattern of the
+ * IEEE 754 float or double, extended to 64 bits. The hash is 64-bit
+ * FNV-1a over output values, one 64-bit value per step:
+ * h = (h ^ value) * 0x100000001b3, starting from 0xcbf29ce484222325.
+ *
+ * usage:
+ * kat make katfile [-n first] [-c count] [-s seeds] [-m params]
+ *     [-p32 paramfile] [-p64 paramfile] [-t threads]
+ * kat check katfile [-t threads]
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and The University of Tokyo.
+ * All rights reserved.
+ *
+ * The 3-clause BSD License is applied to this software, see
+ * LICENSE.txt
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "tinymt32.h"
+#include "tinymt64.h"
+
+#define KAT_BLOCK 4096
+#define KAT_HEADER_SIZE 32
+#define KAT_RECORD_SIZE 48
+#define FNV_OFFSET UINT64_C(0xcbf29ce484222325)
+#define FNV_PRIME UINT64_C(0x100000001b3)
+
+/**
+ * output modes.
+ */
+enum KAT_MODE {
+    KAT_UINT32, KAT_FLOAT, KAT_FLOAT12, KAT_FLOAT01, KAT_FLOATOC,
+    KAT_FLOATOO, KAT_32DOUBLE,
+    KAT_UINT64, KAT_DOUBLE, KAT_DOUBLE01, KAT_DOUBLE12, KAT_DOUBLEOC,
+    KAT_DOUBLEOO,
+    KAT_32UINT64, KAT_32DOUBLE53,
+    KAT_MODES
+};
+
+/**
+ * an implementation of an output mode, fill writes n outputs.
+ */
+struct KAT_IMPL_T {
+    const char * name;
+    int mode;
+    void (*fill)(void * state, uint64_t * out, int n);
+};
+
+/**
+ * a known answer test vector.
+ */
+struct KAT_VECTOR_T {
+    uint32_t bits;
+    uint32_t mode;
+    uint32_t init;
+    uint32_t mat1;
+    uint32_t mat2;
+    uint64_t tmat;
+    uint64_t seed;
+    uint64_t hash;
+    /** first values */
+    uint64_t * first;
+};
+
+/**
+ * vectors and work shared by threads.
+ */
+struct KAT_WORK_T {
+    struct KAT_VECTOR_T * vectors;
+    uint32_t num;
+    uint32_t first_num;
+    uint64_t count;
+    /** 0 for make, 1 for check */
+    int check;
+    /** tasks are vectors for make, vectors times implementations for
+     * check */
+    uint32_t tasks;
+    uint32_t next;
+    uint32_t errors;
+    pthread_mutex_t mutex;
+};
+
+static const char kat_magic[8] = {'T', 'M', 'T', 'K', 'A', 'T', 'V', 'C'};
+static const uint32_t kat_version = 1;
+
+/*
+ * fill functions of the reference generate_* functions.
+ */
+#define KAT_FILL(NAME, STATE, TYPE, WORD, FUNC)			\
+    static void NAME(void * state, uint64_t * out, int n)	\
+    {								\
+	STATE * random = (STATE *)state;			\
+	for (int i = 0; i < n; i++) {				\
+	    TYPE x = FUNC(random);				\
+	    WORD w;						\
+	    memcpy(&w, &x, sizeof(w));				\
+	    out[i] = w;						\
+	}							\
+    }
+
+KAT_FILL(fill_uint32, tinymt32_t, uint32_t, uint32_t,
+	 tinymt32_generate_uint32)
+KAT_FILL(fill_float, tinymt32_t, float, uint32_t, tinymt32_generate_float)
+KAT_FILL(fill_float12, tinymt32_t, float, uint32_t,
+	 tinymt32_generate_float12)
+KAT_FILL(fill_float01, tinymt32_t, float, uint32_t,
+	 tinymt32_generate_float01)
+KAT_FILL(fill_floatOC, tinymt32_t, float, uint32_t,
+	 tinymt32_generate_floatOC)
+KAT_FILL(fill_floatOO, tinymt32_t, float, uint32_t,
+	 tinymt32_generate_floatOO)
+KAT_FILL(fill_32double, tinymt32_t, double, uint64_t,
+	 tinymt32_generate_32double)
+KAT_FILL(fill_uint64, tinymt64_t, uint64_t, uint64_t,
+	 tinymt64_generate_uint64)
+KAT_FILL(fill_double, tinymt64_t, double, uint64_t,
+	 tinymt64_generate_double)
+KAT_FILL(fill_double01, tinymt64_t, double, uint64_t,
+	 tinymt64_generate_double01)
+KAT_FILL(fill_double12, tinymt64_t, double, uint64_t,
+	 tinymt64_generate_double12)
+KAT_FILL(fill_doubleOC, tinymt64_t, double, uint64_t,
+	 tinymt64_generate_doubleOC)
+KAT_FILL(fill_doubleOO, tinymt64_t, double, uint64_t,
+	 tinymt64_generate_doubleOO)
+KAT_FILL(fill_32uint64, tinymt32_t, uint64_t, uint64_t,
+	 tinymt32_generate_uint64)
+KAT_FILL(fill_32double53, tinymt32_t, double, uint64_t,
+	 tinymt32_generate_double53)
+
+/*
+ * fill functions of other implementations.
+ */
+/* 32-bit stream by tinymt32_generate_uint64, upper half first */
+static void fill_uint64_pairs(void * state, uint64_t * out, int n)
+{
+    tinymt32_t * random = (tinymt32_t *)state;
+    int i;
+    for (i = 0; i + 1 < n; i += 2) {
+	uint64_t x = tinymt32_generate_uint64(random);
+	out[i] = x >> 32;
+	out[i + 1] = x & UINT32_C(0xffffffff);
+    }
+    if (i < n) {
+	out[i] = tinymt32_generate_uint32(random);
+    }
+}
+
+static void fill_bulk_uint64(void * state, uint64_t * out, int n)
+{
+    tinymt32_fill_uint64((tinymt32_t *)state, out, n);
+}
+
+static void fill_bulk_double53(void * state, uint64_t * out, int n)
+{
+    double buffer[KAT_BLOCK];
+    tinymt32_fill_double53((tinymt32_t *)state, buffer, n);
+    memcpy(out, buffer, sizeof(double) * (size_t)n);
+}
+
+/**
+ * implementations, the first one of each mode is the reference used
+ * by kat make.
+ */
+static const struct KAT_IMPL_T kat_impls[] = {
+    {"tinymt32_generate_uint32", KAT_UINT32, fill_uint32},
+    {"tinymt32_generate_float", KAT_FLOAT, fill_float},
+    {"tinymt32_generate_float12", KAT_FLOAT12, fill_float12},
+    {"tinymt32_generate_float01", KAT_FLOAT01, fill_float01},
+    {"tinymt32_generate_floatOC", KAT_FLOATOC, fill_floatOC},
+    {"tinymt32_generate_floatOO", KAT_FLOATOO, fill_floatOO},
+    {"tinymt32_generate_32double", KAT_32DOUBLE, fill_32double},
+    {"tinymt64_generate_uint64", KAT_UINT64, fill_uint64},
+    {"tinymt64_generate_double", KAT_DOUBLE, fill_double},
+    {"tinymt64_generate_double01", KAT_DOUBLE01, fill_double01},
+    {"tinymt64_generate_double12", KAT_DOUBLE12, fill_double12},
+    {"tinymt64_generate_doubleOC", KAT_DOUBLEOC, fill_doubleOC},
+    {"tinymt64_generate_doubleOO", KAT_DOUBLEOO, fill_doubleOO},
+    {"tinymt32_generate_uint64", KAT_32UINT64, fill_32uint64},
+    {"tinymt32_generate_double53", KAT_32DOUBLE53, fill_32double53},
+    {"tinymt32_generate_uint64 as uint32", KAT_UINT32, fill_uint64_pairs},
+    {"tinymt32_fill_uint64", KAT_32UINT64, fill_bulk_uint64},
+    {"tinymt32_fill_double53", KAT_32DOUBLE53, fill_bulk_double53},
+};
+
+#define KAT_IMPLS ((uint32_t)(sizeof(kat_impls) / sizeof(kat_impls[0])))
+
+static uint32_t mode_bits(uint32_t mode);
+static const struct KAT_IMPL_T * reference(int mode);
+static void run_vector(const struct KAT_IMPL_T * impl,
+		       const struct KAT_VECTOR_T * v,
+		       uint64_t count, uint32_t first_num,
+		       uint64_t * first, uint64_t * hash);
+static void * worker(void * p);
+static int run_threads(struct KAT_WORK_T * work, int threads);
+static void put32(unsigned char * p, uint32_t x);
+static void put64(unsigned char * p, uint64_t x);
+static uint32_t get32(const unsigned char * p);
+static uint64_t get64(const unsigned char * p);
+static int read_params(const char * filename, int bits, uint32_t max,
+		       uint32_t mat1[], uint32_t mat2[], uint64_t tmat[]);
+static int write_kat(const char * filename, const struct KAT_WORK_T * work);
+static int read_kat(const char * filename, struct KAT_WORK_T * work);
+static int kat_make(int argc, char * argv[]);
+static int kat_check(int argc, char * argv[]);
+
+/**
+ * bits of generator of a mode.
+ * @param mode output mode
+ * @return 64 for tinymt64, 32 for tinymt32
+ */
+static uint32_t mode_bits(uint32_t mode)
+{
+    if (mode >= KAT_UINT64 && mode <= KAT_DOUBLEOO) {
+	return 64;
+    }
+    return 32;
+}
+
+/**
+ * reference implementation of a mode.
+ * @param mode output mode
+ * @return the first implementation of the mode
+ */
+static const struct KAT_IMPL_T * reference(int mode)
+{
+    for (uint32_t i = 0; i < KAT_IMPLS; i++) {
+	if (kat_impls[i].mode == mode) {
+	    return &kat_impls[i];
+	}
+    }
+    return NULL;
+}
+
+/**
+ * initialize generator of a vector and calculate first values and hash.
+ * @param impl implementation
+ * @param v vector, first and hash are not used
+ * @param count number of hashed values
+ * @param first_num number of first values
+ * @param first output, first values
+ * @param hash output, hash
+ */
+static void run_vector(const struct KAT_IMPL_T * impl,
+		       const struct KAT_VECTOR_T * v,
+		       uint64_t count, uint32_t first_num,
+		       uint64_t * first, uint64_t * hash)
+{
+    tinymt32_t tiny32;
+    tinymt64_t tiny64;
+    void * state;
+    uint64_t buffer[KAT_BLOCK];
+    uint64_t h = FNV_OFFSET;
+    uint64_t done = 0;
+
+    if (v->bits == 32) {
+	uint32_t key[5] = {(uint32_t)v->seed, (uint32_t)(v->seed >> 32),
+			   0x123, 0x234, 0x345};
+	tiny32.mat1 = v->mat1;
+	tiny32.mat2 = v->mat2;
+	tiny32.tmat = (uint32_t)v->tmat;
+	if (v->init == 0) {
+	    tinymt32_init(&tiny32, (uint32_t)v->seed);
+	} else {
+	    tinymt32_init_by_array(&tiny32, key, 5);
+	}
+	state = &tiny32;
+    } else {
+	uint64_t key[4] = {v->seed, 0x123, 0x234, 0x345};
+	tiny64.mat1 = v->mat1;
+	tiny64.mat2 = v->mat2;
+	tiny64.tmat = v->tmat;
+	if (v->init == 0) {
+	    tinymt64_init(&tiny64, v->seed);
+	} else {
+	    tinymt64_init_by_array(&tiny64, key, 4);
+	}
+	state = &tiny64;
+    }
+    while (done < count) {
+	int n = KAT_BLOCK;
+	if (count - done < KAT_BLOCK) {
+	    n = (int)(count - done);
+	}
+	impl->fill(state, buffer, n);
+	for (int i = 0; i < n; i++) {
+	    if (done + (uint64_t)i < first_num) {
+		first[done + (uint64_t)i] = buffer[i];
+	    }
+	    h = (h ^ buffer[i]) * FNV_PRIME;
+	}
+	done += (uint64_t)n;
+    }
+    *hash = h;
+}
+
+/**
+ * thread function, takes tasks until all tasks are done.
+ * @param p work shared by threads
+ */
+static void * worker(void * p)
+{
+    struct KAT_WORK_T * work = (struct KAT_WORK_T *)p;
+    uint64_t * first
+	= (uint64_t *)malloc(sizeof(uint64_t) * (work->first_num + 1));
+
+    if (first == NULL) {
+	return NULL;
+    }
+    for (;;) {
+	pthread_mutex_lock(&work->mutex);
+	uint32_t task = work->next++;
+	pthread_mutex_unlock(&work->mutex);
+	if (task >= work->tasks) {
+	    break;
+	}
+	uint64_t hash;
+	if (!work->check) {
+	    struct KAT_VECTOR_T * v = &work->vectors[task];
+	    run_vector(reference((int)v->mode), v, work->count,
+		       work->first_num, v->first, &v->hash);
+	    continue;
+	}
+	const struct KAT_VECTOR_T * v = &work->vectors[task / KAT_IMPLS];
+	const struct KAT_IMPL_T * impl = &kat_impls[task % KAT_IMPLS];
+	if (impl->mode != (int)v->mode) {
+	    continue;
+	}
+	run_vector(impl, v, work->count, work->first_num, first, &hash);
+	int diff = -1;
+	for (uint32_t i = 0; i < work->first_num; i++) {
+	    if (first[i] != v->first[i]) {
+		diff = (int)i;
+		break;
+	    }
+	}
+	if (diff >= 0 || hash != v->hash) {
+	    pthread_mutex_lock(&work->mutex);
+	    work->errors++;
+	    printf("N.G. %s vector %" PRIu32 " mat1 = %08" PRIx32
+		   " seed = %" PRIu64 " init = %" PRIu32,
+		   impl->name, task / KAT_IMPLS, v->mat1, v->seed, v->init);
+	    if (diff >= 0) {
+		printf(" first mismatch at %d\n", diff);
+	    } else {
+		printf(" hash mismatch\n");
+	    }
+	    pthread_mutex_unlock(&work->mutex);
+	}
+    }
+    free(first);
+    return NULL;
+}
+
+/**
+ * run tasks by threads.
+ * @param work work shared by threads
+ * @param threads number of threads
+ * @return 0 if success, -1 if error
+ */
+static int run_threads(struct KAT_WORK_T * work, int threads)
+{
+    pthread_t * tid
+	= (pthread_t *)malloc(sizeof(pthread_t) * (size_t)threads);
+    int created = 0;
+
+    if (tid == NULL) {
+	return -1;
+    }
+    work->next = 0;
+    pthread_mutex_init(&work->mutex, NULL);
+    for (; created < threads; created++) {
+	if (pthread_create(&tid[created], NULL, worker, work) != 0) {
+	    break;
+	}
+    }
+    if (created == 0) {
+	worker(work);
+    }
+    for (int i = 0; i < created; i++) {
+	pthread_join(tid[i], NULL);
+    }
+    pthread_mutex_destroy(&work->mutex);
+    free(tid);
+    return 0;
+}
+
+static void put32(unsigned char * p, uint32_t x)
+{
+    for (int i = 0; i < 4; i++) {
+	p[i] = (unsigned char)(x >> (8 * i));
+    }
+}
+
+static void put64(unsigned char * p, uint64_t x)
+{
+    for (int i = 0; i < 8; i++) {
+	p[i] = (unsigned char)(x >> (8 * i));
+    }
+}
+
+static uint32_t get32(const unsigned char * p)
+{
+    uint32_t x = 0;
+    for (int i = 0; i < 4; i++) {
+	x |= (uint32_t)p[i] << (8 * i);
+    }
+    return x;
+}
+
+static uint64_t get64(const unsigned char * p)
+{
+    uint64_t x = 0;
+    for (int i = 0; i < 8; i++) {
+	x |= (uint64_t)p[i] << (8 * i);
+    }
+    return x;
+}
+
+/**
+ * read parameter sets from output file of tinymt32dc or tinymt64dc.
+ * @param filename parameter file
+ * @param bits 32 or 64
+ * @param max maximum number of parameter sets
+ * @param mat1 output
+ * @param mat2 output
+ * @param tmat output
+ * @return number of parameter sets read, -1 if error
+ */
+static int read_params(const char * filename, int bits, uint32_t max,
+		       uint32_t mat1[], uint32_t mat2[], uint64_t tmat[])
+{
+    FILE * fp = fopen(filename, "r");
+    char line[500];
+    uint32_t n = 0;
+
+    if (fp == NULL) {
+	printf("can't open %s\n", filename);
+	return -1;
+    }
+    while (n < max && fgets(line, sizeof(line), fp) != NULL) {
+	char poly[33];
+	int b;
+	int id;
+	if (line[0] == '#') {
+	    continue;
+	}
+	if (sscanf(line, "%32[0-9a-f],%d,%d,%" SCNx32 ",%" SCNx32
+		   ",%" SCNx64, poly, &b, &id, &mat1[n], &mat2[n],
+		   &tmat[n]) != 6 || b != bits) {
+	    printf("file format error:%s", line);
+	    fclose(fp);
+	    return -1;
+	}
+	n++;
+    }
+    fclose(fp);
+    return (int)n;
+}
+
+/**
+ * write vectors to file.
+ * @param filename output file
+ * @param work vectors
+ * @return 0 if success, -1 if error
+ */
+static int write_kat(const char * filename, const struct KAT_WORK_T * work)
+{
+    FILE * fp = fopen(filename, "wb");
+    unsigned char buffer[KAT_RECORD_SIZE];
+    int r = 0;
+
+    if (fp == NULL) {
+	printf("can't open %s\n", filename);
+	return -1;
+    }
+    memcpy(buffer, kat_magic, 8);
+    put32(buffer + 8, kat_version);
+    put32(buffer + 12, work->num);
+    put32(buffer + 16, work->first_num);
+    put32(buffer + 20, 0);
+    put64(buffer + 24, work->count);
+    if (fwrite(buffer, 1, KAT_HEADER_SIZE, fp) != KAT_HEADER_SIZE) {
+	r = -1;
+    }
+    for (uint32_t i = 0; r == 0 && i < work->num; i++) {
+	const struct KAT_VECTOR_T * v = &work->vectors[i];
+	put32(buffer, v->bits);
+	put32(buffer + 4, v->mode);
+	put32(buffer + 8, v->init);
+	put32(buffer + 12, v->mat1);
+	put32(buffer + 16, v->mat2);
+	put32(buffer + 20, 0);
+	put64(buffer + 24, v->tmat);
+	put64(buffer + 32, v->seed);
+	put64(buffer + 40, v->hash);
+	if (fwrite(buffer, 1, KAT_RECORD_SIZE, fp) != KAT_RECORD_SIZE) {
+	    r = -1;
+	}
+	for (uint32_t j = 0; r == 0 && j < work->first_num; j++) {
+	    put64(buffer, v->first[j]);
+	    if (fwrite(buffer, 1, 8, fp) != 8) {
+		r = -1;
+	    }
+	}
+    }
+    if (fclose(fp) != 0) {
+	r = -1;
+    }
+    return r;
+}
+
+/**
+ * read vectors from file.
+ * @param filename input file
+ * @param work output, vectors are allocated
+ * @return 0 if success, -1 if error
+ */
+static int read_kat(const char * filename, struct KAT_WORK_T * work)
+{
+    FILE * fp = fopen(filename, "rb");
+    unsigned char buffer[KAT_RECORD_SIZE];
+
+    if (fp == NULL) {
+	printf("can't open %s\n", filename);
+	return -1;
+    }
+    if (fread(buffer, 1, KAT_HEADER_SIZE, fp) != KAT_HEADER_SIZE
+	|| memcmp(buffer, kat_magic, 8) != 0
+	|| get32(buffer + 8) != kat_version) {
+	printf("%s is not a kat file\n", filename);
+	fclose(fp);
+	return -1;
+    }
+    work->num = get32(buffer + 12);
+    work->first_num = get32(buffer + 16);
+    work->count = get64(buffer + 24);
+    work->vectors = (struct KAT_VECTOR_T *)calloc(work->num,
+						   sizeof(struct KAT_VECTOR_T));
+    uint64_t * first
+	= (uint64_t *)calloc((size_t)work->num * work->first_num + 1,
+			     sizeof(uint64_t));
+    if (work->vectors == NULL || first == NULL) {
+	printf("can't allocate memory\n");
+	fclose(fp);
+	return -1;
+    }
+    for (uint32_t i = 0; i < work->num; i++) {
+	struct KAT_VECTOR_T * v = &work->vectors[i];
+	if (fread(buffer, 1, KAT_RECORD_SIZE, fp) != KAT_RECORD_SIZE) {
+	    printf("%s is too short\n", filename);
+	    fclose(fp);
+	    return -1;
+	}
+	v->bits = get32(buffer);
+	v->mode = get32(buffer + 4);
+	v->init = get32(buffer + 8);
+	v->mat1 = get32(buffer + 12);
+	v->mat2 = get32(buffer + 16);
+	v->tmat = get64(buffer + 24);
+	v->seed = get64(buffer + 32);
+	v->hash = get64(buffer + 40);
+	v->first = &first[(size_t)i * work->first_num];
+	if (v->mode >= KAT_MODES
+	    || v->bits != mode_bits(v->mode)) {
+	    printf("%s has unknown mode\n", filename);
+	    fclose(fp);
+	    return -1;
+	}
+	for (uint32_t j = 0; j < work->first_num; j++) {
+	    if (fread(buffer, 1, 8, fp) != 8) {
+		printf("%s is too short\n", filename);
+		fclose(fp);
+		return -1;
+	    }
+	    v->first[j] = get64(buffer);
+	}
+    }
+    fclose(fp);
+    return 0;
+}
+
+/**
+ * make vectors for parameter sets, seeds, initializations and modes.
+ */
+static int kat_make(int argc, char * argv[])
+{
+    struct KAT_WORK_T work;
+    uint32_t seeds = 4;
+    uint32_t params = 1;
+    const char * file32 = NULL;
+    const char * file64 = NULL;
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int arg;
+
+    memset(&work, 0, sizeof(work));
+    work.first_num = 64;
+    work.count = UINT64_C(1000000000);
+    for (arg = 3; arg + 1 < argc; arg += 2) {
+	const char * opt = argv[arg];
+	const char * val = argv[arg + 1];
+	if (strcmp(opt, "-n") == 0) {
+	    work.first_num = (uint32_t)strtoul(val, NULL, 10);
+	} else if (strcmp(opt, "-c") == 0) {
+	    work.count = (uint64_t)strtod(val, NULL);
+	} else if (strcmp(opt, "-s") == 0) {
+	    seeds = (uint32_t)strtoul(val, NULL, 10);
+	} else if (strcmp(opt, "-m") == 0) {
+	    params = (uint32_t)strtoul(val, NULL, 10);
+	} else if (strcmp(opt, "-p32") == 0) {
+	    file32 = val;
+	} else if (strcmp(opt, "-p64") == 0) {
+	    file64 = val;
+	} else if (strcmp(opt, "-t") == 0) {
+	    threads = (int)strtol(val, NULL, 10);
+	} else {
+	    break;
+	}
+    }
+    if (arg != argc || work.count < work.first_num || seeds == 0
+	|| params == 0 || threads <= 0) {
+	printf("option error\n");
+	return -1;
+    }
+    uint32_t mat1[2][params];
+    uint32_t mat2[2][params];
+    uint64_t tmat[2][params];
+    int num[2] = {1, 1};
+    mat1[0][0] = 0x8f7011ee;
+    mat2[0][0] = 0xfc78ff1f;
+    tmat[0][0] = 0x3793fdff;
+    mat1[1][0] = 0xfa051f40;
+    mat2[1][0] = 0xffd0fff4;
+    tmat[1][0] = UINT64_C(0x58d02ffeffbfffbc);
+    if (file32 != NULL) {
+	num[0] = read_params(file32, 32, params, mat1[0], mat2[0], tmat[0]);
+    }
+    if (file64 != NULL) {
+	num[1] = read_params(file64, 64, params, mat1[1], mat2[1], tmat[1]);
+    }
+    if (num[0] <= 0 || num[1] <= 0) {
+	return -1;
+    }
+    work.num = 0;
+    work.tasks = 0;
+    for (uint32_t mode = 0; mode < KAT_MODES; mode++) {
+	work.tasks += (uint32_t)num[mode_bits(mode) == 32 ? 0 : 1];
+    }
+    work.tasks *= seeds * 2;
+    work.vectors = (struct KAT_VECTOR_T *)calloc(work.tasks,
+						  sizeof(struct KAT_VECTOR_T));
+    uint64_t * first
+	= (uint64_t *)calloc((size_t)work.tasks * work.first_num + 1,
+			     sizeof(uint64_t));
+    if (work.vectors == NULL || first == NULL) {
+	printf("can't allocate memory\n");
+	return -1;
+    }
+    for (uint32_t mode = 0; mode < KAT_MODES; mode++) {
+	int b = mode_bits(mode) == 32 ? 0 : 1;
+	for (int p = 0; p < num[b]; p++) {
+	    for (uint32_t s = 0; s < seeds; s++) {
+		for (uint32_t init = 0; init < 2; init++) {
+		    struct KAT_VECTOR_T * v = &work.vectors[work.num];
+		    v->bits = b == 0 ? 32 : 64;
+		    v->mode = mode;
+		    v->init = init;
+		    v->mat1 = mat1[b][p];
+		    v->mat2 = mat2[b][p];
+		    v->tmat = tmat[b][p];
+		    v->seed = s + 1;
+		    v->first = &first[(size_t)work.num * work.first_num];
+		    work.num++;
+		}
+	    }
+	}
+    }
+    run_threads(&work, threads);
+    if (write_kat(argv[2], &work) != 0) {
+	printf("can't write %s\n", argv[2]);
+	return -1;
+    }
+    printf("%s: %" PRIu32 " vectors, %" PRIu32 " first values, %" PRIu64
+	   " hashed values\n", argv[2], work.num, work.first_num, work.count);
+    free(first);
+    free(work.vectors);
+    return 0;
+}
+
+/**
+ * check all implementations against vectors of file.
+ */
+static int kat_check(int argc, char * argv[])
+{
+    struct KAT_WORK_T work;
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    memset(&work, 0, sizeof(work));
+    if (argc == 5 && strcmp(argv[3], "-t") == 0) {
+	threads = (int)strtol(argv[4], NULL, 10);
+    } else if (argc != 3) {
+	printf("option error\n");
+	return -1;
+    }
+    if (threads <= 0 || read_kat(argv[2], &work) != 0) {
+	return -1;
+    }
+    work.check = 1;
+    work.tasks = work.num * KAT_IMPLS;
+    run_threads(&work, threads);
+    printf("%s: %" PRIu32 " vectors, %" PRIu64 " values each, ",
+	   argv[2], work.num, work.count);
+    if (work.errors == 0) {
+	printf("O.K.\n");
+    } else {
+	printf("%" PRIu32 " errors N.G.\n", work.errors);
+    }
+    if (work.num > 0) {
+	free(work.vectors[0].first);
+    }
+    free(work.vectors);
+    return work.errors == 0 ? 0 : 1;
+}
+
+int main(int argc, char * argv[])
+{
+    if (argc >= 3 && strcmp(argv[1], "make") == 0) {
+	return kat_make(argc, argv);
+    }
+    if (argc >= 3 && strcmp(argv[1], "check") == 0) {
+	return kat_check(argc, argv);
+    }
+    printf("usage:\n"
+	   "%s make katfile [-n first] [-c count] [-s seeds] [-m params]\n"
+	   "    [-p32 paramfile] [-p64 paramfile] [-t threads]\n"
+	   "%s check katfile [-t threads]\n", argv[0], argv[0]);
+    return -1;
+}
@@ -0,0 +1,300 @@
+/*
+ * This program checks snapshot of tinymt32 and tinymt64: round trip
+ * of states in memory and in file, use of a snapshot file mapped to
+ * memory, and rejection of broken snapshots.
+ */
+#define _POSIX_C_SOURCE 200112L
+#include "tinymt_snapshot.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define NUM 1000
+#define STEPS 777
+
+static tinymt32_t a32[NUM];
+static tinymt32_t b32[NUM];
+static tinymt64_t a64[NUM];
+static tinymt64_t b64[NUM];
+static uint64_t pos[NUM];
+static uint64_t pos2[NUM];
+
+static void setup(void);
+static int equal32(tinymt32_t * x, tinymt32_t * y);
+static int equal64(tinymt64_t * x, tinymt64_t * y);
+static int test_memory(void);
+static int test_broken(void);
+static int test_file(const char * path);
+
+static void setup(void)
+{
+    for (int i = 0; i < NUM; i++) {
+        a32[i].mat1 = 0x8f7011ee;
+        a32[i].mat2 = 0xfc78ff1f;
+        a32[i].tmat = 0x3793fdff ^ (uint32_t)i;
+        tinymt32_init(&a32[i], (uint32_t)i + 1);
+        a64[i].mat1 = 0xfa051f40;
+        a64[i].mat2 = 0xffd0fff4;
+        a64[i].tmat = UINT64_C(0x58d02ffeffbfffbc) ^ (uint64_t)i;
+        tinymt64_init(&a64[i], (uint64_t)i + 1);
+        for (int j = 0; j < i % 17; j++) {
+            tinymt32_generate_uint32(&a32[i]);
+            tinymt64_generate_uint64(&a64[i]);
+        }
+        pos[i] = (uint64_t)(i % 17) | ((uint64_t)i << 40);
+    }
+}
+
+/* same state, parameters and outputs */
+static int equal32(tinymt32_t * x, tinymt32_t * y)
+{
+    if (x->mat1 != y->mat1 || x->mat2 != y->mat2 || x->tmat != y->tmat) {
+        return 0;
+    }
+    for (int i = 0; i < STEPS; i++) {
+        if (tinymt32_generate_uint32(x) != tinymt32_generate_uint32(y)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int equal64(tinymt64_t * x, tinymt64_t * y)
+{
+    if (x->mat1 != y->mat1 || x->mat2 != y->mat2 || x->tmat != y->tmat) {
+        return 0;
+    }
+    for (int i = 0; i < STEPS; i++) {
+        if (tinymt64_generate_uint64(x) != tinymt64_generate_uint64(y)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int test_memory(void)
+{
+    size_t size = tinymt_snapshot_size(NUM);
+    unsigned char * buffer = (unsigned char *)malloc(size);
+    tinymt_snapshot_header header;
+    int r = 0;
+
+    if (buffer == NULL) {
+        return 1;
+    }
+    /* single state without position */
+    if (tinymt32_snapshot_encode(buffer, size, a32, NULL, 1) != 0
+        || tinymt_snapshot_info(buffer, size, &header) != 0
+        || header.bits != 32 || header.count != 1 || header.flags != 0
+        || tinymt32_snapshot_decode(buffer, size, b32, pos2, 0, 1) != 0
+        || pos2[0] != 0
+        || !equal32(&a32[0], &b32[0])) {
+        printf("tinymt32 single state\n");
+        r = 1;
+    }
+    /* array with positions, decoded from the middle */
+    if (tinymt32_snapshot_encode(buffer, size, a32, pos, NUM) != 0
+        || tinymt_snapshot_info(buffer, size, &header) != 0
+        || header.flags != TINYMT_SNAPSHOT_POSITION
+        || tinymt64_snapshot_decode(buffer, size, b64, NULL, 0, 1) == 0
+        || tinymt32_snapshot_decode(buffer, size, b32, pos2, 100, NUM - 100)
+        != 0
+        || tinymt32_snapshot_decode(buffer, size, b32, NULL, 100, NUM - 99)
+        == 0) {
+        printf("tinymt32 array\n");
+        r = 1;
+    }
+    for (int i = 100; i < NUM && r == 0; i++) {
+        if (pos2[i - 100] != pos[i] || !equal32(&a32[i], &b32[i - 100])) {
+            printf("tinymt32 array %d\n", i);
+            r = 1;
+        }
+    }
+    if (tinymt64_snapshot_encode(buffer, size, a64, pos, NUM) != 0
+        || tinymt_snapshot_info(buffer, size, &header) != 0
+        || header.bits != 64 || header.count != NUM
+        || tinymt32_snapshot_decode(buffer, size, b32, NULL, 0, 1) == 0
+        || tinymt64_snapshot_decode(buffer, size, b64, pos2, 0, NUM) != 0) {
+        printf("tinymt64 array\n");
+        r = 1;
+    }
+    for (int i = 0; i < NUM && r == 0; i++) {
+        if (pos2[i] != pos[i] || !equal64(&a64[i], &b64[i])) {
+            printf("tinymt64 array %d\n", i);
+            r = 1;
+        }
+    }
+    /* too small buffer */
+    if (tinymt64_snapshot_encode(buffer, size - 1, a64, pos, NUM) == 0
+        || tinymt_snapshot_info(buffer, size - 1, &header) == 0) {
+        printf("small buffer\n");
+        r = 1;
+    }
+    free(buffer);
+    return r;
+}
+
+static int test_broken(void)
+{
+    unsigned char buffer[TINYMT_SNAPSHOT_HEADER_SIZE
+                         + TINYMT_SNAPSHOT_RECORD_SIZE];
+    size_t size = sizeof(buffer);
+    tinymt_snapshot_header header;
+    int r = 0;
+
+    setup();
+    tinymt32_snapshot_encode(buffer, size, a32, NULL, 1);
+    /* little endian, every byte is fixed */
+    if (buffer[8] != 1 || buffer[12] != 32 || buffer[16] != 40
+        || buffer[24] != 1
+        || buffer[64] != (a32[0].status[0] & 0xff)
+        || buffer[80] != 0xee) {
+        printf("byte order\n");
+        r = 1;
+    }
+    buffer[0] = 'X';
+    if (tinymt_snapshot_info(buffer, size, &header) == 0) {
+        printf("broken magic\n");
+        r = 1;
+    }
+    buffer[0] = 'T';
+    buffer[8] = 2;
+    if (tinymt32_snapshot_decode(buffer, size, b32, NULL, 0, 1) == 0) {
+        printf("broken version\n");
+        r = 1;
+    }
+    buffer[8] = 1;
+    buffer[24] = 2;
+    if (tinymt_snapshot_info(buffer, size, &header) == 0) {
+        printf("broken count\n");
+        r = 1;
+    }
+    return r;
+}
+
+/* save, map as restarted job does, and load */
+static int test_file(const char * path)
+{
+    FILE * fp;
+    int fd;
+    struct stat st;
+    void * map;
+    const tinymt32_record * records;
+    uint64_t count = 0;
+    int r = 0;
+
+    setup();
+    fp = fopen(path, "wb");
+    if (fp == NULL
+        || tinymt32_snapshot_save(fp, a32, pos, NUM) != 0) {
+        printf("save\n");
+        return 1;
+    }
+    fclose(fp);
+    fd = open(path, O_RDONLY);
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        printf("open\n");
+        return 1;
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+        printf("mmap\n");
+        close(fd);
+        return 1;
+    }
+    records = tinymt32_snapshot_map(map, (size_t)st.st_size, &count);
+    if (records != NULL) {
+        if (count != NUM) {
+            printf("map count\n");
+            r = 1;
+        }
+        for (uint64_t i = 0; i < count && r == 0; i++) {
+            tinymt32_t tiny;
+            tinymt32_from_record(&tiny, &records[i]);
+            if (records[i].position != pos[i] || !equal32(&a32[i], &tiny)) {
+                printf("map %" PRIu64 "\n", i);
+                r = 1;
+            }
+        }
+    } else {
+        printf("map is not available, only decode is checked\n");
+    }
+    munmap(map, (size_t)st.st_size);
+    close(fd);
+
+    /* a32 is advanced STEPS by equal32 above */
+    setup();
+    fp = fopen(path, "rb");
+    if (fp == NULL
+        || tinymt64_snapshot_load(fp, b64, NULL, NUM, &count) == 0) {
+        printf("load as tinymt64\n");
+        r = 1;
+    }
+    if (fp != NULL) {
+        rewind(fp);
+        if (tinymt32_snapshot_load(fp, b32, pos2, NUM - 1, &count) == 0) {
+            printf("load to small array\n");
+            r = 1;
+        }
+        rewind(fp);
+        if (tinymt32_snapshot_load(fp, b32, pos2, NUM, &count) != 0
+            || count != NUM) {
+            printf("load\n");
+            r = 1;
+        }
+        fclose(fp);
+    }
+    for (int i = 0; i < NUM && r == 0; i++) {
+        if (pos2[i] != pos[i] || !equal32(&a32[i], &b32[i])) {
+            printf("load %d\n", i);
+            r = 1;
+        }
+    }
+    remove(path);
+
+    fp = fopen(path, "wb");
+    if (fp == NULL
+        || tinymt64_snapshot_save(fp, a64, NULL, NUM) != 0) {
+        printf("save tinymt64\n");
+        return 1;
+    }
+    fclose(fp);
+    fp = fopen(path, "rb");
+    if (fp == NULL
+        || tinymt64_snapshot_load(fp, b64, pos2, NUM, &count) != 0
+        || count != NUM) {
+        printf("load tinymt64\n");
+        r = 1;
+    }
+    if (fp != NULL) {
+        fclose(fp);
+    }
+    for (int i = 0; i < NUM && r == 0; i++) {
+        if (pos2[i] != 0 || !equal64(&a64[i], &b64[i])) {
+            printf("load tinymt64 %d\n", i);
+            r = 1;
+        }
+    }
+    remove(path);
+    return r;
+}
+
+int main(void) {
+    int r;
+
+    setup();
+    r = test_memory();
+    r |= test_broken();
+    r |= test_file("snapshot_test.tmp");
+    if (r == 0) {
+        printf("OK!\n");
+    } else {
+        printf("NG!\n");
+    }
+    return r;
+}
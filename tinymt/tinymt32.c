@@ -73,6 +73,12 @@ void tinymt32_init(tinymt32_t * random, uint32_t seed) {
     for (unsigned int i = 0; i < PRE_LOOP; i++) {
         tinymt32_next_state(random);
     }
+#if defined(TINYMT_GUARD)
+    tinymt32_guard_set_limit(random, UINT64_MAX);
+#endif
+#if defined(TINYMT_DIGEST)
+    tinymt32_digest_reset(random);
+#endif
 }
 
 /**
@@ -142,4 +148,43 @@ void tinymt32_init_by_array(tinymt32_t * random, uint32_t init_key[],
     for (i = 0; i < PRE_LOOP; i++) {
         tinymt32_next_state(random);
     }
+#if defined(TINYMT_GUARD)
+    tinymt32_guard_set_limit(random, UINT64_MAX);
+#endif
+#if defined(TINYMT_DIGEST)
+    tinymt32_digest_reset(random);
+#endif
+}
+
+/**
+ * This function fills the array with 64-bit unsigned integers, which
+ * are the same as size calls of tinymt32_generate_uint64().
+ * Internal state is loaded once and stored once.
+ * @param random tinymt internal status
+ * @param array output array
+ * @param size number of elements of the array
+ */
+void tinymt32_fill_uint64(tinymt32_t * random, uint64_t array[], int size) {
+    tinymt32_t local = *random;
+    for (int i = 0; i < size; i++) {
+        array[i] = tinymt32_generate_uint64(&local);
+    }
+    *random = local;
+}
+
+/**
+ * This function fills the array with double precision floating point
+ * numbers r (0.0 <= r < 1.0) of 53-bit precision, which are the same as
+ * size calls of tinymt32_generate_double53().
+ * Internal state is loaded once and stored once.
+ * @param random tinymt internal status
+ * @param array output array
+ * @param size number of elements of the array
+ */
+void tinymt32_fill_double53(tinymt32_t * random, double array[], int size) {
+    tinymt32_t local = *random;
+    for (int i = 0; i < size; i++) {
+        array[i] = tinymt32_generate_double53(&local);
+    }
+    *random = local;
 }
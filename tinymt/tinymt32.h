@@ -18,6 +18,12 @@
 
 #include <stdint.h>
 #include <inttypes.h>
+#if defined(TINYMT_GUARD)
+#include "tinymt_guard.h"
+#endif
+#if defined(TINYMT_DIGEST)
+#include "tinymt_digest.h"
+#endif
 
 #define TINYMT32_MEXP 127
 #define TINYMT32_SH0 1
@@ -38,6 +44,13 @@ struct TINYMT32_T {
     uint32_t mat1;
     uint32_t mat2;
     uint32_t tmat;
+#if defined(TINYMT_GUARD)
+    uint64_t guard_count;
+    uint64_t guard_limit;
+#endif
+#if defined(TINYMT_DIGEST)
+    tinymt_digest digest;
+#endif
 };
 
 typedef struct TINYMT32_T tinymt32_t;
@@ -45,6 +58,8 @@ typedef struct TINYMT32_T tinymt32_t;
 void tinymt32_init(tinymt32_t * random, uint32_t seed);
 void tinymt32_init_by_array(tinymt32_t * random, uint32_t init_key[],
                             int key_length);
+void tinymt32_fill_uint64(tinymt32_t * random, uint64_t array[], int size);
+void tinymt32_fill_double53(tinymt32_t * random, double array[], int size);
 
 #if defined(__GNUC__)
 /**
@@ -62,6 +77,100 @@ inline static int tinymt32_get_mexp(tinymt32_t * random) {
 }
 #endif
 
+/**
+ * This function counts one output for guard.
+ * This function does nothing unless TINYMT_GUARD is defined.
+ * Users should not call this function directly.
+ * @param random tinymt internal status
+ */
+inline static void tinymt32_guard_step(tinymt32_t * random) {
+#if defined(TINYMT_GUARD)
+    random->guard_count++;
+#else
+    (void)random;
+#endif
+}
+
+#if defined(TINYMT_GUARD)
+/**
+ * This function resets the count of outputs and sets the limit of it.
+ * @param random tinymt internal status
+ * @param limit limit of the count, for example, stride of the substream
+ */
+inline static void tinymt32_guard_set_limit(tinymt32_t * random,
+                                            uint64_t limit) {
+    random->guard_count = 0;
+    random->guard_limit = limit;
+}
+
+/**
+ * This function checks if the count of outputs exceeds the limit.
+ * @param random tinymt internal status
+ * @return 1 if the count exceeds the limit, else 0
+ */
+inline static int tinymt32_guard_overflow(const tinymt32_t * random) {
+    return random->guard_count > random->guard_limit;
+}
+
+/**
+ * This function adds steps skipped by jump to the count of outputs.
+ * @param random tinymt internal status
+ * @param steps number of steps
+ */
+inline static void tinymt32_guard_skip(tinymt32_t * random, uint64_t steps) {
+    if (random->guard_count + steps < random->guard_count) {
+        random->guard_count = UINT64_MAX;
+    } else {
+        random->guard_count += steps;
+    }
+}
+
+/**
+ * This function adds the count of outputs to statistics, and resets
+ * the count.
+ * @param random tinymt internal status
+ * @param stats statistics owned by the calling thread
+ */
+inline static void tinymt32_guard_retire(tinymt32_t * random,
+                                         tinymt_guard_stats * stats) {
+    tinymt_guard_add(stats, random->guard_count, random->guard_limit);
+    random->guard_count = 0;
+}
+#endif
+
+#if defined(TINYMT_DIGEST)
+/**
+ * This function returns digest of outputs after the last reset.
+ * @param random tinymt internal status
+ * @param digest output, copy of digest
+ */
+inline static void tinymt32_digest_get(const tinymt32_t * random,
+                                         tinymt_digest * digest) {
+    *digest = random->digest;
+}
+
+/**
+ * This function resets digest. Call this after jump, to start digest
+ * of a substream.
+ * @param random tinymt internal status
+ */
+inline static void tinymt32_digest_reset(tinymt32_t * random) {
+    tinymt_digest_clear(&random->digest);
+}
+#endif
+
+/**
+ * This function returns all bits one if the lowest bit of x is one,
+ * else zero, so that parameters are selected without branch in the
+ * recursion and tempering.
+ * Users should not call this function directly.
+ * @param x value to be tempered
+ * @return mask
+ */
+inline static uint32_t tinymt32_temper_mask(uint32_t x) {
+    return (uint32_t)-(int32_t)(x & 1);
+}
+
 /**
  * This function changes internal state of tinymt32.
  * Users should not call this function directly.
@@ -104,9 +213,7 @@ inline static uint32_t tinymt32_temper(tinymt32_t * random) {
         + (random->status[2] >> TINYMT32_SH8);
 #endif
     t0 ^= t1;
-    if ((t1 & 1) != 0) {
-        t0 ^= random->tmat;
-    }
+    t0 ^= tinymt32_temper_mask(t1) & random->tmat;
     return t0;
 }
 
@@ -132,11 +239,8 @@ inline static float tinymt32_temper_conv(tinymt32_t * random) {
         + (random->status[2] >> TINYMT32_SH8);
 #endif
     t0 ^= t1;
-    if ((t1 & 1) != 0) {
-        conv.u  = ((t0 ^ random->tmat) >> 9) | UINT32_C(0x3f800000);
-    } else {
-        conv.u  = (t0 >> 9) | UINT32_C(0x3f800000);
-    }
+    conv.u = ((t0 >> 9) ^ (tinymt32_temper_mask(t1) & (random->tmat >> 9)))
+        | UINT32_C(0x3f800000);
     return conv.f;
 }
 
@@ -162,14 +266,48 @@ inline static float tinymt32_temper_conv_open(tinymt32_t * random) {
         + (random->status[2] >> TINYMT32_SH8);
 #endif
     t0 ^= t1;
-        if ((t1 & 1) != 0) {
-        conv.u  = ((t0 ^ random->tmat) >> 9) | UINT32_C(0x3f800001);
-    } else {
-        conv.u  = (t0 >> 9) | UINT32_C(0x3f800001);
-    }
+    conv.u = ((t0 >> 9) ^ (tinymt32_temper_mask(t1) & (random->tmat >> 9)))
+        | UINT32_C(0x3f800001);
     return conv.f;
 }
 
+/**
+ * This function adds one output, the value returned by generate_*
+ * function, to digest.
+ * These functions do nothing unless TINYMT_DIGEST is defined.
+ * Users should not call these functions directly.
+ * @param random tinymt internal status
+ * @param value output
+ */
+inline static void tinymt32_digest_step(tinymt32_t * random,
+                                        uint64_t value) {
+#if defined(TINYMT_DIGEST)
+    tinymt_digest_update(&random->digest, value);
+#else
+    (void)random;
+    (void)value;
+#endif
+}
+
+inline static void tinymt32_digest_float(tinymt32_t * random, float value) {
+#if defined(TINYMT_DIGEST)
+    tinymt_digest_update_float(&random->digest, value);
+#else
+    (void)random;
+    (void)value;
+#endif
+}
+
+inline static void tinymt32_digest_double(tinymt32_t * random,
+                                          double value) {
+#if defined(TINYMT_DIGEST)
+    tinymt_digest_update_double(&random->digest, value);
+#else
+    (void)random;
+    (void)value;
+#endif
+}
+
 /**
  * This function outputs 32-bit unsigned integer from internal state.
  * @param random tinymt internal status
@@ -177,7 +315,10 @@ inline static float tinymt32_temper_conv_open(tinymt32_t * random) {
  */
 inline static uint32_t tinymt32_generate_uint32(tinymt32_t * random) {
     tinymt32_next_state(random);
-    return tinymt32_temper(random);
+    tinymt32_guard_step(random);
+    uint32_t r = tinymt32_temper(random);
+    tinymt32_digest_step(random, r);
+    return r;
 }
 
 /**
@@ -190,7 +331,10 @@ inline static uint32_t tinymt32_generate_uint32(tinymt32_t * random) {
  */
 inline static float tinymt32_generate_float(tinymt32_t * random) {
     tinymt32_next_state(random);
-    return (float)(tinymt32_temper(random) >> 8) * TINYMT32_MUL;
+    tinymt32_guard_step(random);
+    float r = (float)(tinymt32_temper(random) >> 8) * TINYMT32_MUL;
+    tinymt32_digest_float(random, r);
+    return r;
 }
 
 /**
@@ -201,7 +345,10 @@ inline static float tinymt32_generate_float(tinymt32_t * random) {
  */
 inline static float tinymt32_generate_float12(tinymt32_t * random) {
     tinymt32_next_state(random);
-    return tinymt32_temper_conv(random);
+    tinymt32_guard_step(random);
+    float r = tinymt32_temper_conv(random);
+    tinymt32_digest_float(random, r);
+    return r;
 }
 
 /**
@@ -212,7 +359,10 @@ inline static float tinymt32_generate_float12(tinymt32_t * random) {
  */
 inline static float tinymt32_generate_float01(tinymt32_t * random) {
     tinymt32_next_state(random);
-    return tinymt32_temper_conv(random) - 1.0f;
+    tinymt32_guard_step(random);
+    float r = tinymt32_temper_conv(random) - 1.0f;
+    tinymt32_digest_float(random, r);
+    return r;
 }
 
 /**
@@ -222,7 +372,11 @@ inline static float tinymt32_generate_float01(tinymt32_t * random) {
  * @return floating point number r (0.0 < r <= 1.0)
  */
 inline static float tinymt32_generate_floatOC(tinymt32_t * random) {
-    return 1.0f - tinymt32_generate_float(random);
+    tinymt32_next_state(random);
+    tinymt32_guard_step(random);
+    float r = 1.0f - (float)(tinymt32_temper(random) >> 8) * TINYMT32_MUL;
+    tinymt32_digest_float(random, r);
+    return r;
 }
 
 /**
@@ -233,7 +387,10 @@ inline static float tinymt32_generate_floatOC(tinymt32_t * random) {
  */
 inline static float tinymt32_generate_floatOO(tinymt32_t * random) {
     tinymt32_next_state(random);
-    return tinymt32_temper_conv_open(random) - 1.0f;
+    tinymt32_guard_step(random);
+    float r = tinymt32_temper_conv_open(random) - 1.0f;
+    tinymt32_digest_float(random, r);
+    return r;
 }
 
 /**
@@ -246,7 +403,64 @@ inline static float tinymt32_generate_floatOO(tinymt32_t * random) {
  */
 inline static double tinymt32_generate_32double(tinymt32_t * random) {
     tinymt32_next_state(random);
-    return tinymt32_temper(random) * (1.0 / 4294967296.0);
+    tinymt32_guard_step(random);
+    double r = tinymt32_temper(random) * (1.0 / 4294967296.0);
+    tinymt32_digest_double(random, r);
+    return r;
+}
+
+/**
+ * This function makes 64-bit unsigned integer from two steps of
+ * internal state, without digest. The upper 32 bits are the first
+ * output and the lower 32 bits are the second output.
+ * Two steps are done on a local copy of internal state, which is kept
+ * in registers, and the state is stored once.
+ * Users should not call this function directly.
+ * @param random tinymt internal status
+ * @return 64-bit unsigned integer r (0 <= r < 2^64)
+ */
+inline static uint64_t tinymt32_next_uint64(tinymt32_t * random) {
+    tinymt32_t local = *random;
+    uint64_t hi;
+    uint64_t lo;
+
+    tinymt32_next_state(&local);
+    tinymt32_guard_step(&local);
+    hi = tinymt32_temper(&local);
+    tinymt32_next_state(&local);
+    tinymt32_guard_step(&local);
+    lo = tinymt32_temper(&local);
+    *random = local;
+    return (hi << 32) | lo;
+}
+
+/**
+ * This function outputs 64-bit unsigned integer from two steps of
+ * internal state. The upper 32 bits are the first output and the lower
+ * 32 bits are the second output of tinymt32_generate_uint32(), so
+ * that the stream is the same as the 32-bit stream.
+ * @param random tinymt internal status
+ * @return 64-bit unsigned integer r (0 <= r < 2^64)
+ */
+inline static uint64_t tinymt32_generate_uint64(tinymt32_t * random) {
+    uint64_t r = tinymt32_next_uint64(random);
+    tinymt32_digest_step(random, r);
+    return r;
+}
+
+/**
+ * This function outputs double precision floating point number from
+ * two steps of internal state. The returned value has 53-bit precision,
+ * and is the upper 53 bits of tinymt32_generate_uint64() multiplied by
+ * (1 / 2^53).
+ * @param random tinymt internal status
+ * @return floating point number r (0.0 <= r < 1.0)
+ */
+inline static double tinymt32_generate_double53(tinymt32_t * random) {
+    double r = (double)(tinymt32_next_uint64(random) >> 11)
+        * (1.0 / 9007199254740992.0);
+    tinymt32_digest_double(random, r);
+    return r;
 }
 
 #if defined(__cplusplus)
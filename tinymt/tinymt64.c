@@ -64,6 +64,12 @@ void tinymt64_init(tinymt64_t * random, uint64_t seed) {
                ^ (random->status[(i - 1) & 1] >> 62));
     }
     period_certification(random);
+#if defined(TINYMT_GUARD)
+    tinymt64_guard_set_limit(random, UINT64_MAX);
+#endif
+#if defined(TINYMT_DIGEST)
+    tinymt64_digest_reset(random);
+#endif
 }
 
 /**
@@ -126,4 +132,10 @@ void tinymt64_init_by_array(tinymt64_t * random, const uint64_t init_key[],
     random->status[0] = st[0] ^ st[1];
     random->status[1] = st[2] ^ st[3];
     period_certification(random);
+#if defined(TINYMT_GUARD)
+    tinymt64_guard_set_limit(random, UINT64_MAX);
+#endif
+#if defined(TINYMT_DIGEST)
+    tinymt64_digest_reset(random);
+#endif
 }
@@ -18,6 +18,12 @@
 
 #include <stdint.h>
 #include <inttypes.h>
+#if defined(TINYMT_GUARD)
+#include "tinymt_guard.h"
+#endif
+#if defined(TINYMT_DIGEST)
+#include "tinymt_digest.h"
+#endif
 
 #define TINYMT64_MEXP 127
 #define TINYMT64_SH0 12
@@ -38,6 +44,13 @@ struct TINYMT64_T {
     uint32_t mat1;
     uint32_t mat2;
     uint64_t tmat;
+#if defined(TINYMT_GUARD)
+    uint64_t guard_count;
+    uint64_t guard_limit;
+#endif
+#if defined(TINYMT_DIGEST)
+    tinymt_digest digest;
+#endif
 };
 
 typedef struct TINYMT64_T tinymt64_t;
@@ -62,6 +75,100 @@ inline static int tinymt64_get_mexp(tinymt64_t * random) {
 }
 #endif
 
+/**
+ * This function counts one output for guard.
+ * This function does nothing unless TINYMT_GUARD is defined.
+ * Users should not call this function directly.
+ * @param random tinymt internal status
+ */
+inline static void tinymt64_guard_step(tinymt64_t * random) {
+#if defined(TINYMT_GUARD)
+    random->guard_count++;
+#else
+    (void)random;
+#endif
+}
+
+#if defined(TINYMT_GUARD)
+/**
+ * This function resets the count of outputs and sets the limit of it.
+ * @param random tinymt internal status
+ * @param limit limit of the count, for example, stride of the substream
+ */
+inline static void tinymt64_guard_set_limit(tinymt64_t * random,
+                                            uint64_t limit) {
+    random->guard_count = 0;
+    random->guard_limit = limit;
+}
+
+/**
+ * This function checks if the count of outputs exceeds the limit.
+ * @param random tinymt internal status
+ * @return 1 if the count exceeds the limit, else 0
+ */
+inline static int tinymt64_guard_overflow(const tinymt64_t * random) {
+    return random->guard_count > random->guard_limit;
+}
+
+/**
+ * This function adds steps skipped by jump to the count of outputs.
+ * @param random tinymt internal status
+ * @param steps number of steps
+ */
+inline static void tinymt64_guard_skip(tinymt64_t * random, uint64_t steps) {
+    if (random->guard_count + steps < random->guard_count) {
+        random->guard_count = UINT64_MAX;
+    } else {
+        random->guard_count += steps;
+    }
+}
+
+/**
+ * This function adds the count of outputs to statistics, and resets
+ * the count.
+ * @param random tinymt internal status
+ * @param stats statistics owned by the calling thread
+ */
+inline static void tinymt64_guard_retire(tinymt64_t * random,
+                                         tinymt_guard_stats * stats) {
+    tinymt_guard_add(stats, random->guard_count, random->guard_limit);
+    random->guard_count = 0;
+}
+#endif
+
+#if defined(TINYMT_DIGEST)
+/**
+ * This function returns digest of outputs after the last reset.
+ * @param random tinymt internal status
+ * @param digest output, copy of digest
+ */
+inline static void tinymt64_digest_get(const tinymt64_t * random,
+                                         tinymt_digest * digest) {
+    *digest = random->digest;
+}
+
+/**
+ * This function resets digest. Call this after jump, to start digest
+ * of a substream.
+ * @param random tinymt internal status
+ */
+inline static void tinymt64_digest_reset(tinymt64_t * random) {
+    tinymt_digest_clear(&random->digest);
+}
+#endif
+
+/**
+ * This function returns all bits one if the lowest bit of x is one,
+ * else zero, so that parameters are selected without branch in the
+ * recursion and tempering.
+ * Users should not call this function directly.
+ * @param x value to be tempered
+ * @return mask
+ */
+inline static uint64_t tinymt64_temper_mask(uint64_t x) {
+    return (uint64_t)-(int64_t)(x & 1);
+}
+
 /**
  * This function changes internal state of tinymt64.
  * Users should not call this function directly.
@@ -78,10 +185,9 @@ inline static void tinymt64_next_state(tinymt64_t * random) {
     x ^= x << TINYMT64_SH1;
     random->status[0] = random->status[1];
     random->status[1] = x;
-    if ((x & 1) != 0) {
-        random->status[0] ^= random->mat1;
-        random->status[1] ^= ((uint64_t)random->mat2 << 32);
-    }
+    uint64_t const mask = tinymt64_temper_mask(x);
+    random->status[0] ^= mask & random->mat1;
+    random->status[1] ^= mask & ((uint64_t)random->mat2 << 32);
 }
 
 /**
@@ -98,9 +204,7 @@ inline static uint64_t tinymt64_temper(tinymt64_t * random) {
     x = random->status[0] + random->status[1];
 #endif
     x ^= random->status[0] >> TINYMT64_SH8;
-    if ((x & 1) != 0) {
-        x ^= random->tmat;
-    }
+    x ^= tinymt64_temper_mask(x) & random->tmat;
     return x;
 }
 
@@ -122,11 +226,8 @@ inline static double tinymt64_temper_conv(tinymt64_t * random) {
     x = random->status[0] + random->status[1];
 #endif
     x ^= random->status[0] >> TINYMT64_SH8;
-    if ((x & 1) != 0) {
-        conv.u = ((x ^ random->tmat) >> 12) | UINT64_C(0x3ff0000000000000);
-    } else {
-        conv.u = (x  >> 12) | UINT64_C(0x3ff0000000000000);
-    }
+    conv.u = ((x >> 12) ^ (tinymt64_temper_mask(x) & (random->tmat >> 12)))
+        | UINT64_C(0x3ff0000000000000);
     return conv.d;
 }
 
@@ -148,14 +249,39 @@ inline static double tinymt64_temper_conv_open(tinymt64_t * random) {
     x = random->status[0] + random->status[1];
 #endif
     x ^= random->status[0] >> TINYMT64_SH8;
-    if ((x & 1) != 0) {
-        conv.u = ((x ^ random->tmat) >> 12) | UINT64_C(0x3ff0000000000001);
-    } else {
-        conv.u = (x >> 12) | UINT64_C(0x3ff0000000000001);
-    }
+    conv.u = ((x >> 12) ^ (tinymt64_temper_mask(x) & (random->tmat >> 12)))
+        | UINT64_C(0x3ff0000000000001);
     return conv.d;
 }
 
+/**
+ * This function adds one output, the value returned by generate_*
+ * function, to digest.
+ * These functions do nothing unless TINYMT_DIGEST is defined.
+ * Users should not call these functions directly.
+ * @param random tinymt internal status
+ * @param value output
+ */
+inline static void tinymt64_digest_step(tinymt64_t * random,
+                                        uint64_t value) {
+#if defined(TINYMT_DIGEST)
+    tinymt_digest_update(&random->digest, value);
+#else
+    (void)random;
+    (void)value;
+#endif
+}
+
+inline static void tinymt64_digest_double(tinymt64_t * random,
+                                          double value) {
+#if defined(TINYMT_DIGEST)
+    tinymt_digest_update_double(&random->digest, value);
+#else
+    (void)random;
+    (void)value;
+#endif
+}
+
 /**
  * This function outputs 64-bit unsigned integer from internal state.
  * @param random tinymt internal status
@@ -163,7 +289,10 @@ inline static double tinymt64_temper_conv_open(tinymt64_t * random) {
  */
 inline static uint64_t tinymt64_generate_uint64(tinymt64_t * random) {
     tinymt64_next_state(random);
-    return tinymt64_temper(random);
+    tinymt64_guard_step(random);
+    uint64_t r = tinymt64_temper(random);
+    tinymt64_digest_step(random, r);
+    return r;
 }
 
 /**
@@ -174,7 +303,10 @@ inline static uint64_t tinymt64_generate_uint64(tinymt64_t * random) {
  */
 inline static double tinymt64_generate_double(tinymt64_t * random) {
     tinymt64_next_state(random);
-    return (double)(tinymt64_temper(random) >> 11) * TINYMT64_MUL;
+    tinymt64_guard_step(random);
+    double r = (double)(tinymt64_temper(random) >> 11) * TINYMT64_MUL;
+    tinymt64_digest_double(random, r);
+    return r;
 }
 
 /**
@@ -185,7 +317,10 @@ inline static double tinymt64_generate_double(tinymt64_t * random) {
  */
 inline static double tinymt64_generate_double01(tinymt64_t * random) {
     tinymt64_next_state(random);
-    return tinymt64_temper_conv(random) - 1.0;
+    tinymt64_guard_step(random);
+    double r = tinymt64_temper_conv(random) - 1.0;
+    tinymt64_digest_double(random, r);
+    return r;
 }
 
 /**
@@ -196,7 +331,10 @@ inline static double tinymt64_generate_double01(tinymt64_t * random) {
  */
 inline static double tinymt64_generate_double12(tinymt64_t * random) {
     tinymt64_next_state(random);
-    return tinymt64_temper_conv(random);
+    tinymt64_guard_step(random);
+    double r = tinymt64_temper_conv(random);
+    tinymt64_digest_double(random, r);
+    return r;
 }
 
 /**
@@ -207,7 +345,10 @@ inline static double tinymt64_generate_double12(tinymt64_t * random) {
  */
 inline static double tinymt64_generate_doubleOC(tinymt64_t * random) {
     tinymt64_next_state(random);
-    return 2.0 - tinymt64_temper_conv(random);
+    tinymt64_guard_step(random);
+    double r = 2.0 - tinymt64_temper_conv(random);
+    tinymt64_digest_double(random, r);
+    return r;
 }
 
 /**
@@ -218,7 +359,10 @@ inline static double tinymt64_generate_doubleOC(tinymt64_t * random) {
  */
 inline static double tinymt64_generate_doubleOO(tinymt64_t * random) {
     tinymt64_next_state(random);
-    return tinymt64_temper_conv_open(random) - 1.0;
+    tinymt64_guard_step(random);
+    double r = tinymt64_temper_conv_open(random) - 1.0;
+    tinymt64_digest_double(random, r);
+    return r;
 }
 
 #if defined(__cplusplus)
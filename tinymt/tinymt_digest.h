@@ -0,0 +1,213 @@
+#ifndef TINYMT_DIGEST_H
+#define TINYMT_DIGEST_H
+/**
+ * @file tinymt_digest.h
+ *
+ * @brief running digest of consumed stream for tinymt32 and tinymt64
+ *
+ * When TINYMT_DIGEST is defined, tinymt32_t and tinymt64_t update a
+ * 128-bit digest at every output, so that two runs can be compared
+ * without storing outputs. The digest is calculated from the value
+ * returned by each generate_* call, integers as they are and floating
+ * point numbers as their bit patterns, so the same digest means the same
+ * values were consumed in the same order. The values depend on the whole
+ * state and on mat1, mat2 and tmat. Steps skipped by jump are not
+ * digested.
+ *
+ * The digest has two lanes of multiply and rotate hashing, which use
+ * the constants of xxHash, and the count of outputs. It is not a
+ * cryptographic hash.
+ *
+ * Digests of substreams used in parallel are combined by
+ * tinymt_digest_combine() or tinymt_digest_merge() in the order of
+ * substream index, so that the result does not depend on scheduling of
+ * threads.
+ *
+ * All files of a program must be compiled with the same definition of
+ * TINYMT_DIGEST, because it changes the size of the structures.
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and The University of Tokyo.
+ * All rights reserved.
+ *
+ * The 3-clause BSD License is applied to this software, see
+ * LICENSE.txt
+ */
+
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#define TINYMT_DIGEST_P1 UINT64_C(0x9e3779b185ebca87)
+#define TINYMT_DIGEST_P2 UINT64_C(0xc2b2ae3d27d4eb4f)
+#define TINYMT_DIGEST_P3 UINT64_C(0x165667b19e3779f9)
+#define TINYMT_DIGEST_P4 UINT64_C(0x85ebca77c2b2ae63)
+#define TINYMT_DIGEST_P5 UINT64_C(0x27d4eb2f165667c5)
+
+/**
+ * running digest.
+ */
+struct TINYMT_DIGEST_T {
+    uint64_t lane[2];
+    uint64_t count;
+};
+
+typedef struct TINYMT_DIGEST_T tinymt_digest;
+
+/**
+ * This function clears digest.
+ * @param digest digest
+ */
+inline static void tinymt_digest_clear(tinymt_digest * digest) {
+    digest->lane[0] = TINYMT_DIGEST_P1 + TINYMT_DIGEST_P2;
+    digest->lane[1] = TINYMT_DIGEST_P3 + TINYMT_DIGEST_P4;
+    digest->count = 0;
+}
+
+/**
+ * This function mixes a word into lanes of digest.
+ * Users should not call this function directly.
+ * @param digest digest
+ * @param word 64-bit word
+ */
+inline static void tinymt_digest_absorb(tinymt_digest * digest,
+                                        uint64_t word) {
+    uint64_t x = digest->lane[0] + word * TINYMT_DIGEST_P2;
+    uint64_t y = digest->lane[1] + word * TINYMT_DIGEST_P4;
+    digest->lane[0] = ((x << 31) | (x >> 33)) * TINYMT_DIGEST_P1;
+    digest->lane[1] = ((y << 27) | (y >> 37)) * TINYMT_DIGEST_P3;
+}
+
+/**
+ * This function adds one output to digest.
+ * @param digest digest
+ * @param word integer output
+ */
+inline static void tinymt_digest_update(tinymt_digest * digest,
+                                        uint64_t word) {
+    tinymt_digest_absorb(digest, word);
+    digest->count++;
+}
+
+/**
+ * This function adds one float output to digest as its bit pattern.
+ * @param digest digest
+ * @param value float output
+ */
+inline static void tinymt_digest_update_float(tinymt_digest * digest,
+                                              float value) {
+    union {
+        uint32_t u;
+        float f;
+    } conv;
+
+    conv.f = value;
+    tinymt_digest_update(digest, conv.u);
+}
+
+/**
+ * This function adds one double output to digest as its bit pattern.
+ * @param digest digest
+ * @param value double output
+ */
+inline static void tinymt_digest_update_double(tinymt_digest * digest,
+                                               double value) {
+    union {
+        uint64_t u;
+        double d;
+    } conv;
+
+    conv.d = value;
+    tinymt_digest_update(digest, conv.u);
+}
+
+/**
+ * This function calculates the final 128-bit value of digest.
+ * @param digest digest
+ * @param value output, 128-bit value
+ */
+inline static void tinymt_digest_final(const tinymt_digest * digest,
+                                       uint64_t value[2]) {
+    for (int i = 0; i < 2; i++) {
+        uint64_t x = digest->lane[i] ^ (digest->count * TINYMT_DIGEST_P5);
+        x ^= x >> 33;
+        x *= TINYMT_DIGEST_P2;
+        x ^= x >> 29;
+        x *= TINYMT_DIGEST_P3;
+        x ^= x >> 32;
+        value[i] = x;
+    }
+}
+
+/**
+ * This function appends digest of the next substream to digest.
+ * The result depends on the order of calls.
+ * @param dest digest of preceding substreams
+ * @param src digest of the next substream
+ */
+inline static void tinymt_digest_combine(tinymt_digest * dest,
+                                         const tinymt_digest * src) {
+    uint64_t value[2];
+    tinymt_digest_final(src, value);
+    tinymt_digest_absorb(dest, value[0]);
+    tinymt_digest_absorb(dest, value[1]);
+    dest->count += src->count;
+}
+
+/**
+ * This function combines digests of substreams in the order of index.
+ * @param dest output, combined digest
+ * @param src digests of substreams, src[i] is of substream i
+ * @param num number of substreams
+ */
+inline static void tinymt_digest_merge(tinymt_digest * dest,
+                                       const tinymt_digest src[],
+                                       int num) {
+    tinymt_digest_clear(dest);
+    for (int i = 0; i < num; i++) {
+        tinymt_digest_combine(dest, &src[i]);
+    }
+}
+
+/**
+ * This function compares final values and counts of two digests.
+ * @param a digest
+ * @param b digest
+ * @return 1 if equal, else 0
+ */
+inline static int tinymt_digest_equal(const tinymt_digest * a,
+                                      const tinymt_digest * b) {
+    uint64_t x[2];
+    uint64_t y[2];
+    tinymt_digest_final(a, x);
+    tinymt_digest_final(b, y);
+    return x[0] == y[0] && x[1] == y[1] && a->count == b->count;
+}
+
+/**
+ * This function writes the final value of digest in 32 hexadecimal
+ * digits, for logs of audit.
+ * @param digest digest
+ * @param str output, at least 33 characters
+ */
+inline static void tinymt_digest_to_hex(const tinymt_digest * digest,
+                                        char * str) {
+    static const char hex[] = "0123456789abcdef";
+    uint64_t value[2];
+    tinymt_digest_final(digest, value);
+    for (int i = 0; i < 32; i++) {
+        str[i] = hex[(value[i / 16] >> (60 - 4 * (i % 16))) & 0xf];
+    }
+    str[32] = '\0';
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef TINYMT_GUARD_H
+#define TINYMT_GUARD_H
+/**
+ * @file tinymt_guard.h
+ *
+ * @brief statistics of consumption guard for tinymt32 and tinymt64
+ *
+ * When TINYMT_GUARD is defined, tinymt32_t and tinymt64_t count the
+ * number of generated outputs, and the count can be compared with the
+ * limit, for example the stride of jumped substreams.
+ * All files of a program must be compiled with the same definition of
+ * TINYMT_GUARD, because it changes the size of the structures.
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and The University of Tokyo.
+ * All rights reserved.
+ *
+ * The 3-clause BSD License is applied to this software, see
+ * LICENSE.txt
+ */
+
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * statistics of guard.
+ * Each thread should have its own statistics, and flush them to the
+ * shared one occasionally by tinymt_guard_flush.
+ */
+struct TINYMT_GUARD_STATS_T {
+    uint64_t streams;
+    uint64_t steps;
+    uint64_t overflows;
+    uint64_t max_steps;
+};
+
+typedef struct TINYMT_GUARD_STATS_T tinymt_guard_stats;
+
+/**
+ * This function clears statistics.
+ * @param stats statistics
+ */
+inline static void tinymt_guard_clear(tinymt_guard_stats * stats) {
+    stats->streams = 0;
+    stats->steps = 0;
+    stats->overflows = 0;
+    stats->max_steps = 0;
+}
+
+/**
+ * This function adds the count of one stream to statistics.
+ * @param stats statistics
+ * @param count number of outputs of the stream
+ * @param limit limit of outputs of the stream
+ */
+inline static void tinymt_guard_add(tinymt_guard_stats * stats,
+                                    uint64_t count, uint64_t limit) {
+    stats->streams++;
+    stats->steps += count;
+    if (count > limit) {
+        stats->overflows++;
+    }
+    if (count > stats->max_steps) {
+        stats->max_steps = count;
+    }
+}
+
+/**
+ * This function adds local statistics to shared statistics and clears
+ * local statistics. Shared statistics are updated atomically, if
+ * the compiler supports it.
+ * @param shared statistics shared by threads
+ * @param local statistics owned by the calling thread
+ */
+inline static void tinymt_guard_flush(tinymt_guard_stats * shared,
+                                      tinymt_guard_stats * local) {
+#if defined(__GNUC__)
+    uint64_t max = __atomic_load_n(&shared->max_steps, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&shared->streams, local->streams, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&shared->steps, local->steps, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&shared->overflows, local->overflows,
+                       __ATOMIC_RELAXED);
+    while (local->max_steps > max) {
+        if (__atomic_compare_exchange_n(&shared->max_steps, &max,
+                                        local->max_steps, 0,
+                                        __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+#else
+    shared->streams += local->streams;
+    shared->steps += local->steps;
+    shared->overflows += local->overflows;
+    if (local->max_steps > shared->max_steps) {
+        shared->max_steps = local->max_steps;
+    }
+#endif
+    tinymt_guard_clear(local);
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
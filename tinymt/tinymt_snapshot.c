@@ -0,0 +1,587 @@
+/**
+ * @file tinymt_snapshot.c
+ *
+ * @brief snapshot of tinymt32 and tinymt64 in the byte order
+ * independent format.
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and The University of Tokyo.
+ * All rights reserved.
+ *
+ * The 3-clause BSD License is applied to this software, see
+ * LICENSE.txt
+ */
+#include "tinymt_snapshot.h"
+#include <string.h>
+
+/** number of records read or written by one fread or fwrite */
+#define CHUNK 256
+
+/* records must have the layout of the format */
+typedef char tinymt32_record_size_check[
+    (sizeof(tinymt32_record) == TINYMT_SNAPSHOT_RECORD_SIZE) ? 1 : -1];
+typedef char tinymt64_record_size_check[
+    (sizeof(tinymt64_record) == TINYMT_SNAPSHOT_RECORD_SIZE) ? 1 : -1];
+
+static const char snapshot_magic[8] = {
+    'T', 'M', 'T', 'S', 'N', 'A', 'P', '\0'
+};
+
+static void put32(unsigned char * p, uint32_t x) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = (unsigned char)(x >> (8 * i));
+    }
+}
+
+static void put64(unsigned char * p, uint64_t x) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = (unsigned char)(x >> (8 * i));
+    }
+}
+
+static uint32_t get32(const unsigned char * p) {
+    uint32_t x = 0;
+    for (int i = 0; i < 4; i++) {
+        x |= (uint32_t)p[i] << (8 * i);
+    }
+    return x;
+}
+
+static uint64_t get64(const unsigned char * p) {
+    uint64_t x = 0;
+    for (int i = 0; i < 8; i++) {
+        x |= (uint64_t)p[i] << (8 * i);
+    }
+    return x;
+}
+
+static int is_little_endian(void) {
+    const uint32_t one = 1;
+    unsigned char c;
+    memcpy(&c, &one, 1);
+    return c == 1;
+}
+
+static void put_header(unsigned char * p, uint32_t bits, uint32_t flags,
+                       uint64_t count) {
+    memset(p, 0, TINYMT_SNAPSHOT_HEADER_SIZE);
+    memcpy(p, snapshot_magic, 8);
+    put32(p + 8, TINYMT_SNAPSHOT_VERSION);
+    put32(p + 12, bits);
+    put32(p + 16, TINYMT_SNAPSHOT_RECORD_SIZE);
+    put32(p + 20, flags);
+    put64(p + 24, count);
+}
+
+/**
+ * This function checks and decodes header, but not size of snapshot.
+ * @param p header
+ * @param header output
+ * @return 0 if valid, else -1
+ */
+static int get_header(const unsigned char * p,
+                      tinymt_snapshot_header * header) {
+    if (memcmp(p, snapshot_magic, 8) != 0) {
+        return -1;
+    }
+    header->version = get32(p + 8);
+    header->bits = get32(p + 12);
+    header->record_size = get32(p + 16);
+    header->flags = get32(p + 20);
+    header->count = get64(p + 24);
+    if (header->version != TINYMT_SNAPSHOT_VERSION
+        || (header->bits != 32 && header->bits != 64)
+        || header->record_size != TINYMT_SNAPSHOT_RECORD_SIZE) {
+        return -1;
+    }
+    return 0;
+}
+
+static void encode_record32(unsigned char * p, const tinymt32_record * r) {
+    for (int i = 0; i < 4; i++) {
+        put32(p + 4 * i, r->status[i]);
+    }
+    put32(p + 16, r->mat1);
+    put32(p + 20, r->mat2);
+    put32(p + 24, r->tmat);
+    put32(p + 28, 0);
+    put64(p + 32, r->position);
+}
+
+static void decode_record32(tinymt32_record * r, const unsigned char * p) {
+    for (int i = 0; i < 4; i++) {
+        r->status[i] = get32(p + 4 * i);
+    }
+    r->mat1 = get32(p + 16);
+    r->mat2 = get32(p + 20);
+    r->tmat = get32(p + 24);
+    r->reserved = 0;
+    r->position = get64(p + 32);
+}
+
+static void encode_record64(unsigned char * p, const tinymt64_record * r) {
+    put64(p, r->status[0]);
+    put64(p + 8, r->status[1]);
+    put32(p + 16, r->mat1);
+    put32(p + 20, r->mat2);
+    put64(p + 24, r->tmat);
+    put64(p + 32, r->position);
+}
+
+static void decode_record64(tinymt64_record * r, const unsigned char * p) {
+    r->status[0] = get64(p);
+    r->status[1] = get64(p + 8);
+    r->mat1 = get32(p + 16);
+    r->mat2 = get32(p + 20);
+    r->tmat = get64(p + 24);
+    r->position = get64(p + 32);
+}
+
+/**
+ * This function returns the size of snapshot of count states.
+ * @param count number of states
+ * @return size in bytes, or 0 if too large
+ */
+size_t tinymt_snapshot_size(uint64_t count) {
+    if (count > (SIZE_MAX - TINYMT_SNAPSHOT_HEADER_SIZE)
+        / TINYMT_SNAPSHOT_RECORD_SIZE) {
+        return 0;
+    }
+    return TINYMT_SNAPSHOT_HEADER_SIZE
+        + (size_t)count * TINYMT_SNAPSHOT_RECORD_SIZE;
+}
+
+/**
+ * This function checks snapshot and returns its header.
+ * @param buffer snapshot
+ * @param size size of buffer
+ * @param header output
+ * @return 0 if valid, else -1
+ */
+int tinymt_snapshot_info(const void * buffer, size_t size,
+                         tinymt_snapshot_header * header) {
+    size_t need;
+    if (size < TINYMT_SNAPSHOT_HEADER_SIZE
+        || get_header((const unsigned char *)buffer, header) != 0) {
+        return -1;
+    }
+    need = tinymt_snapshot_size(header->count);
+    if (need == 0 || size < need) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * This function copies state, parameters and position to record.
+ * @param record output
+ * @param random tinymt internal status
+ * @param position position
+ */
+void tinymt32_to_record(tinymt32_record * record,
+                        const tinymt32_t * random, uint64_t position) {
+    for (int i = 0; i < 4; i++) {
+        record->status[i] = random->status[i];
+    }
+    record->mat1 = random->mat1;
+    record->mat2 = random->mat2;
+    record->tmat = random->tmat;
+    record->reserved = 0;
+    record->position = position;
+}
+
+/**
+ * This function restores state and parameters from record, as
+ * tinymt32_init() does.
+ * @param random output, tinymt internal status
+ * @param record record
+ */
+void tinymt32_from_record(tinymt32_t * random,
+                          const tinymt32_record * record) {
+    for (int i = 0; i < 4; i++) {
+        random->status[i] = record->status[i];
+    }
+    random->mat1 = record->mat1;
+    random->mat2 = record->mat2;
+    random->tmat = record->tmat;
+#if defined(TINYMT_GUARD)
+    tinymt32_guard_set_limit(random, UINT64_MAX);
+#endif
+#if defined(TINYMT_DIGEST)
+    tinymt32_digest_reset(random);
+#endif
+}
+
+/**
+ * This function writes snapshot of states to memory.
+ * @param buffer output, tinymt_snapshot_size(count) bytes
+ * @param size size of buffer
+ * @param random array of tinymt internal status
+ * @param position array of positions, or NULL
+ * @param count number of states
+ * @return 0 if success, -1 if buffer is too small
+ */
+int tinymt32_snapshot_encode(void * buffer, size_t size,
+                             const tinymt32_t random[],
+                             const uint64_t position[], uint64_t count) {
+    unsigned char * p = (unsigned char *)buffer;
+    size_t need = tinymt_snapshot_size(count);
+    tinymt32_record record;
+    if (need == 0 || size < need) {
+        return -1;
+    }
+    put_header(p, 32, position != NULL ? TINYMT_SNAPSHOT_POSITION : 0,
+               count);
+    p += TINYMT_SNAPSHOT_HEADER_SIZE;
+    for (uint64_t i = 0; i < count; i++) {
+        tinymt32_to_record(&record, &random[i],
+                           position != NULL ? position[i] : 0);
+        encode_record32(p, &record);
+        p += TINYMT_SNAPSHOT_RECORD_SIZE;
+    }
+    return 0;
+}
+
+/**
+ * This function reads states first to first + count - 1 from snapshot
+ * in memory.
+ * @param buffer snapshot
+ * @param size size of buffer
+ * @param random output, array of count tinymt internal status
+ * @param position output, array of count positions, or NULL
+ * @param first index of the first state to read
+ * @param count number of states to read
+ * @return 0 if success, -1 if snapshot is invalid, not of tinymt32, or
+ * has less states
+ */
+int tinymt32_snapshot_decode(const void * buffer, size_t size,
+                             tinymt32_t random[], uint64_t position[],
+                             uint64_t first, uint64_t count) {
+    const unsigned char * p = (const unsigned char *)buffer;
+    tinymt_snapshot_header header;
+    tinymt32_record record;
+    if (tinymt_snapshot_info(buffer, size, &header) != 0
+        || header.bits != 32
+        || first > header.count || count > header.count - first) {
+        return -1;
+    }
+    p += TINYMT_SNAPSHOT_HEADER_SIZE
+        + (size_t)first * TINYMT_SNAPSHOT_RECORD_SIZE;
+    for (uint64_t i = 0; i < count; i++) {
+        decode_record32(&record, p);
+        tinymt32_from_record(&random[i], &record);
+        if (position != NULL) {
+            position[i] = record.position;
+        }
+        p += TINYMT_SNAPSHOT_RECORD_SIZE;
+    }
+    return 0;
+}
+
+/**
+ * This function returns records in snapshot without copy, for example,
+ * of a file mapped to memory. Records are used by
+ * tinymt32_from_record().
+ * @param buffer snapshot, aligned to 8 bytes
+ * @param size size of buffer
+ * @param count output, number of records
+ * @return array of records, or NULL if snapshot is invalid, not of
+ * tinymt32, not aligned, or the machine is not little endian.
+ * Then use tinymt32_snapshot_decode().
+ */
+const tinymt32_record * tinymt32_snapshot_map(const void * buffer,
+                                              size_t size,
+                                              uint64_t * count) {
+    tinymt_snapshot_header header;
+    if (!is_little_endian()
+        || (uintptr_t)buffer % 8 != 0
+        || tinymt_snapshot_info(buffer, size, &header) != 0
+        || header.bits != 32) {
+        return NULL;
+    }
+    *count = header.count;
+    return (const tinymt32_record *)
+        ((const unsigned char *)buffer + TINYMT_SNAPSHOT_HEADER_SIZE);
+}
+
+/**
+ * This function writes snapshot of states to file.
+ * @param fp output file opened in binary mode
+ * @param random array of tinymt internal status
+ * @param position array of positions, or NULL
+ * @param count number of states
+ * @return 0 if success, -1 if error
+ */
+int tinymt32_snapshot_save(FILE * fp, const tinymt32_t random[],
+                           const uint64_t position[], uint64_t count) {
+    unsigned char buffer[CHUNK * TINYMT_SNAPSHOT_RECORD_SIZE];
+    tinymt32_record record;
+    put_header(buffer, 32, position != NULL ? TINYMT_SNAPSHOT_POSITION : 0,
+               count);
+    if (fwrite(buffer, 1, TINYMT_SNAPSHOT_HEADER_SIZE, fp)
+        != TINYMT_SNAPSHOT_HEADER_SIZE) {
+        return -1;
+    }
+    for (uint64_t i = 0; i < count; i += CHUNK) {
+        size_t n = count - i < CHUNK ? (size_t)(count - i) : CHUNK;
+        for (size_t j = 0; j < n; j++) {
+            tinymt32_to_record(&record, &random[i + j],
+                               position != NULL ? position[i + j] : 0);
+            encode_record32(buffer + j * TINYMT_SNAPSHOT_RECORD_SIZE,
+                            &record);
+        }
+        if (fwrite(buffer, TINYMT_SNAPSHOT_RECORD_SIZE, n, fp) != n) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * This function reads snapshot of states from file.
+ * @param fp input file opened in binary mode
+ * @param random output, array of max_count tinymt internal status
+ * @param position output, array of max_count positions, or NULL
+ * @param max_count size of arrays
+ * @param count output, number of states read
+ * @return 0 if success, -1 if error, invalid, not of tinymt32, or more
+ * than max_count states
+ */
+int tinymt32_snapshot_load(FILE * fp, tinymt32_t random[],
+                           uint64_t position[], uint64_t max_count,
+                           uint64_t * count) {
+    unsigned char buffer[CHUNK * TINYMT_SNAPSHOT_RECORD_SIZE];
+    tinymt_snapshot_header header;
+    tinymt32_record record;
+    if (fread(buffer, 1, TINYMT_SNAPSHOT_HEADER_SIZE, fp)
+        != TINYMT_SNAPSHOT_HEADER_SIZE
+        || get_header(buffer, &header) != 0
+        || header.bits != 32
+        || header.count > max_count) {
+        return -1;
+    }
+    for (uint64_t i = 0; i < header.count; i += CHUNK) {
+        size_t n = header.count - i < CHUNK
+            ? (size_t)(header.count - i) : CHUNK;
+        if (fread(buffer, TINYMT_SNAPSHOT_RECORD_SIZE, n, fp) != n) {
+            return -1;
+        }
+        for (size_t j = 0; j < n; j++) {
+            decode_record32(&record,
+                            buffer + j * TINYMT_SNAPSHOT_RECORD_SIZE);
+            tinymt32_from_record(&random[i + j], &record);
+            if (position != NULL) {
+                position[i + j] = record.position;
+            }
+        }
+    }
+    *count = header.count;
+    return 0;
+}
+
+/**
+ * This function copies state, parameters and position to record.
+ * @param record output
+ * @param random tinymt internal status
+ * @param position position
+ */
+void tinymt64_to_record(tinymt64_record * record,
+                        const tinymt64_t * random, uint64_t position) {
+    record->status[0] = random->status[0];
+    record->status[1] = random->status[1];
+    record->mat1 = random->mat1;
+    record->mat2 = random->mat2;
+    record->tmat = random->tmat;
+    record->position = position;
+}
+
+/**
+ * This function restores state and parameters from record, as
+ * tinymt64_init() does.
+ * @param random output, tinymt internal status
+ * @param record record
+ */
+void tinymt64_from_record(tinymt64_t * random,
+                          const tinymt64_record * record) {
+    random->status[0] = record->status[0];
+    random->status[1] = record->status[1];
+    random->mat1 = record->mat1;
+    random->mat2 = record->mat2;
+    random->tmat = record->tmat;
+#if defined(TINYMT_GUARD)
+    tinymt64_guard_set_limit(random, UINT64_MAX);
+#endif
+#if defined(TINYMT_DIGEST)
+    tinymt64_digest_reset(random);
+#endif
+}
+
+/**
+ * This function writes snapshot of states to memory.
+ * @param buffer output, tinymt_snapshot_size(count) bytes
+ * @param size size of buffer
+ * @param random array of tinymt internal status
+ * @param position array of positions, or NULL
+ * @param count number of states
+ * @return 0 if success, -1 if buffer is too small
+ */
+int tinymt64_snapshot_encode(void * buffer, size_t size,
+                             const tinymt64_t random[],
+                             const uint64_t position[], uint64_t count) {
+    unsigned char * p = (unsigned char *)buffer;
+    size_t need = tinymt_snapshot_size(count);
+    tinymt64_record record;
+    if (need == 0 || size < need) {
+        return -1;
+    }
+    put_header(p, 64, position != NULL ? TINYMT_SNAPSHOT_POSITION : 0,
+               count);
+    p += TINYMT_SNAPSHOT_HEADER_SIZE;
+    for (uint64_t i = 0; i < count; i++) {
+        tinymt64_to_record(&record, &random[i],
+                           position != NULL ? position[i] : 0);
+        encode_record64(p, &record);
+        p += TINYMT_SNAPSHOT_RECORD_SIZE;
+    }
+    return 0;
+}
+
+/**
+ * This function reads states first to first + count - 1 from snapshot
+ * in memory.
+ * @param buffer snapshot
+ * @param size size of buffer
+ * @param random output, array of count tinymt internal status
+ * @param position output, array of count positions, or NULL
+ * @param first index of the first state to read
+ * @param count number of states to read
+ * @return 0 if success, -1 if snapshot is invalid, not of tinymt64, or
+ * has less states
+ */
+int tinymt64_snapshot_decode(const void * buffer, size_t size,
+                             tinymt64_t random[], uint64_t position[],
+                             uint64_t first, uint64_t count) {
+    const unsigned char * p = (const unsigned char *)buffer;
+    tinymt_snapshot_header header;
+    tinymt64_record record;
+    if (tinymt_snapshot_info(buffer, size, &header) != 0
+        || header.bits != 64
+        || first > header.count || count > header.count - first) {
+        return -1;
+    }
+    p += TINYMT_SNAPSHOT_HEADER_SIZE
+        + (size_t)first * TINYMT_SNAPSHOT_RECORD_SIZE;
+    for (uint64_t i = 0; i < count; i++) {
+        decode_record64(&record, p);
+        tinymt64_from_record(&random[i], &record);
+        if (position != NULL) {
+            position[i] = record.position;
+        }
+        p += TINYMT_SNAPSHOT_RECORD_SIZE;
+    }
+    return 0;
+}
+
+/**
+ * This function returns records in snapshot without copy, for example,
+ * of a file mapped to memory. Records are used by
+ * tinymt64_from_record().
+ * @param buffer snapshot, aligned to 8 bytes
+ * @param size size of buffer
+ * @param count output, number of records
+ * @return array of records, or NULL if snapshot is invalid, not of
+ * tinymt64, not aligned, or the machine is not little endian.
+ * Then use tinymt64_snapshot_decode().
+ */
+const tinymt64_record * tinymt64_snapshot_map(const void * buffer,
+                                              size_t size,
+                                              uint64_t * count) {
+    tinymt_snapshot_header header;
+    if (!is_little_endian()
+        || (uintptr_t)buffer % 8 != 0
+        || tinymt_snapshot_info(buffer, size, &header) != 0
+        || header.bits != 64) {
+        return NULL;
+    }
+    *count = header.count;
+    return (const tinymt64_record *)
+        ((const unsigned char *)buffer + TINYMT_SNAPSHOT_HEADER_SIZE);
+}
+
+/**
+ * This function writes snapshot of states to file.
+ * @param fp output file opened in binary mode
+ * @param random array of tinymt internal status
+ * @param position array of positions, or NULL
+ * @param count number of states
+ * @return 0 if success, -1 if error
+ */
+int tinymt64_snapshot_save(FILE * fp, const tinymt64_t random[],
+                           const uint64_t position[], uint64_t count) {
+    unsigned char buffer[CHUNK * TINYMT_SNAPSHOT_RECORD_SIZE];
+    tinymt64_record record;
+    put_header(buffer, 64, position != NULL ? TINYMT_SNAPSHOT_POSITION : 0,
+               count);
+    if (fwrite(buffer, 1, TINYMT_SNAPSHOT_HEADER_SIZE, fp)
+        != TINYMT_SNAPSHOT_HEADER_SIZE) {
+        return -1;
+    }
+    for (uint64_t i = 0; i < count; i += CHUNK) {
+        size_t n = count - i < CHUNK ? (size_t)(count - i) : CHUNK;
+        for (size_t j = 0; j < n; j++) {
+            tinymt64_to_record(&record, &random[i + j],
+                               position != NULL ? position[i + j] : 0);
+            encode_record64(buffer + j * TINYMT_SNAPSHOT_RECORD_SIZE,
+                            &record);
+        }
+        if (fwrite(buffer, TINYMT_SNAPSHOT_RECORD_SIZE, n, fp) != n) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * This function reads snapshot of states from file.
+ * @param fp input file opened in binary mode
+ * @param random output, array of max_count tinymt internal status
+ * @param position output, array of max_count positions, or NULL
+ * @param max_count size of arrays
+ * @param count output, number of states read
+ * @return 0 if success, -1 if error, invalid, not of tinymt64, or more
+ * than max_count states
+ */
+int tinymt64_snapshot_load(FILE * fp, tinymt64_t random[],
+                           uint64_t position[], uint64_t max_count,
+                           uint64_t * count) {
+    unsigned char buffer[CHUNK * TINYMT_SNAPSHOT_RECORD_SIZE];
+    tinymt_snapshot_header header;
+    tinymt64_record record;
+    if (fread(buffer, 1, TINYMT_SNAPSHOT_HEADER_SIZE, fp)
+        != TINYMT_SNAPSHOT_HEADER_SIZE
+        || get_header(buffer, &header) != 0
+        || header.bits != 64
+        || header.count > max_count) {
+        return -1;
+    }
+    for (uint64_t i = 0; i < header.count; i += CHUNK) {
+        size_t n = header.count - i < CHUNK
+            ? (size_t)(header.count - i) : CHUNK;
+        if (fread(buffer, TINYMT_SNAPSHOT_RECORD_SIZE, n, fp) != n) {
+            return -1;
+        }
+        for (size_t j = 0; j < n; j++) {
+            decode_record64(&record,
+                            buffer + j * TINYMT_SNAPSHOT_RECORD_SIZE);
+            tinymt64_from_record(&random[i + j], &record);
+            if (position != NULL) {
+                position[i + j] = record.position;
+            }
+        }
+    }
+    *count = header.count;
+    return 0;
+}
@@ -0,0 +1,139 @@
+#ifndef TINYMT_SNAPSHOT_H
+#define TINYMT_SNAPSHOT_H
+/**
+ * @file tinymt_snapshot.h
+ *
+ * @brief snapshot of tinymt32 and tinymt64, internal states with
+ * parameters and optional positions, in the byte order independent
+ * format.
+ *
+ * Format, all integers are in little endian:
+ * - header, TINYMT_SNAPSHOT_HEADER_SIZE bytes: 8 bytes of magic
+ *   "TMTSNAP\0", 32-bit version, 32-bit bits (32 or 64), 32-bit record
+ *   size, 32-bit flags, 64-bit count and 32 bytes of zero.
+ * - count records, TINYMT_SNAPSHOT_RECORD_SIZE bytes each, which have
+ *   the same layout as tinymt32_record or tinymt64_record.
+ *
+ * A snapshot of one state is a snapshot of array of one element.
+ * Position is the number of outputs, or any counter of users, and is
+ * zero if not given. Flag TINYMT_SNAPSHOT_POSITION tells that positions
+ * were given.
+ *
+ * Records are aligned to 8 bytes from the top of the snapshot, so
+ * that a snapshot file mapped to memory by mmap can be used as an
+ * array of records without copy on little endian machines, see
+ * tinymt32_snapshot_map().
+ *
+ * @author Mutsuo Saito (Hiroshima University)
+ * @author Makoto Matsumoto (The University of Tokyo)
+ *
+ * Copyright (C) 2026 Mutsuo Saito, Makoto Matsumoto,
+ * Hiroshima University and The University of Tokyo.
+ * All rights reserved.
+ *
+ * The 3-clause BSD License is applied to this software, see
+ * LICENSE.txt
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "tinymt32.h"
+#include "tinymt64.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#define TINYMT_SNAPSHOT_VERSION 1
+#define TINYMT_SNAPSHOT_HEADER_SIZE 64
+#define TINYMT_SNAPSHOT_RECORD_SIZE 40
+#define TINYMT_SNAPSHOT_POSITION 1
+
+/**
+ * header of snapshot
+ */
+struct TINYMT_SNAPSHOT_HEADER_T {
+    uint32_t version;
+    uint32_t bits;
+    uint32_t record_size;
+    uint32_t flags;
+    uint64_t count;
+};
+
+typedef struct TINYMT_SNAPSHOT_HEADER_T tinymt_snapshot_header;
+
+/**
+ * record of tinymt32 in snapshot
+ */
+struct TINYMT32_RECORD_T {
+    uint32_t status[4];
+    uint32_t mat1;
+    uint32_t mat2;
+    uint32_t tmat;
+    uint32_t reserved;
+    uint64_t position;
+};
+
+typedef struct TINYMT32_RECORD_T tinymt32_record;
+
+/**
+ * record of tinymt64 in snapshot
+ */
+struct TINYMT64_RECORD_T {
+    uint64_t status[2];
+    uint32_t mat1;
+    uint32_t mat2;
+    uint64_t tmat;
+    uint64_t position;
+};
+
+typedef struct TINYMT64_RECORD_T tinymt64_record;
+
+size_t tinymt_snapshot_size(uint64_t count);
+int tinymt_snapshot_info(const void * buffer, size_t size,
+                         tinymt_snapshot_header * header);
+
+int tinymt32_snapshot_encode(void * buffer, size_t size,
+                             const tinymt32_t random[],
+                             const uint64_t position[], uint64_t count);
+int tinymt32_snapshot_decode(const void * buffer, size_t size,
+                             tinymt32_t random[], uint64_t position[],
+                             uint64_t first, uint64_t count);
+const tinymt32_record * tinymt32_snapshot_map(const void * buffer,
+                                              size_t size,
+                                              uint64_t * count);
+void tinymt32_to_record(tinymt32_record * record,
+                        const tinymt32_t * random, uint64_t position);
+void tinymt32_from_record(tinymt32_t * random,
+                          const tinymt32_record * record);
+int tinymt32_snapshot_save(FILE * fp, const tinymt32_t random[],
+                           const uint64_t position[], uint64_t count);
+int tinymt32_snapshot_load(FILE * fp, tinymt32_t random[],
+                           uint64_t position[], uint64_t max_count,
+                           uint64_t * count);
+
+int tinymt64_snapshot_encode(void * buffer, size_t size,
+                             const tinymt64_t random[],
+                             const uint64_t position[], uint64_t count);
+int tinymt64_snapshot_decode(const void * buffer, size_t size,
+                             tinymt64_t random[], uint64_t position[],
+                             uint64_t first, uint64_t count);
+const tinymt64_record * tinymt64_snapshot_map(const void * buffer,
+                                              size_t size,
+                                              uint64_t * count);
+void tinymt64_to_record(tinymt64_record * record,
+                        const tinymt64_t * random, uint64_t position);
+void tinymt64_from_record(tinymt64_t * random,
+                          const tinymt64_record * record);
+int tinymt64_snapshot_save(FILE * fp, const tinymt64_t random[],
+                           const uint64_t position[], uint64_t count);
+int tinymt64_snapshot_load(FILE * fp, tinymt64_t random[],
+                           uint64_t position[], uint64_t max_count,
+                           uint64_t * count);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif